@@ -22,8 +22,8 @@ Adc::Adc(ADC_HandleTypeDef *peripheral)
         :
         AdcStrategy(),
         peripheral_(peripheral),
-        sync_(new murasaki::Synchronizer),
-        critical_section_(new murasaki::CriticalSection),
+        sync_(new murasaki::PeripheralSynchronizer),
+        critical_section_(new murasaki::PeripheralCriticalSection),
         status_(murasaki::kasOK),
         channel_array_len_(32),     // Most of the STM32 ADC has smaller channel than 32.
         channels_(new unsigned int[channel_array_len_]),
@@ -54,62 +54,95 @@ murasaki::AdcStatus murasaki::Adc::Convert(
                                            float *value,
                                            const unsigned int size)
                                            {
-    unsigned int ret_val;
+    ADC_SYSLOG("Enter %d, %p, %d", channel, value, size)
+
+    MURASAKI_ASSERT(nullptr != value)
+    MURASAKI_ASSERT(size == 1)
+
+    ConvertStart(channel);
+    murasaki::AdcStatus status = ConvertWait(value);
+
+    ADC_SYSLOG("Exit with %d", status)
+    return status;
+
+}
+
+void murasaki::Adc::ConvertStart(unsigned int channel)
+                                 {
     HAL_StatusTypeDef api_status;
 
-    ADC_SYSLOG("Enter %d, %p, %d", channel, value, size)
+    ADC_SYSLOG("Enter %d", channel)
 
-// Wrap by critical section to gurantee the exclussive access between different channels.
+    // Wrap by critical section to gurantee the exclussive access between different channels.
+    // Leave at the ConvertWait().
     critical_section_->Enter();
-    {
-        MURASAKI_ASSERT(nullptr != value)
-        MURASAKI_ASSERT(size == 1)
 
-        // Before conversion, configure the channel
-        ADC_ChannelConfTypeDef ch_config = { 0 };
-        ch_config.Channel = channel;
-        ch_config.Rank = 1;     // this is not important in the single conversion.
-        ch_config.SamplingTime = GetSampleClocks(channel);  // this value is stored in this object. See GetSampleClocks()
+    // Before conversion, configure the channel
+    ADC_ChannelConfTypeDef ch_config = { 0 };
+    ch_config.Channel = channel;
+    ch_config.Rank = 1;     // this is not important in the single conversion.
+    ch_config.SamplingTime = GetSampleClocks(channel);  // this value is stored in this object. See GetSampleClocks()
 
-        api_status = HAL_ADC_ConfigChannel(peripheral_, &ch_config);
-        MURASAKI_ASSERT(api_status == HAL_OK)
+    api_status = HAL_ADC_ConfigChannel(peripheral_, &ch_config);
+    MURASAKI_ASSERT(api_status == HAL_OK)
 
-        // Start conversion.
-        api_status = HAL_ADC_Start_IT(peripheral_);
-        MURASAKI_ASSERT(api_status == HAL_OK)
+    // The value will be overwritten by the error interrupt.
+    status_ = murasaki::kasOK;
 
-        // Wait for interrupt.
-        status_ = murasaki::kasOK;
+    // Start conversion.
+    api_status = HAL_ADC_Start_IT(peripheral_);
+    MURASAKI_ASSERT(api_status == HAL_OK)
 
-        ADC_SYSLOG("Sync waiting")
-        sync_->Wait();
-        ADC_SYSLOG("Sync released")
+    ADC_SYSLOG("Exit")
+}
 
-        switch (status_)
-        {
-            case kasOK:
-                ret_val = HAL_ADC_GetValue(peripheral_);
-                // normalize to [-1.0, 1.0)
-                *value = (-1.0f * ret_val) / INT16_MIN;
-                break;
-            case kasOverrun:
-                case kasDMA:
-                case kasUnknown:
-                case kasInternal:
-                // There is nothing we can do.
-                *value = 0;
-                break;
-            default:
-                // This is coding error. All api_status have to be recognized.
-                MURASAKI_SYSLOG(this, kfaAdc, kseError, "Unknown Status")
-                break;
-        }
+murasaki::AdcStatus murasaki::Adc::ConvertWait(float *value)
+                                               {
+    unsigned int ret_val;
+
+    ADC_SYSLOG("Enter %p", value)
+
+    MURASAKI_ASSERT(nullptr != value)
+
+    // Wait for interrupt.
+    ADC_SYSLOG("Sync waiting")
+    sync_->Wait();
+    ADC_SYSLOG("Sync released")
+
+    switch (status_)
+    {
+        case kasOK:
+            ret_val = HAL_ADC_GetValue(peripheral_);
+            // normalize to [-1.0, 1.0)
+            *value = (-1.0f * ret_val) / INT16_MIN;
+            break;
+        case kasOverrun:
+            case kasDMA:
+            case kasUnknown:
+            case kasInternal:
+            // There is nothing we can do.
+            *value = 0;
+            break;
+        default:
+            // This is coding error. All api_status have to be recognized.
+            MURASAKI_SYSLOG(this, kfaAdc, kseError, "Unknown Status")
+            break;
     }
+
+    // Entered at the ConvertStart().
     critical_section_->Leave();
 
     ADC_SYSLOG("Exit with %d", status_)
     return status_;
+}
+
+void murasaki::Adc::AttachWaitSet(murasaki::WaitSet *wait_set, uint32_t bits)
+                                  {
+    ADC_SYSLOG("Enter %p, %08X", wait_set, bits)
+
+    sync_->AttachWaitSet(wait_set, bits);
 
+    ADC_SYSLOG("Exit")
 }
 
 bool murasaki::Adc::ConversionCompleteCallback(void *ptr)
@@ -8,8 +8,9 @@
 #ifndef ADC_HPP_
 #define ADC_HPP_
 
-#include "synchronizer.hpp"
+#include "notificationsynchronizer.hpp"
 #include "criticalsection.hpp"
+#include "waitset.hpp"
 #include "adcstrategy.hpp"
 
 namespace murasaki {
@@ -100,6 +101,29 @@ class Adc : public AdcStrategy {
      *
      */
     virtual murasaki::AdcStatus Convert(const unsigned int channel, float *value, unsigned int size = 1);
+    /**
+     * @brief Start the conversion of the given channel.
+     * @param channel Specify the ADC channel.Use ADC_CHANNEL_* value.
+     * @details
+     * Start the conversion and return immediately. The calling task must call ConvertWait() to get the data.
+     * The other channels are kept waited until the ConvertWait().
+     */
+    virtual void ConvertStart(unsigned int channel);
+    /**
+     * @brief Wait for the end of the conversion started by ConvertStart().
+     * @param value Pointer to the variable to receive the data. Data is normalized by range [-1,1)
+     * @return Status. murasaki::kasOk is return if success.
+     */
+    virtual murasaki::AdcStatus ConvertWait(float *value);
+    /**
+     * @brief Signal a murasaki::WaitSet at the end of the conversion.
+     * @param wait_set The WaitSet to signal. nullptr to detach.
+     * @param bits Bits to signal.
+     * @details
+     * Start the conversion by ConvertStart() and wait for the WaitSet. Then, the data can be taken by
+     * ConvertWait() without blocking.
+     */
+    virtual void AttachWaitSet(murasaki::WaitSet *wait_set, uint32_t bits);
 
     /**
      * \brief Callback function for the interrupt handler.
@@ -146,8 +170,8 @@ class Adc : public AdcStrategy {
     ADC_HandleTypeDef *const peripheral_;
 
  private:
-    Synchronizer *const sync_;
-    CriticalSection *const critical_section_;
+    PeripheralSynchronizer *const sync_;
+    PeripheralCriticalSection *const critical_section_;
     murasaki::AdcStatus status_;
     const unsigned int channel_array_len_;
     unsigned int *const channels_;
@@ -12,30 +12,178 @@
  *
  * FreeRTOS hepa is considered safer than system heap. Then, the new and the delete
  * operators are overloaded to use the pvPortMalloc().
+ *
+ * If the @ref MURASAKI_CONFIG_STATIC_ALLOCATION is true, the new operators allocate from a static arena
+ * instead. The arena is never freed. So, the delete operators assert that nothing is freed in this case,
+ * to catch the leak at every create / delete cycle.
+ *
+ * If the @ref MURASAKI_CONFIG_POOL_ALLOCATOR is true, the small requests are allocated from the size-class
+ * pool first. See murasaki_pool.hpp.
+ *
+ * If the @ref MURASAKI_CONFIG_HEAP_TRACE is true, each allocation has a header to record the owner and the caller.
+ * See murasaki_heaptrace.hpp.
+ *
+ * The aligned versions allocate extra bytes to align the memory, and keep the original address just before
+ * the aligned memory. They are defined only when the compiler supports the aligned new of C++17.
  */
 
 #include <cstddef>
+#include <cstdint>
+#include <new>
 #include <FreeRTOS.h>
+#include <task.h>
+#include "murasaki_config.hpp"
+#include "murasaki_assert.hpp"
+#include "murasaki_utility.hpp"
+#include "murasaki_pool.hpp"
+#include "murasaki_heaptrace.hpp"
+
+#if MURASAKI_CONFIG_STATIC_ALLOCATION
+
+// The arena. Aligned as same as the FreeRTOS heap.
+static uint8_t static_arena[PLATFORM_CONFIG_STATIC_ARENA_SIZE] __attribute__((aligned(portBYTE_ALIGNMENT)));
+// Next free byte in the arena.
+static std::size_t static_arena_used = 0;
+
+// Bump allocation. Return nullptr if the arena is exhausted, as same as pvPortMalloc().
+static void* AllocateStatic(std::size_t size)
+                            {
+	void *ptr = nullptr;
+
+	// Round up to keep the alignment of the next allocation.
+	size = (size + (portBYTE_ALIGNMENT - 1)) & ~static_cast<std::size_t>(portBYTE_ALIGNMENT - 1);
+
+	UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+	if (size <= sizeof(static_arena) - static_arena_used) {
+		ptr = &static_arena[static_arena_used];
+		static_arena_used += size;
+	}
+	taskEXIT_CRITICAL_FROM_ISR(saved);
+
+	return ptr;
+}
+
+unsigned int murasaki::GetStaticArenaUsage()
+{
+	return static_arena_used;
+}
+
+// The arena is never freed. Freeing is a programming error, because the memory leaks.
+static void DeallocateStatic(void *ptr)
+                             {
+	MURASAKI_ASSERT(nullptr == ptr)
+}
+
+#define ALLOCATE(size) AllocateStatic(size)
+#define DEALLOCATE(ptr) DeallocateStatic(ptr)
+
+#else
+
+unsigned int murasaki::GetStaticArenaUsage()
+{
+	return 0;
+}
+
+#define ALLOCATE(size) pvPortMalloc(size)
+#define DEALLOCATE(ptr) vPortFree(ptr)
+
+#endif
+
+#if MURASAKI_CONFIG_POOL_ALLOCATOR
+// Try the pool first. Fall back if too large or exhausted.
+static void* Allocate(std::size_t size)
+                      {
+	void *ptr = murasaki::PoolAllocate(size);
+	return (nullptr != ptr) ? ptr : ALLOCATE(size);
+}
+
+static void Deallocate(void *ptr)
+                       {
+	if (!murasaki::PoolFree(ptr))
+		DEALLOCATE(ptr);
+}
+#else
+static inline void* Allocate(std::size_t size)
+                             {
+	return ALLOCATE(size);
+}
+
+static inline void Deallocate(void *ptr)
+                              {
+	DEALLOCATE(ptr);
+}
+#endif
+
+#if MURASAKI_CONFIG_HEAP_TRACE
+// Allocate with the header to record the caller and the owner.
+static void* TracedAllocate(std::size_t size, void *caller)
+                            {
+	return murasaki::HeapTraceAttach(Allocate(size + murasaki::HeapTraceHeaderSize()), size, caller);
+}
+
+static void TracedDeallocate(void *ptr)
+                             {
+	if (nullptr != ptr)
+		Deallocate(murasaki::HeapTraceDetach(ptr));
+}
+#else
+static inline void* TracedAllocate(std::size_t size, void *caller)
+                                   {
+	return Allocate(size);
+}
+
+static inline void TracedDeallocate(void *ptr)
+                                    {
+	Deallocate(ptr);
+}
+#endif
+
+#if __cpp_aligned_new
+// Allocate with extra bytes, and keep the original address before the aligned memory.
+static void* AllocateAligned(std::size_t size, std::size_t alignment, void *caller)
+                             {
+	// Already aligned by the allocators.
+	if (alignment <= portBYTE_ALIGNMENT)
+		return TracedAllocate(size, caller);
+
+	void *const original = TracedAllocate(size + alignment + sizeof(void*), caller);
+	if (nullptr == original)
+		return nullptr;
+
+	uintptr_t aligned = (reinterpret_cast<uintptr_t>(original) + sizeof(void*) + alignment - 1)
+			& ~static_cast<uintptr_t>(alignment - 1);
+	reinterpret_cast<void**>(aligned)[-1] = original;
+	return reinterpret_cast<void*>(aligned);
+}
+
+static void DeallocateAligned(void *ptr, std::size_t alignment)
+                              {
+	if (alignment <= portBYTE_ALIGNMENT)
+		TracedDeallocate(ptr);
+	else if (nullptr != ptr)
+		TracedDeallocate(reinterpret_cast<void**>(ptr)[-1]);
+}
+#endif
 
 /**
  * @ingroup MURASAKI_HELPER_GROUP
  * @brief Allocate a memory piece with given size.
  * @param size Size of the memory to allocate [byte]
- * @return Allocated memory in FreeRTOS heap. Null mean fail to allocate.
+ * @return Allocated memory in FreeRTOS heap or static arena. Null mean fail to allocate.
  */
 void* operator new(std::size_t size)
 {
-	return pvPortMalloc(size);
+	return TracedAllocate(size, __builtin_return_address(0));
 }
 
 /**
  * @ingroup MURASAKI_HELPER_GROUP
  * @brief Allocate a memory piece with given size.
  * @param size Size of the memory to allocate [byte]
- * @return Allocated memory in FreeRTOS heap. Null mean fail to allocate.
+ * @return Allocated memory in FreeRTOS heap or static arena. Null mean fail to allocate.
  */
 void* operator new[](std::size_t size) {
-	return pvPortMalloc(size);
+	return TracedAllocate(size, __builtin_return_address(0));
 }
 
 /**
@@ -45,7 +193,7 @@ void* operator new[](std::size_t size) {
  * @return Allocated memory in FreeRTOS heap. Null mean fail to allocate.
  */
 void operator delete(void* ptr) {
-	vPortFree(ptr);
+	TracedDeallocate(ptr);
 }
 
 /**
@@ -55,7 +203,91 @@ void operator delete(void* ptr) {
  * @return Allocated memory in FreeRTOS heap. Null mean fail to allocate.
  */
 void operator delete[](void* ptr) {
-	vPortFree(ptr);
+	TracedDeallocate(ptr);
 }
 
+/**
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @brief Deallocate the given memory
+ * @param ptr Pointer to the memory to deallocate
+ * @param size Size given at the allocation [byte]. Not used.
+ */
+void operator delete(void* ptr, std::size_t size) {
+	TracedDeallocate(ptr);
+}
+
+/**
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @brief Deallocate the given memory
+ * @param ptr Pointer to the memory to deallocate
+ * @param size Size given at the allocation [byte]. Not used.
+ */
+void operator delete[](void* ptr, std::size_t size) {
+	TracedDeallocate(ptr);
+}
+
+#if __cpp_aligned_new
+/**
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @brief Allocate a memory piece with given size and alignment.
+ * @param size Size of the memory to allocate [byte]
+ * @param alignment Alignment of the memory [byte]
+ * @return Allocated memory. Null mean fail to allocate.
+ */
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return AllocateAligned(size, static_cast<std::size_t>(alignment), __builtin_return_address(0));
+}
+
+/**
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @brief Allocate a memory piece with given size and alignment.
+ * @param size Size of the memory to allocate [byte]
+ * @param alignment Alignment of the memory [byte]
+ * @return Allocated memory. Null mean fail to allocate.
+ */
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return AllocateAligned(size, static_cast<std::size_t>(alignment), __builtin_return_address(0));
+}
 
+/**
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @brief Deallocate the given memory allocated with alignment
+ * @param ptr Pointer to the memory to deallocate
+ * @param alignment Alignment given at the allocation [byte]
+ */
+void operator delete(void* ptr, std::align_val_t alignment) {
+	DeallocateAligned(ptr, static_cast<std::size_t>(alignment));
+}
+
+/**
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @brief Deallocate the given memory allocated with alignment
+ * @param ptr Pointer to the memory to deallocate
+ * @param alignment Alignment given at the allocation [byte]
+ */
+void operator delete[](void* ptr, std::align_val_t alignment) {
+	DeallocateAligned(ptr, static_cast<std::size_t>(alignment));
+}
+
+/**
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @brief Deallocate the given memory allocated with alignment
+ * @param ptr Pointer to the memory to deallocate
+ * @param size Size given at the allocation [byte]. Not used.
+ * @param alignment Alignment given at the allocation [byte]
+ */
+void operator delete(void* ptr, std::size_t size, std::align_val_t alignment) {
+	DeallocateAligned(ptr, static_cast<std::size_t>(alignment));
+}
+
+/**
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @brief Deallocate the given memory allocated with alignment
+ * @param ptr Pointer to the memory to deallocate
+ * @param size Size given at the allocation [byte]. Not used.
+ * @param alignment Alignment given at the allocation [byte]
+ */
+void operator delete[](void* ptr, std::size_t size, std::align_val_t alignment) {
+	DeallocateAligned(ptr, static_cast<std::size_t>(alignment));
+}
+#endif
@@ -0,0 +1,173 @@
+/*
+ * audioanalyzer.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <math.h>
+
+#include "audioanalyzer.hpp"
+
+// This file must not depend on the HAL and RTOS. So, murasaki_assert.hpp is not included.
+
+namespace murasaki {
+
+// The minimum power ratio to avoid -inf dB. -300dB.
+static const float kMinimumPowerRatio = 1.0e-30f;
+
+AudioAnalyzer::AudioAnalyzer(
+                             unsigned int sample_rate,
+                             unsigned int length,
+                             unsigned int num_harmonics)
+        :
+        sample_rate_(sample_rate),
+        length_(length),
+        num_harmonics_(num_harmonics)
+{
+}
+
+float AudioAnalyzer::GetCoherentFrequency(float frequency) const
+                                          {
+    return FrequencyToBin(frequency) * static_cast<float>(sample_rate_) / length_;
+}
+
+float AudioAnalyzer::GetAmplitude(
+                                  const float *data,
+                                  float frequency) const
+                                  {
+    // The power of the sine wave A is A*A/2.
+    return sqrtf(2.0f * BinPower(data, FrequencyToBin(frequency)));
+}
+
+void AudioAnalyzer::Analyze(
+                            const float *data,
+                            float frequency,
+                            AudioAnalysisResult *result) const
+                            {
+    const unsigned int fundamental_bin = FrequencyToBin(frequency);
+    const float dc = Mean(data);
+    float cos_part, sin_part;
+
+    // Fit the fundamental.
+    DftBin(data, fundamental_bin, &cos_part, &sin_part);
+    const float fundamental_power = (cos_part * cos_part + sin_part * sin_part) / 2.0f;
+
+    // Power of the residual. That is, the harmonics and noise.
+    // Subtract the fitted fundamental and DC sample by sample, to avoid the cancellation error.
+    float residual_power = 0.0f;
+    // Phase index is kept in integer to keep the precision. Advanced modulo length_, to avoid the overflow.
+    const unsigned int fundamental_step = fundamental_bin % length_;
+    unsigned int index = 0;
+    for (unsigned int i = 0; i < length_; i++) {
+        const float phase = 2.0f * static_cast<float>(M_PI) * index / length_;
+        const float residual = data[i] - dc - cos_part * cosf(phase) - sin_part * sinf(phase);
+        residual_power += residual * residual;
+        index += fundamental_step;
+        if (index >= length_)
+            index -= length_;
+    }
+    residual_power /= length_;
+
+    // Sum the power of the harmonics under the Nyquist frequency.
+    float harmonics_power = 0.0f;
+    for (unsigned int order = 2; order <= num_harmonics_; order++) {
+        unsigned int bin = fundamental_bin * order;
+        if (bin * 2 >= length_)
+            break;
+        harmonics_power += BinPower(data, bin);
+    }
+
+    // The residual includes harmonics. So, the noise is the rest.
+    float noise_power = residual_power - harmonics_power;
+    if (noise_power < 0.0f)
+        noise_power = 0.0f;
+
+    result->frequency = GetCoherentFrequency(frequency);
+    // Full scale sine wave has power 0.5.
+    result->fundamental_dbfs = PowerToDb(fundamental_power / 0.5f);
+    result->thd_db = PowerToDb(harmonics_power / fundamental_power);
+    result->thd_n_db = PowerToDb(residual_power / fundamental_power);
+    result->snr_db = PowerToDb(fundamental_power / (noise_power + kMinimumPowerRatio));
+    result->noise_dbfs = PowerToDb(noise_power / 0.5f);
+}
+
+float AudioAnalyzer::GetRmsDbfs(const float *data) const
+                                {
+    const float dc = Mean(data);
+    float power = 0.0f;
+
+    for (unsigned int i = 0; i < length_; i++)
+        power += (data[i] - dc) * (data[i] - dc);
+
+    // Full scale sine wave has power 0.5.
+    return PowerToDb(power / length_ / 0.5f);
+}
+
+float AudioAnalyzer::PowerToDb(float ratio)
+                               {
+    if (!(ratio > kMinimumPowerRatio))  // true for NaN, too.
+        ratio = kMinimumPowerRatio;
+    return 10.0f * log10f(ratio);
+}
+
+void AudioAnalyzer::DftBin(
+                           const float *data,
+                           unsigned int bin,
+                           float *cos_part,
+                           float *sin_part) const
+                           {
+    float re = 0.0f;
+    float im = 0.0f;
+
+    // Phase index is kept in integer to keep the precision. Advanced modulo length_, to avoid the overflow.
+    const unsigned int step = bin % length_;
+    unsigned int index = 0;
+    for (unsigned int i = 0; i < length_; i++) {
+        const float phase = 2.0f * static_cast<float>(M_PI) * index / length_;
+        re += data[i] * cosf(phase);
+        im += data[i] * sinf(phase);
+        index += step;
+        if (index >= length_)
+            index -= length_;
+    }
+
+    // Normalize to the amplitude.
+    *cos_part = 2.0f * re / length_;
+    *sin_part = 2.0f * im / length_;
+}
+
+float AudioAnalyzer::BinPower(
+                              const float *data,
+                              unsigned int bin) const
+                              {
+    float cos_part, sin_part;
+
+    DftBin(data, bin, &cos_part, &sin_part);
+    return (cos_part * cos_part + sin_part * sin_part) / 2.0f;
+}
+
+float AudioAnalyzer::Mean(const float *data) const
+                          {
+    float sum = 0.0f;
+
+    for (unsigned int i = 0; i < length_; i++)
+        sum += data[i];
+
+    return sum / length_;
+}
+
+unsigned int AudioAnalyzer::FrequencyToBin(float frequency) const
+                                           {
+    int bin = static_cast<int>(frequency * length_ / sample_rate_ + 0.5f);
+
+    // At least one cycle. And the bin must be lower than Nyquist.
+    if (bin < 1)
+        bin = 1;
+    if (static_cast<unsigned int>(bin) * 2 >= length_)
+        bin = (length_ - 1) / 2;
+
+    return bin;
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,155 @@
+/**
+ * @file audioanalyzer.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Sine wave analyzer for the audio measurement.
+ * @details
+ * This file doesn't depend on the HAL and RTOS. So, it can be compiled and
+ * run on the host machine to check the DSP regression.
+ */
+
+#ifndef AUDIOANALYZER_HPP_
+#define AUDIOANALYZER_HPP_
+
+namespace murasaki {
+
+/**
+ * @brief Result of the single tone analysis.
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @details
+ * All level values are in dB. The dBFS values are relative to the sine wave of
+ * which peak is 1.0 ( full scale of the @ref DuplexAudio float data ).
+ */
+struct AudioAnalysisResult
+{
+    float frequency;          ///< Analyzed frequency [Hz]. Rounded to the coherent frequency.
+    float fundamental_dbfs;   ///< Level of the fundamental. [dBFS]
+    float thd_db;             ///< Total harmonic distortion relative to the fundamental. [dB]
+    float thd_n_db;           ///< Total harmonic distortion + noise relative to the fundamental. [dB]
+    float snr_db;             ///< Ratio between the fundamental and the noise. Harmonics are excluded. [dB]
+    float noise_dbfs;         ///< Noise level excluding fundamental and harmonics. [dBFS]
+};
+
+/**
+ * @brief Single tone analyzer based on the single bin DFT.
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @details
+ * Analyze the captured single tone data and obtain the THD, THD+N and SNR.
+ *
+ * To avoid the window function, the analyzer assumes the coherent sampling.
+ * That is, the test signal have to be a integer number of the cycles in the analyzed length.
+ * Use @ref GetCoherentFrequency() to round the desired test frequency to the coherent frequency.
+ * Then, the fundamental and harmonics are exactly on the bins of DFT. These bins are
+ * calculated one by one like Goertzel algorithm, instead of the full FFT.
+ * The twiddle factor is calculated from the exact phase index to keep the precision of the float.
+ *
+ * The THD+N is obtained from the residual after subtracting the fitted fundamental from
+ * the data. Thus, the result is not limited by the cancellation error of the float.
+ *
+ * The analyzer doesn't use the HAL and RTOS. Thus, it can be run on the host.
+ */
+class AudioAnalyzer
+{
+ public:
+    AudioAnalyzer() = delete;
+    /**
+     * @brief Constructor.
+     * @param sample_rate Sampling frequency of the analyzed data [Hz].
+     * @param length Number of the samples to analyze.
+     * @param num_harmonics The highest order of the harmonics to be considered as distortion.
+     * The harmonics above the Nyquist frequency are ignored.
+     */
+    AudioAnalyzer(
+                  unsigned int sample_rate,
+                  unsigned int length,
+                  unsigned int num_harmonics = 5);
+
+    /**
+     * @brief Round the given frequency to the nearest coherent frequency.
+     * @param frequency Desired frequency [Hz]
+     * @return The frequency which has integer number of cycles in the analyzed length [Hz].
+     * At least, one cycle is guaranteed.
+     */
+    float GetCoherentFrequency(float frequency) const;
+
+    /**
+     * @brief Obtain the amplitude of the given frequency.
+     * @param data Analyzed data. The length is given by the constructor.
+     * @param frequency Frequency to analyze. Must be a coherent frequency.
+     * @return The peak amplitude of the sine component at the frequency.
+     */
+    float GetAmplitude(
+                       const float *data,
+                       float frequency) const;
+
+    /**
+     * @brief Analyze the single tone.
+     * @param data Analyzed data. The length is given by the constructor.
+     * @param frequency Frequency of the fundamental. Must be a coherent frequency.
+     * @param result Pointer to the result struct.
+     * @details
+     * DC component is removed before analysis.
+     */
+    void Analyze(
+                 const float *data,
+                 float frequency,
+                 AudioAnalysisResult *result) const;
+
+    /**
+     * @brief Obtain the RMS level of the data.
+     * @param data Analyzed data. The length is given by the constructor.
+     * @return RMS level relative to the full scale sine wave [dBFS]. DC component is removed.
+     */
+    float GetRmsDbfs(const float *data) const;
+
+    /**
+     * @brief Convert the power ratio to dB.
+     * @param ratio Power ratio.
+     * @return 10log10(ratio). The ratio is clipped to avoid the -infinity.
+     */
+    static float PowerToDb(float ratio);
+
+ private:
+    /**
+     * @brief Calculate one DFT bin.
+     * @param data Analyzed data.
+     * @param bin Index of the DFT bin.
+     * @param cos_part Returns the amplitude of the cosine component.
+     * @param sin_part Returns the amplitude of the sine component.
+     */
+    void DftBin(
+                const float *data,
+                unsigned int bin,
+                float *cos_part,
+                float *sin_part) const;
+    /**
+     * @brief Calculate the power of one DFT bin.
+     * @param data Analyzed data.
+     * @param bin Index of the DFT bin.
+     * @return Power of the sine component at the bin. Peak amplitude A gives A*A/2.
+     */
+    float BinPower(
+                   const float *data,
+                   unsigned int bin) const;
+    /**
+     * @brief Obtain the mean value of the data.
+     * @param data Analyzed data.
+     * @return DC component.
+     */
+    float Mean(const float *data) const;
+    /**
+     * @brief Convert the frequency to the DFT bin index.
+     * @param frequency Frequency [Hz]
+     * @return Nearest bin index.
+     */
+    unsigned int FrequencyToBin(float frequency) const;
+
+    const unsigned int sample_rate_;
+    const unsigned int length_;
+    const unsigned int num_harmonics_;
+};
+
+} /* namespace murasaki */
+
+#endif /* AUDIOANALYZER_HPP_ */
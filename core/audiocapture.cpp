@@ -0,0 +1,346 @@
+/*
+ * audiocapture.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "audiocapture.hpp"
+#include "murasaki_assert.hpp"
+#include "murasaki_syslog.hpp"
+#include "debugger.hpp"
+
+// Macro for easy-to-read
+#define CAPTURE_SYSLOG(fmt, ...)    MURASAKI_SYSLOG(this, kfaAudio, kseDebug, fmt, ##__VA_ARGS__)
+
+// Magic number of the stream header. "MCAP" in little endian.
+#define CAPTURE_MAGIC 0x5041434D
+
+// "MLCH" and "MLCB" in little endian. Never be an address of the deferred log format.
+#define CAPTURE_ID_HEADER 0x48434C4Du
+#define CAPTURE_ID_BLOCK 0x42434C4Du
+
+// Thresholds of the left aligned 32bit sample.
+// Clip : -0.002dBFS
+#define CAPTURE_CLIP_LEVEL 0x7FFF0000
+// Silence : -90dBFS
+#define CAPTURE_SILENCE_LEVEL 0x00010000
+
+namespace murasaki {
+
+AudioCapture::AudioCapture(
+                           unsigned int num_of_blocks,
+                           unsigned int post_trigger_blocks)
+        :
+        num_of_blocks_(num_of_blocks),
+        post_trigger_blocks_(post_trigger_blocks),
+        tx_format_ { 0, 0, 0, 0 },
+        rx_format_ { 0, 0, 0, 0 },
+        tx_ring_(nullptr),
+        rx_ring_(nullptr),
+        head_(0),
+        filled_(0),
+        remaining_(0),
+        silence_blocks_(10),
+        silence_count_(0),
+        conditions_(kactManual),
+        state_(kArmed),
+        trigger_reason_(kactNone),
+        manual_request_(false),
+        sync_(new murasaki::Synchronizer())
+{
+    CAPTURE_SYSLOG("Enter. num_of_blocks : %d, post_trigger_blocks : %d", num_of_blocks, post_trigger_blocks)
+
+    MURASAKI_ASSERT(0 < num_of_blocks_)
+    MURASAKI_ASSERT(post_trigger_blocks_ < num_of_blocks_)
+    MURASAKI_ASSERT(nullptr != sync_)
+
+    CAPTURE_SYSLOG("Return")
+}
+
+AudioCapture::~AudioCapture()
+{
+    delete[] tx_ring_;
+    delete[] rx_ring_;
+    delete sync_;
+}
+
+void AudioCapture::Attach(
+                          const murasaki::AudioTapFormat &tx,
+                          const murasaki::AudioTapFormat &rx)
+                          {
+    CAPTURE_SYSLOG("Enter. tx block size : %d, rx block size : %d", tx.block_size, rx.block_size)
+
+    // Attach only once.
+    MURASAKI_ASSERT(nullptr == tx_ring_)
+    MURASAKI_ASSERT(nullptr == rx_ring_)
+
+    tx_format_ = tx;
+    rx_format_ = rx;
+
+    tx_ring_ = new uint8_t[num_of_blocks_ * tx_format_.block_size];
+    rx_ring_ = new uint8_t[num_of_blocks_ * rx_format_.block_size];
+    MURASAKI_ASSERT(nullptr != tx_ring_)
+    MURASAKI_ASSERT(nullptr != rx_ring_)
+
+    CAPTURE_SYSLOG("Return")
+}
+
+void AudioCapture::Tap(
+                       const uint8_t *tx_block,
+                       const uint8_t *rx_block,
+                       bool xrun)
+                       {
+    // Do not touch the ring while frozen. The background task may read it.
+    if (kFrozen == state_)
+        return;
+
+    // Copy the blocks into the ring.
+    ::memcpy(&tx_ring_[head_ * tx_format_.block_size], tx_block, tx_format_.block_size);
+    ::memcpy(&rx_ring_[head_ * rx_format_.block_size], rx_block, rx_format_.block_size);
+    head_ = (head_ + 1) % num_of_blocks_;
+    if (filled_ < num_of_blocks_)
+        filled_++;
+
+    if (kArmed == state_) {
+        unsigned int reason = kactNone;
+
+        // Check the level only when needed.
+        if (conditions_ & (kactClip | kactSilence)) {
+            bool clipped, silent;
+
+            CheckLevel(rx_block, &clipped, &silent);
+            silence_count_ = silent ? silence_count_ + 1 : 0;
+
+            if ((conditions_ & kactClip) && clipped)
+                reason = kactClip;
+            else if ((conditions_ & kactSilence) && silence_count_ >= silence_blocks_)
+                reason = kactSilence;
+        }
+        if ((conditions_ & kactXrun) && xrun)
+            reason = kactXrun;
+        if ((conditions_ & kactManual) && manual_request_)
+            reason = kactManual;
+
+        if (kactNone != reason) {
+            trigger_reason_ = reason;
+            remaining_ = post_trigger_blocks_;
+            state_ = kTriggered;
+        }
+    }
+    else if (remaining_ > 0)  // kTriggered
+        remaining_--;
+
+    // Freeze when all post trigger blocks are captured.
+    if (kTriggered == state_ && 0 == remaining_) {
+        state_ = kFrozen;
+        sync_->Release();
+    }
+}
+
+void AudioCapture::SetTrigger(unsigned int conditions)
+                              {
+    conditions_ = conditions;
+}
+
+void AudioCapture::SetSilenceBlocks(unsigned int blocks)
+                                    {
+    MURASAKI_ASSERT(0 < blocks)
+    silence_blocks_ = blocks;
+}
+
+void AudioCapture::Trigger()
+{
+    manual_request_ = true;
+}
+
+bool AudioCapture::WaitForFreeze(unsigned int timeout_ms)
+                                 {
+    if (kFrozen == state_)
+        return true;
+
+    sync_->Wait(timeout_ms);
+    return kFrozen == state_;
+}
+
+unsigned int AudioCapture::GetTriggerReason()
+{
+    return trigger_reason_;
+}
+
+unsigned int AudioCapture::GetNumberOfBlocks()
+{
+    return filled_;
+}
+
+void AudioCapture::GetBlock(
+                            unsigned int index,
+                            const uint8_t **tx_block,
+                            const uint8_t **rx_block)
+                            {
+    MURASAKI_ASSERT(kFrozen == state_)
+    MURASAKI_ASSERT(index < filled_)
+
+    // The oldest block is at head_ if the ring is full. Otherwise at 0.
+    unsigned int position = (head_ + num_of_blocks_ - filled_ + index) % num_of_blocks_;
+
+    *tx_block = &tx_ring_[position * tx_format_.block_size];
+    *rx_block = &rx_ring_[position * rx_format_.block_size];
+}
+
+void AudioCapture::Stream(murasaki::LoggerStrategy *logger)
+                          {
+    CAPTURE_SYSLOG("Enter. logger : %p", logger)
+
+    MURASAKI_ASSERT(nullptr != logger)
+    MURASAKI_ASSERT(kFrozen == state_)
+
+    uint32_t header[] = {
+            CAPTURE_MAGIC,
+            trigger_reason_,
+            filled_,
+            filled_ - post_trigger_blocks_ - 1,
+            tx_format_.block_size,
+            tx_format_.num_of_channels,
+            tx_format_.word_size,
+            rx_format_.block_size,
+            rx_format_.num_of_channels,
+            rx_format_.word_size };
+
+    logger->putMessage(reinterpret_cast<char*>(header), sizeof(header));
+
+    for (unsigned int i = 0; i < filled_; i++) {
+        const uint8_t *tx_block;
+        const uint8_t *rx_block;
+
+        GetBlock(i, &tx_block, &rx_block);
+        logger->putMessage(reinterpret_cast<char*>(const_cast<uint8_t*>(tx_block)), tx_format_.block_size);
+        logger->putMessage(reinterpret_cast<char*>(const_cast<uint8_t*>(rx_block)), rx_format_.block_size);
+    }
+
+    CAPTURE_SYSLOG("Return")
+}
+
+void AudioCapture::StreamToDebugger()
+{
+    CAPTURE_SYSLOG("Enter")
+
+    MURASAKI_ASSERT(nullptr != murasaki::debugger)
+    MURASAKI_ASSERT(kFrozen == state_)
+
+    uint32_t header[] = {
+            CAPTURE_ID_HEADER,
+            trigger_reason_,
+            filled_,
+            filled_ - post_trigger_blocks_ - 1,
+            tx_format_.block_size,
+            tx_format_.num_of_channels,
+            tx_format_.word_size,
+            rx_format_.block_size,
+            rx_format_.num_of_channels,
+            rx_format_.word_size };
+
+    murasaki::debugger->WaitRoom(2 + sizeof(header));
+    murasaki::debugger->PutDeferredLog(header, sizeof(header) / sizeof(header[0]));
+
+    for (unsigned int i = 0; i < filled_; i++) {
+        const uint8_t *tx_block;
+        const uint8_t *rx_block;
+
+        GetBlock(i, &tx_block, &rx_block);
+        SendBlockFrames(tx_block, tx_format_.block_size, i * 2);
+        SendBlockFrames(rx_block, rx_format_.block_size, i * 2 + 1);
+    }
+
+    CAPTURE_SYSLOG("Return")
+}
+
+void AudioCapture::SendBlockFrames(
+                                   const uint8_t *block,
+                                   unsigned int size,
+                                   uint32_t tag)
+                                   {
+    for (unsigned int offset = 0; offset < size; offset += kFrameDataWords * sizeof(uint32_t)) {
+        unsigned int chunk = std::min(size - offset, static_cast<unsigned int>(kFrameDataWords * sizeof(uint32_t)));
+        unsigned int num_of_words = 3 + (chunk + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+        frame_[0] = CAPTURE_ID_BLOCK;
+        frame_[1] = tag;
+        frame_[2] = offset;
+        // Pad the last word by 0.
+        frame_[num_of_words - 1] = 0;
+        ::memcpy(&frame_[3], &block[offset], chunk);
+
+        // Pace by the output. The other producers keep their own overflow policy.
+        murasaki::debugger->WaitRoom(2 + num_of_words * sizeof(uint32_t));
+        murasaki::debugger->PutDeferredLog(frame_, num_of_words);
+    }
+}
+
+void AudioCapture::Rearm()
+{
+    CAPTURE_SYSLOG("Enter")
+
+    // Tap() doesn't touch the variables while frozen. So, reset them before releasing the state.
+    head_ = 0;
+    filled_ = 0;
+    silence_count_ = 0;
+    trigger_reason_ = kactNone;
+    manual_request_ = false;
+    // Discard the release which was not waited.
+    sync_->Wait(0);
+    state_ = kArmed;
+
+    CAPTURE_SYSLOG("Return")
+}
+
+void AudioCapture::CheckLevel(
+                              const uint8_t *rx_block,
+                              bool *clipped,
+                              bool *silent)
+                              {
+    const unsigned int num_of_samples = rx_format_.block_size / rx_format_.word_size;
+
+    *clipped = false;
+    *silent = true;
+
+    for (unsigned int i = 0; i < num_of_samples; i++) {
+        int32_t sample;
+
+        // Make the sample left aligned 32bit. Shift as unsigned, because the left shift of
+        // the negative value is undefined before C++20.
+        switch (rx_format_.word_size) {
+            case 2:
+                sample = static_cast<int32_t>(
+                        static_cast<uint32_t>(reinterpret_cast<const int16_t*>(rx_block)[i]) << (16 + rx_format_.shift));
+                break;
+            case 3: {
+                const uint8_t *const packed = &rx_block[i * 3];
+                int32_t value = packed[0] | (packed[1] << 8) | (packed[2] << 16);
+
+                // Sign extension of the 24bit sample.
+                if (value & 0x800000)
+                    value -= 0x1000000;
+                sample = static_cast<int32_t>(static_cast<uint32_t>(value) << (8 + rx_format_.shift));
+                break;
+            }
+            case 4:
+                sample = static_cast<int32_t>(
+                        static_cast<uint32_t>(reinterpret_cast<const int32_t*>(rx_block)[i]) << rx_format_.shift);
+                break;
+            default:
+                MURASAKI_ASSERT(false)
+                return;
+        }
+
+        if (sample >= CAPTURE_CLIP_LEVEL || sample <= -CAPTURE_CLIP_LEVEL)
+            *clipped = true;
+        if (sample >= CAPTURE_SILENCE_LEVEL || sample <= -CAPTURE_SILENCE_LEVEL)
+            *silent = false;
+    }
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,256 @@
+/**
+ * @file audiocapture.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Triggered pre-roll capture of the DuplexAudio DMA blocks.
+ */
+
+#ifndef AUDIOCAPTURE_HPP_
+#define AUDIOCAPTURE_HPP_
+
+#include "audiotapstrategy.hpp"
+#include "loggerstrategy.hpp"
+#include "synchronizer.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Trigger condition of the @ref AudioCapture.
+ * \ingroup MURASAKI_DEFINITION_GROUP
+ * @details
+ * The conditions can be combined by bitwise OR.
+ */
+enum AudioCaptureTrigger
+{
+    kactNone = 0,           ///< No trigger condition.
+    kactManual = 1 << 0,    ///< Triggered by AudioCapture::Trigger().
+    kactClip = 1 << 1,      ///< Triggered by a full scale sample in RX.
+    kactSilence = 1 << 2,   ///< Triggered by the continuous silence in RX.
+    kactXrun = 1 << 3,      ///< Triggered by missing DMA phases.
+};
+
+/**
+ * @brief Pre-roll capture ring for audio diagnostics.
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @details
+ * Keep the last N blocks of the TX and RX DMA data in a RAM ring. The ring is filled by
+ * memcpy in the @ref Tap(), which is called from the DuplexAudio::TransmitAndReceive().
+ *
+ * When a trigger condition is detected, the ring continues to capture the given number of
+ * post trigger blocks. And then, the ring is frozen. The audio path is not affected by the
+ * frozen ring, because the Tap() just returns while frozen.
+ *
+ * A background task waits for the freeze by @ref WaitForFreeze(), and then, read the
+ * ring by @ref GetBlock() or send it by @ref Stream(). After that, @ref Rearm() restarts the capture.
+ *
+ * @code
+ *     // 48 samples per block at 48kHz. 100 blocks is 100mS.
+ *     capture = new murasaki::AudioCapture(100, 20);
+ *     audio->AddTap(capture);
+ *     capture->SetTrigger(murasaki::kactClip | murasaki::kactXrun);
+ *     ...
+ *     // In the background task
+ *     while (true) {
+ *         capture->WaitForFreeze();
+ *         capture->StreamToDebugger();
+ *         capture->Rearm();
+ *     }
+ * @endcode
+ */
+class AudioCapture : public AudioTapStrategy {
+ public:
+    AudioCapture() = delete;
+    /**
+     * @brief Constructor.
+     * @param num_of_blocks Number of the blocks in the ring.
+     * @param post_trigger_blocks Number of the blocks to capture after the trigger. Must be smaller than num_of_blocks.
+     * @details
+     * The ring buffer is allocated when this object is added to the DuplexAudio.
+     */
+    AudioCapture(
+                 unsigned int num_of_blocks,
+                 unsigned int post_trigger_blocks);
+    virtual ~AudioCapture();
+
+    /**
+     * @brief Allocate the ring buffer.
+     * @param tx Format of the TX DMA block.
+     * @param rx Format of the RX DMA block.
+     * @details
+     * Called from DuplexAudio::AddTap(). Do not call from application.
+     */
+    virtual void Attach(
+                        const murasaki::AudioTapFormat &tx,
+                        const murasaki::AudioTapFormat &rx);
+
+    /**
+     * @brief Copy the blocks into the ring, and check the trigger condition.
+     * @param tx_block TX DMA block.
+     * @param rx_block RX DMA block.
+     * @param xrun true if the DuplexAudio detected missing DMA phases.
+     * @details
+     * Called from DuplexAudio::TransmitAndReceive(). Do not call from application.
+     */
+    virtual void Tap(
+                     const uint8_t *tx_block,
+                     const uint8_t *rx_block,
+                     bool xrun);
+
+    /**
+     * @brief Set the trigger condition.
+     * @param conditions Bitwise OR of the @ref AudioCaptureTrigger. By default, kactManual.
+     */
+    void SetTrigger(unsigned int conditions);
+
+    /**
+     * @brief Set the length of the silence to trigger.
+     * @param blocks Number of the continuous silent RX blocks to trigger. By default, 10 blocks.
+     * @details
+     * The silent block has all samples under -90dBFS.
+     */
+    void SetSilenceBlocks(unsigned int blocks);
+
+    /**
+     * @brief Trigger the capture manually.
+     * @details
+     * Can be called from any task. The trigger is detected at the next Tap().
+     * Ignored if kactManual is not set by SetTrigger().
+     */
+    void Trigger();
+
+    /**
+     * @brief Wait until the ring is frozen.
+     * @param timeout_ms Time out [mS]
+     * @return true if frozen. false if timeout.
+     */
+    bool WaitForFreeze(unsigned int timeout_ms = murasaki::kwmsIndefinitely);
+
+    /**
+     * @brief The reason of the trigger.
+     * @return One of the @ref AudioCaptureTrigger. kactNone if not triggered.
+     */
+    unsigned int GetTriggerReason();
+
+    /**
+     * @brief Number of the captured blocks.
+     * @return Number of the valid blocks in the ring. Up to num_of_blocks.
+     */
+    unsigned int GetNumberOfBlocks();
+
+    /**
+     * @brief Obtain a captured block.
+     * @param index Index of the block. 0 is the oldest.
+     * @param tx_block Returns the pointer to the TX block.
+     * @param rx_block Returns the pointer to the RX block.
+     * @details
+     * Valid only while frozen. The trigger block is at GetNumberOfBlocks() - post_trigger_blocks - 1.
+     */
+    void GetBlock(
+                  unsigned int index,
+                  const uint8_t **tx_block,
+                  const uint8_t **rx_block);
+
+    /**
+     * @brief Send the frozen ring through a dedicated logger.
+     * @param logger The logger to send. For example, @ref UartLogger on the other UART.
+     * @details
+     * The logger must be dedicated to this stream. Don't pass the logger of the murasaki::debugger.
+     * Its task sends the text and the deferred log frames at the same time, and the binary blocks
+     * break both streams. Use StreamToDebugger() to share the debug console.
+     *
+     * Send a header and the captured blocks in binary. The header is an array of the
+     * uint32_t in the CPU endian :
+     * @li magic number 0x5041434D ( "MCAP" in little endian )
+     * @li trigger reason
+     * @li number of the blocks
+     * @li index of the trigger block
+     * @li TX block size [Byte], TX channels, TX word size [Byte]
+     * @li RX block size [Byte], RX channels, RX word size [Byte]
+     *
+     * Then, TX block and RX block follow for each block from the oldest.
+     *
+     * This member function is blocking. Call it from a background task while frozen.
+     */
+    void Stream(murasaki::LoggerStrategy *logger);
+
+    /**
+     * @brief Send the frozen ring through the murasaki::debugger, in the deferred log frames.
+     * @details
+     * The frames share the debug console with the text and the other frames. They are the same format
+     * with the @ref MURASAKI_DEFERRED_LOG frame. The first word of the payload is the ID :
+     * @li "MLCH" ( 0x48434C4D ) : header. Followed by the same words as Stream(), except the magic number.
+     * @li "MLCB" ( 0x42434C4D ) : part of a block. Followed by the block index x 2 + 0 for TX or 1 for RX,
+     * the byte offset in the block and up to 256 bytes of the block. The last word is padded by 0.
+     *
+     * Each frame waits for the room of the debugger by murasaki::Debugger::WaitRoom(). So, the frames are
+     * not dropped unless the console is stalled.
+     *
+     * This member function is blocking. Call it from a background task while frozen.
+     */
+    void StreamToDebugger();
+
+    /**
+     * @brief Restart the capture.
+     * @details
+     * Clear the ring and wait for the trigger again.
+     */
+    void Rearm();
+
+ private:
+    /**
+     * @brief Check the clip and silence in the RX block.
+     * @param rx_block RX DMA block.
+     * @param clipped Returns true if a full scale sample exists.
+     * @param silent Returns true if all samples are under -90dBFS.
+     */
+    void CheckLevel(
+                    const uint8_t *rx_block,
+                    bool *clipped,
+                    bool *silent);
+    /**
+     * @brief Send a block by the "MLCB" frames.
+     * @param block The TX or RX block.
+     * @param size Size of the block [byte].
+     * @param tag Block index x 2 + 0 for TX or 1 for RX.
+     */
+    void SendBlockFrames(
+                         const uint8_t *block,
+                         unsigned int size,
+                         uint32_t tag);
+
+    // Data words in a "MLCB" frame.
+    static constexpr unsigned int kFrameDataWords = 64;
+
+    enum State
+    {
+        kArmed,        // Capturing and waiting for the trigger.
+        kTriggered,    // Capturing the post trigger blocks.
+        kFrozen        // Capture stopped.
+    };
+
+    const unsigned int num_of_blocks_;
+    const unsigned int post_trigger_blocks_;
+    murasaki::AudioTapFormat tx_format_;
+    murasaki::AudioTapFormat rx_format_;
+    uint8_t *tx_ring_;
+    uint8_t *rx_ring_;
+    // Next block index to write.
+    unsigned int head_;
+    // Number of the valid blocks.
+    unsigned int filled_;
+    unsigned int remaining_;
+    unsigned int silence_blocks_;
+    unsigned int silence_count_;
+    unsigned int conditions_;
+    volatile State state_;
+    volatile unsigned int trigger_reason_;
+    volatile bool manual_request_;
+    murasaki::Synchronizer *const sync_;
+    // Payload of the frame to the debugger.
+    uint32_t frame_[3 + kFrameDataWords];
+};
+
+} /* namespace murasaki */
+
+#endif /* AUDIOCAPTURE_HPP_ */
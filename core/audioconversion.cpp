@@ -0,0 +1,154 @@
+/*
+ * audioconversion.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <math.h>
+
+#include "audioconversion.hpp"
+
+// Scale factor between the left aligned 32bit integer and float.
+// To keep the absolute maximum number as 1.0, using the _MIN value.
+//  | INT32_MAX | +1 = | INT32_MIN |
+#define CONVERSION_SCALE (-1.0f * INT32_MIN)
+// Reciprocal of the CONVERSION_SCALE. Exact because the scale is power of 2.
+#define CONVERSION_RECIPROCAL (1.0f / CONVERSION_SCALE)
+// The largest float which can be converted to int32_t. Float can't represent INT32_MAX.
+#define CONVERSION_MAX 2147483520.0f
+
+namespace murasaki {
+
+// Convert the float to the left aligned 32bit integer with saturation.
+static inline int32_t FloatToLeftAligned(float value)
+                                         {
+    return static_cast<int32_t>(fmaxf(fminf(value * CONVERSION_SCALE, CONVERSION_MAX), -CONVERSION_SCALE));
+}
+
+void UnpackInt32ToFloat(
+                        const int32_t *src,
+                        float **channels,
+                        unsigned int num_of_channels,
+                        unsigned int channel_len,
+                        unsigned int shift)
+                        {
+    // Read the DMA buffer sequentially.
+    for (unsigned int wo_idx = 0; wo_idx < channel_len; wo_idx++)
+        for (unsigned int ch_idx = 0; ch_idx < num_of_channels; ch_idx++)
+            channels[ch_idx][wo_idx] = (*src++ << shift) * CONVERSION_RECIPROCAL;
+}
+
+void PackFloatToInt32(
+                      float **channels,
+                      int32_t *dst,
+                      unsigned int num_of_channels,
+                      unsigned int channel_len,
+                      unsigned int shift)
+                      {
+    // Write the DMA buffer sequentially.
+    for (unsigned int wo_idx = 0; wo_idx < channel_len; wo_idx++)
+        for (unsigned int ch_idx = 0; ch_idx < num_of_channels; ch_idx++)
+            *dst++ = FloatToLeftAligned(channels[ch_idx][wo_idx]) >> shift;
+}
+
+void UnpackInt24ToFloat(
+                        const uint8_t *src,
+                        float **channels,
+                        unsigned int num_of_channels,
+                        unsigned int channel_len,
+                        unsigned int shift)
+                        {
+    const unsigned int num_of_samples = num_of_channels * channel_len;
+    // Left shift to make 24bit data left aligned 32bit.
+    const unsigned int left = 8 + shift;
+    unsigned int ch_idx = 0;
+    unsigned int wo_idx = 0;
+    unsigned int index = 0;
+
+// Store a left aligned sample and advance the channel.
+#define UNPACK_STORE(sample)\
+    channels[ch_idx][wo_idx] = static_cast<int32_t>(sample) * CONVERSION_RECIPROCAL;\
+    if (++ch_idx == num_of_channels) {\
+        ch_idx = 0;\
+        wo_idx++;\
+    }
+
+    // Fast path. 4 samples in 3 words.
+    // Cortex-M is little endian. So, the byte 0 is LSB of the word.
+    if (0 == (reinterpret_cast<uintptr_t>(src) & 3)) {
+        const uint32_t *words = reinterpret_cast<const uint32_t*>(src);
+
+        for (; index + 4 <= num_of_samples; index += 4) {
+            const uint32_t w0 = *words++;
+            const uint32_t w1 = *words++;
+            const uint32_t w2 = *words++;
+
+            UNPACK_STORE(w0 << left)                            // byte 0, 1, 2
+            UNPACK_STORE(((w0 >> 24) | (w1 << 8)) << left)      // byte 3, 4, 5
+            UNPACK_STORE(((w1 >> 16) | (w2 << 16)) << left)     // byte 6, 7, 8
+            UNPACK_STORE((w2 >> 8) << left)                     // byte 9, 10, 11
+        }
+        src = reinterpret_cast<const uint8_t*>(words);
+    }
+
+    // Rest of samples, or unaligned buffer.
+    for (; index < num_of_samples; index++, src += 3) {
+        const uint32_t sample = src[0] | (src[1] << 8) | (src[2] << 16);
+
+        UNPACK_STORE(sample << left)
+    }
+#undef UNPACK_STORE
+}
+
+void PackFloatToInt24(
+                      float **channels,
+                      uint8_t *dst,
+                      unsigned int num_of_channels,
+                      unsigned int channel_len,
+                      unsigned int shift)
+                      {
+    const unsigned int num_of_samples = num_of_channels * channel_len;
+    // Right shift to make left aligned 32bit data right aligned 24bit.
+    const unsigned int right = 8 + shift;
+    unsigned int ch_idx = 0;
+    unsigned int wo_idx = 0;
+    unsigned int index = 0;
+
+// Load a sample as right aligned 24bit, and advance the channel.
+#define PACK_LOAD(sample)\
+    const uint32_t sample = static_cast<uint32_t>(FloatToLeftAligned(channels[ch_idx][wo_idx]) >> right);\
+    if (++ch_idx == num_of_channels) {\
+        ch_idx = 0;\
+        wo_idx++;\
+    }
+
+    // Fast path. 4 samples in 3 words.
+    if (0 == (reinterpret_cast<uintptr_t>(dst) & 3)) {
+        uint32_t *words = reinterpret_cast<uint32_t*>(dst);
+
+        for (; index + 4 <= num_of_samples; index += 4) {
+            PACK_LOAD(s0)
+            PACK_LOAD(s1)
+            PACK_LOAD(s2)
+            PACK_LOAD(s3)
+
+            *words++ = (s0 & 0x00FFFFFF) | (s1 << 24);          // byte 0, 1, 2 | 3
+            *words++ = ((s1 >> 8) & 0x0000FFFF) | (s2 << 16);   // byte 4, 5 | 6, 7
+            *words++ = ((s2 >> 16) & 0x000000FF) | (s3 << 8);   // byte 8 | 9, 10, 11
+        }
+        dst = reinterpret_cast<uint8_t*>(words);
+    }
+
+    // Rest of samples, or unaligned buffer.
+    for (; index < num_of_samples; index++, dst += 3) {
+        PACK_LOAD(sample)
+
+        dst[0] = static_cast<uint8_t>(sample);
+        dst[1] = static_cast<uint8_t>(sample >> 8);
+        dst[2] = static_cast<uint8_t>(sample >> 16);
+    }
+#undef PACK_LOAD
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,92 @@
+/**
+ * @file audioconversion.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Conversion kernels between the DMA buffer and the float audio channels.
+ * @details
+ * These functions are used by @ref murasaki::DuplexAudio. The DMA buffer is interleaved. That is,
+ * word0 of ch0, word0 of ch1, ... word0 of chN-1, word1 of ch0... The float channels are
+ * the array of pointers to the each channel buffer.
+ *
+ * The float value [-1.0, 1.0) corresponds to the full scale of the integer.
+ */
+
+#ifndef AUDIOCONVERSION_HPP_
+#define AUDIOCONVERSION_HPP_
+
+#include <stdint.h>
+
+namespace murasaki {
+
+/**
+ * @brief Convert the 32bit DMA data to the float channels.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param src Interleaved 32bit DMA data.
+ * @param channels Array of pointers to the channel buffers.
+ * @param num_of_channels Number of the channels.
+ * @param channel_len Number of the samples per channel.
+ * @param shift Left shift count to make the data left aligned.
+ */
+void UnpackInt32ToFloat(
+                        const int32_t *src,
+                        float **channels,
+                        unsigned int num_of_channels,
+                        unsigned int channel_len,
+                        unsigned int shift);
+
+/**
+ * @brief Convert the float channels to the 32bit DMA data.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param channels Array of pointers to the channel buffers.
+ * @param dst Interleaved 32bit DMA data.
+ * @param num_of_channels Number of the channels.
+ * @param channel_len Number of the samples per channel.
+ * @param shift Right shift count to make the data right aligned.
+ */
+void PackFloatToInt32(
+                      float **channels,
+                      int32_t *dst,
+                      unsigned int num_of_channels,
+                      unsigned int channel_len,
+                      unsigned int shift);
+
+/**
+ * @brief Convert the packed 24bit DMA data to the float channels.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param src Interleaved 3 byte little endian DMA data.
+ * @param channels Array of pointers to the channel buffers.
+ * @param num_of_channels Number of the channels.
+ * @param channel_len Number of the samples per channel.
+ * @param shift Left shift count to make the data left aligned in 24bit.
+ * @details
+ * If src is 4 byte aligned, 4 samples are extracted from 3 words at once.
+ */
+void UnpackInt24ToFloat(
+                        const uint8_t *src,
+                        float **channels,
+                        unsigned int num_of_channels,
+                        unsigned int channel_len,
+                        unsigned int shift);
+
+/**
+ * @brief Convert the float channels to the packed 24bit DMA data.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param channels Array of pointers to the channel buffers.
+ * @param dst Interleaved 3 byte little endian DMA data.
+ * @param num_of_channels Number of the channels.
+ * @param channel_len Number of the samples per channel.
+ * @param shift Right shift count to make the data right aligned in 24bit.
+ * @details
+ * If dst is 4 byte aligned, 4 samples are packed into 3 words at once.
+ */
+void PackFloatToInt24(
+                      float **channels,
+                      uint8_t *dst,
+                      unsigned int num_of_channels,
+                      unsigned int channel_len,
+                      unsigned int shift);
+
+} /* namespace murasaki */
+
+#endif /* AUDIOCONVERSION_HPP_ */
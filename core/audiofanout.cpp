@@ -0,0 +1,178 @@
+/*
+ * audiofanout.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <string.h>
+
+#include "audiofanout.hpp"
+#include "murasaki_assert.hpp"
+#include "murasaki_syslog.hpp"
+
+// Macro for easy-to-read
+#define FANOUT_SYSLOG(fmt, ...)    MURASAKI_SYSLOG(this, kfaAudio, kseDebug, fmt, ##__VA_ARGS__)
+
+// Prevent the compiler to reorder the memory access across this point.
+// The publisher and readers are tasks on the same core. So, the compiler barrier is enough.
+#define FANOUT_BARRIER() __asm volatile ("" ::: "memory")
+
+namespace murasaki {
+
+AudioFanout::AudioFanout(unsigned int num_of_blocks)
+        :
+        num_of_blocks_(num_of_blocks),
+        format_ { 0, 0, 0, 0 },
+        ring_(nullptr),
+        published_(0),
+        readers_ { },
+        num_of_readers_(0)
+{
+    FANOUT_SYSLOG("Enter. num_of_blocks : %d", num_of_blocks)
+
+    // Power of 2 keeps the block index continuous when the sequence number wraps around.
+    MURASAKI_ASSERT(1 < num_of_blocks_)
+    MURASAKI_ASSERT(0 == (num_of_blocks_ & (num_of_blocks_ - 1)))
+
+    FANOUT_SYSLOG("Return")
+}
+
+AudioFanout::~AudioFanout()
+{
+    delete[] ring_;
+}
+
+void AudioFanout::Attach(
+                         const murasaki::AudioTapFormat &tx,
+                         const murasaki::AudioTapFormat &rx)
+                         {
+    FANOUT_SYSLOG("Enter. rx block size : %d", rx.block_size)
+
+    // Attach only once.
+    MURASAKI_ASSERT(nullptr == ring_)
+
+    format_ = rx;
+    ring_ = new uint8_t[num_of_blocks_ * format_.block_size];
+    MURASAKI_ASSERT(nullptr != ring_)
+
+    FANOUT_SYSLOG("Return")
+}
+
+void AudioFanout::Tap(
+                      const uint8_t *tx_block,
+                      const uint8_t *rx_block,
+                      bool xrun)
+                      {
+    unsigned int sequence = published_;
+
+    // Overwrite the oldest block. The readers detect it by the sequence number.
+    ::memcpy(const_cast<uint8_t*>(GetBlock(sequence)), rx_block, format_.block_size);
+
+    // Publish after the copy is completed.
+    FANOUT_BARRIER();
+    published_ = sequence + 1;
+
+    // Wake all readers. Never blocks.
+    for (unsigned int i = 0; i < num_of_readers_; i++)
+        readers_[i]->sync_->Release();
+}
+
+const murasaki::AudioTapFormat& AudioFanout::GetFormat()
+{
+    return format_;
+}
+
+unsigned int AudioFanout::GetPublished()
+{
+    return published_;
+}
+
+unsigned int AudioFanout::AddReader(murasaki::AudioFanoutReader *reader)
+                                    {
+    FANOUT_SYSLOG("Enter. reader : %p", reader)
+
+    MURASAKI_ASSERT(nullptr != reader)
+    MURASAKI_ASSERT(nullptr != ring_)
+    MURASAKI_ASSERT(num_of_readers_ < NUM_OF_AUDIO_FANOUT_READERS)
+
+    // Store the reader before counting up. Tap() may run at any time.
+    readers_[num_of_readers_] = reader;
+    FANOUT_BARRIER();
+    num_of_readers_ = num_of_readers_ + 1;
+
+    FANOUT_SYSLOG("Return")
+    return published_;
+}
+
+const uint8_t* AudioFanout::GetBlock(unsigned int sequence)
+                                     {
+    return &ring_[(sequence & (num_of_blocks_ - 1)) * format_.block_size];
+}
+
+AudioFanoutReader::AudioFanoutReader(murasaki::AudioFanout *fanout)
+        :
+        fanout_(fanout),
+        sync_(new murasaki::Synchronizer()),
+        cursor_(0),
+        overruns_(0)
+{
+    MURASAKI_ASSERT(nullptr != fanout_)
+    MURASAKI_ASSERT(nullptr != sync_)
+
+    cursor_ = fanout_->AddReader(this);
+}
+
+AudioFanoutReader::~AudioFanoutReader()
+{
+    delete sync_;
+}
+
+const uint8_t* AudioFanoutReader::Acquire(unsigned int timeout_ms)
+                                          {
+    while (true) {
+        unsigned int published = fanout_->published_;
+
+        // The block at cursor_ is overwritten when published_ reaches cursor_ + num_of_blocks_.
+        // Skip to the latest block to have maximum time before the next overrun.
+        if (published - cursor_ >= fanout_->num_of_blocks_) {
+            overruns_ += published - 1 - cursor_;
+            cursor_ = published - 1;
+        }
+
+        if (published != cursor_) {
+            // Read the block after checking the sequence number.
+            FANOUT_BARRIER();
+            return fanout_->GetBlock(cursor_);
+        }
+
+        // No unread block. The semaphore may hold an old release. Then, loop again.
+        if (!sync_->Wait(timeout_ms))
+            return nullptr;
+    }
+}
+
+bool AudioFanoutReader::Release()
+{
+    // Check the sequence number after reading the block.
+    FANOUT_BARRIER();
+    bool valid = fanout_->published_ - cursor_ < fanout_->num_of_blocks_;
+
+    if (!valid)
+        overruns_++;
+    cursor_++;
+
+    return valid;
+}
+
+const murasaki::AudioTapFormat& AudioFanoutReader::GetFormat()
+{
+    return fanout_->format_;
+}
+
+unsigned int AudioFanoutReader::GetOverruns()
+{
+    return overruns_;
+}
+
+} /* namespace murasaki */
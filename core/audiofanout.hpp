@@ -0,0 +1,204 @@
+/**
+ * @file audiofanout.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Multi-consumer fan-out of the DuplexAudio RX stream.
+ */
+
+#ifndef AUDIOFANOUT_HPP_
+#define AUDIOFANOUT_HPP_
+
+#include "audiotapstrategy.hpp"
+#include "murasaki_config.hpp"
+#include "synchronizer.hpp"
+
+namespace murasaki {
+
+class AudioFanoutReader;
+
+/**
+ * @brief Publisher of the RX DMA blocks to the multiple readers.
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @details
+ * Each RX DMA block is copied once into a shared ring, and then, published by incrementing
+ * the sequence number. The readers are @ref AudioFanoutReader objects. Each reader has
+ * its own read cursor. So, the readers can read the same block at their own pace, without
+ * copying.
+ *
+ * The publisher never waits for the readers. If a reader is slower than the audio,
+ * its cursor is overrun by the publisher. The overrun is detected by the reader. See
+ * @ref AudioFanoutReader.
+ *
+ * The @ref Tap() is called from DuplexAudio::TransmitAndReceive(). So, the audio task is
+ * not blocked by the readers at all.
+ *
+ * @code
+ *     // 16 blocks ring.
+ *     fanout = new murasaki::AudioFanout(16);
+ *     audio->AddTap(fanout);
+ *     recorder_reader = new murasaki::AudioFanoutReader(fanout);
+ *     meter_reader = new murasaki::AudioFanoutReader(fanout);
+ *     ...
+ *     // In the recorder task
+ *     while (true) {
+ *         const uint8_t *block = recorder_reader->Acquire();
+ *         WriteToFile(block, recorder_reader->GetFormat().block_size);
+ *         if (! recorder_reader->Release())
+ *             ;   // The block was overwritten during the write.
+ *     }
+ * @endcode
+ */
+class AudioFanout : public AudioTapStrategy {
+ public:
+    AudioFanout() = delete;
+    /**
+     * @brief Constructor.
+     * @param num_of_blocks Number of the blocks in the ring. Must be power of 2.
+     * @details
+     * The ring buffer is allocated when this object is added to the DuplexAudio.
+     *
+     * A reader can hold up to num_of_blocks - 1 blocks behind the publisher without overrun.
+     */
+    explicit AudioFanout(unsigned int num_of_blocks);
+    virtual ~AudioFanout();
+
+    /**
+     * @brief Allocate the ring buffer.
+     * @param tx Format of the TX DMA block. Ignored.
+     * @param rx Format of the RX DMA block.
+     * @details
+     * Called from DuplexAudio::AddTap(). Do not call from application.
+     */
+    virtual void Attach(
+                        const murasaki::AudioTapFormat &tx,
+                        const murasaki::AudioTapFormat &rx);
+
+    /**
+     * @brief Publish the RX block to the readers.
+     * @param tx_block TX DMA block. Ignored.
+     * @param rx_block RX DMA block.
+     * @param xrun Ignored.
+     * @details
+     * Called from DuplexAudio::TransmitAndReceive(). Do not call from application.
+     *
+     * Copy the block into the ring, increment the sequence number, and then, wake all readers.
+     */
+    virtual void Tap(
+                     const uint8_t *tx_block,
+                     const uint8_t *rx_block,
+                     bool xrun);
+
+    /**
+     * @brief Format of the published block.
+     * @return The RX format given by DuplexAudio.
+     */
+    const murasaki::AudioTapFormat& GetFormat();
+
+    /**
+     * @brief Number of the published blocks.
+     * @return Sequence number of the next block. Wraps around at 2^32.
+     */
+    unsigned int GetPublished();
+
+ private:
+    friend class AudioFanoutReader;
+
+    /**
+     * @brief Register a reader.
+     * @param reader The reader to wake at each publish.
+     * @return The sequence number of the next block.
+     * @details
+     * Called from the constructor of the AudioFanoutReader.
+     */
+    unsigned int AddReader(murasaki::AudioFanoutReader *reader);
+
+    /**
+     * @brief Obtain the block in the ring.
+     * @param sequence Sequence number of the block.
+     * @return Pointer to the block.
+     */
+    const uint8_t* GetBlock(unsigned int sequence);
+
+    const unsigned int num_of_blocks_;
+    murasaki::AudioTapFormat format_;
+    uint8_t *ring_;
+    // Sequence number of the next block to publish.
+    volatile unsigned int published_;
+    murasaki::AudioFanoutReader *readers_[NUM_OF_AUDIO_FANOUT_READERS];
+    volatile unsigned int num_of_readers_;
+};
+
+/**
+ * @brief Reader of the @ref AudioFanout.
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @details
+ * A reader has its own read cursor. The @ref Acquire() returns the pointer to the block
+ * in the ring of the AudioFanout, without copying. The block is valid until the @ref Release().
+ *
+ * If the reader is slower than the audio, the publisher overwrites the unread blocks.
+ * This overrun is detected by both Acquire() and Release():
+ * @li Acquire() skips the overwritten blocks and jumps to the latest block.
+ * @li Release() returns false if the block was overwritten during the read.
+ *
+ * The number of the lost blocks is obtained by @ref GetOverruns().
+ *
+ * Only one task can use a reader object.
+ */
+class AudioFanoutReader {
+ public:
+    AudioFanoutReader() = delete;
+    /**
+     * @brief Constructor.
+     * @param fanout The publisher to read. Must be attached to the DuplexAudio already.
+     * @details
+     * The reader starts from the next block to publish.
+     */
+    explicit AudioFanoutReader(murasaki::AudioFanout *fanout);
+    virtual ~AudioFanoutReader();
+
+    /**
+     * @brief Obtain the oldest unread block.
+     * @param timeout_ms Time out [mS]
+     * @return Pointer to the block. nullptr if timeout.
+     * @details
+     * If there is no unread block, wait for the publish.
+     *
+     * Call Release() when the block is processed. Calling Acquire() again without Release()
+     * returns the same block.
+     */
+    const uint8_t* Acquire(unsigned int timeout_ms = murasaki::kwmsIndefinitely);
+
+    /**
+     * @brief Release the block obtained by Acquire().
+     * @return true if the block was valid during the read. false if it was overwritten.
+     * @details
+     * Advance the cursor to the next block.
+     */
+    bool Release();
+
+    /**
+     * @brief Format of the block.
+     * @return The RX format of the DuplexAudio.
+     */
+    const murasaki::AudioTapFormat& GetFormat();
+
+    /**
+     * @brief Number of the lost blocks.
+     * @return Accumulated number of the blocks which were overwritten before or during the read.
+     */
+    unsigned int GetOverruns();
+
+ private:
+    friend class AudioFanout;
+
+    murasaki::AudioFanout *const fanout_;
+    murasaki::Synchronizer *const sync_;
+    // Sequence number of the next block to read.
+    unsigned int cursor_;
+    unsigned int overruns_;
+};
+
+} /* namespace murasaki */
+
+#endif /* AUDIOFANOUT_HPP_ */
@@ -0,0 +1,216 @@
+/*
+ * audiomeasurement.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "audiomeasurement.hpp"
+#include "debugger.hpp"
+#include "murasaki_assert.hpp"
+#include "murasaki_syslog.hpp"
+
+// Macro for easy-to-read
+#define MEASUREMENT_SYSLOG(fmt, ...)    MURASAKI_SYSLOG(this, kfaAudio, kseDebug, fmt, ##__VA_ARGS__)
+
+namespace murasaki {
+
+// Print the value in dB with 2 digits below the decimal point.
+// The printf of the newlib nano doesn't support float. So, print as integer.
+static void PrintDecibel(
+                         const char *label,
+                         float value,
+                         const char *unit)
+                         {
+    int hundredths = static_cast<int>(lroundf(value * 100.0f));
+    const char *sign = (hundredths < 0) ? "-" : " ";
+
+    if (hundredths < 0)
+        hundredths = -hundredths;
+
+    murasaki::debugger->Printf("%-22s : %s%d.%02d %s\n", label, sign, hundredths / 100, hundredths % 100, unit);
+}
+
+AudioMeasurement::AudioMeasurement(
+                                   murasaki::DuplexAudio *audio,
+                                   unsigned int channel_length,
+                                   unsigned int sample_rate,
+                                   unsigned int tx_num_of_channels,
+                                   unsigned int rx_num_of_channels,
+                                   unsigned int capture_blocks,
+                                   unsigned int settle_blocks)
+        :
+        audio_(audio),
+        channel_len_(channel_length),
+        sample_rate_(sample_rate),
+        tx_num_of_channels_(tx_num_of_channels),
+        rx_num_of_channels_(rx_num_of_channels),
+        capture_blocks_(capture_blocks),
+        settle_blocks_(settle_blocks),
+        capture_len_(channel_length * capture_blocks),
+        analyzer_(sample_rate, channel_length * capture_blocks),
+        tx_channels_(new float*[tx_num_of_channels]),
+        rx_channels_(new float*[rx_num_of_channels]),
+        capture_(new float[channel_length * capture_blocks])
+{
+    MEASUREMENT_SYSLOG("Enter.  channel_length : %d, sample_rate : %d", channel_length, sample_rate)
+
+    MURASAKI_ASSERT(nullptr != audio_)
+    MURASAKI_ASSERT(0 < capture_blocks_)
+    MURASAKI_ASSERT(nullptr != tx_channels_)
+    MURASAKI_ASSERT(nullptr != rx_channels_)
+    MURASAKI_ASSERT(nullptr != capture_)
+
+    // Allocate the channel buffers.
+    for (unsigned int ch = 0; ch < tx_num_of_channels_; ch++) {
+        tx_channels_[ch] = new float[channel_len_];
+        MURASAKI_ASSERT(nullptr != tx_channels_[ch])
+    }
+    for (unsigned int ch = 0; ch < rx_num_of_channels_; ch++) {
+        rx_channels_[ch] = new float[channel_len_];
+        MURASAKI_ASSERT(nullptr != rx_channels_[ch])
+    }
+
+    MEASUREMENT_SYSLOG("Return")
+}
+
+AudioMeasurement::~AudioMeasurement()
+{
+    for (unsigned int ch = 0; ch < tx_num_of_channels_; ch++)
+        delete[] tx_channels_[ch];
+    for (unsigned int ch = 0; ch < rx_num_of_channels_; ch++)
+        delete[] rx_channels_[ch];
+
+    delete[] tx_channels_;
+    delete[] rx_channels_;
+    delete[] capture_;
+}
+
+void AudioMeasurement::MeasureSingleTone(
+                                         float frequency,
+                                         float amplitude,
+                                         unsigned int tx_channel,
+                                         unsigned int rx_channel,
+                                         murasaki::AudioAnalysisResult *result)
+                                         {
+    MURASAKI_ASSERT(nullptr != result)
+
+    float coherent_frequency = analyzer_.GetCoherentFrequency(frequency);
+
+    Run(coherent_frequency, amplitude, tx_channel, rx_channel);
+    analyzer_.Analyze(capture_, coherent_frequency, result);
+}
+
+float AudioMeasurement::MeasureNoiseFloor(unsigned int rx_channel)
+                                          {
+    // Output silence to all channels.
+    Run(0.0f, 0.0f, 0, rx_channel);
+    return analyzer_.GetRmsDbfs(capture_);
+}
+
+void AudioMeasurement::MeasureFrequencyResponse(
+                                                const float *frequencies,
+                                                unsigned int num_of_frequencies,
+                                                float amplitude,
+                                                unsigned int tx_channel,
+                                                unsigned int rx_channel,
+                                                float *gain_db)
+                                                {
+    MURASAKI_ASSERT(nullptr != frequencies)
+    MURASAKI_ASSERT(nullptr != gain_db)
+    MURASAKI_ASSERT(0.0f < amplitude)
+
+    for (unsigned int i = 0; i < num_of_frequencies; i++) {
+        float coherent_frequency = analyzer_.GetCoherentFrequency(frequencies[i]);
+
+        Run(coherent_frequency, amplitude, tx_channel, rx_channel);
+        float gain = analyzer_.GetAmplitude(capture_, coherent_frequency) / amplitude;
+        gain_db[i] = AudioAnalyzer::PowerToDb(gain * gain);
+    }
+}
+
+void AudioMeasurement::Report(
+                              unsigned int tx_channel,
+                              unsigned int rx_channel)
+                              {
+    static const float kOctaves[] = { 63.0f, 125.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f };
+    static const unsigned int kNumOfOctaves = sizeof(kOctaves) / sizeof(kOctaves[0]);
+    float gain_db[kNumOfOctaves];
+    murasaki::AudioAnalysisResult result;
+
+    murasaki::debugger->Printf("\n            Audio measurement\n");
+    murasaki::debugger->Printf("Fs : %dHz, capture : %d samples, TX ch %d -> RX ch %d\n",
+                               sample_rate_, capture_len_, tx_channel, rx_channel);
+
+    // Noise floor
+    PrintDecibel("Noise floor", MeasureNoiseFloor(rx_channel), "dBFS");
+
+    // Single tone.
+    MeasureSingleTone(1000.0f, powf(10.0f, -1.0f / 20.0f), tx_channel, rx_channel, &result);
+    murasaki::debugger->Printf("Single tone %dHz, -1dBFS\n", static_cast<int>(lroundf(result.frequency)));
+    PrintDecibel("  Fundamental", result.fundamental_dbfs, "dBFS");
+    PrintDecibel("  THD", result.thd_db, "dB");
+    PrintDecibel("  THD+N", result.thd_n_db, "dB");
+    PrintDecibel("  SNR", result.snr_db, "dB");
+
+    // Frequency response.
+    MeasureFrequencyResponse(kOctaves, kNumOfOctaves, powf(10.0f, -10.0f / 20.0f), tx_channel, rx_channel, gain_db);
+    murasaki::debugger->Printf("Frequency response, -10dBFS\n");
+    for (unsigned int i = 0; i < kNumOfOctaves; i++) {
+        // Skip the frequency which is not representable by the capture length.
+        if (kOctaves[i] * 2 >= sample_rate_)
+            continue;
+
+        char label[16];
+        ::snprintf(label, sizeof(label), "  %dHz", static_cast<int>(lroundf(analyzer_.GetCoherentFrequency(kOctaves[i]))));
+        PrintDecibel(label, gain_db[i], "dB");
+    }
+}
+
+void AudioMeasurement::Run(
+                           float frequency,
+                           float amplitude,
+                           unsigned int tx_channel,
+                           unsigned int rx_channel)
+                           {
+    MEASUREMENT_SYSLOG("Enter. frequency : %d, tx_channel : %d, rx_channel : %d",
+                       static_cast<int>(frequency), tx_channel, rx_channel)
+
+    MURASAKI_ASSERT(tx_channel < tx_num_of_channels_)
+    MURASAKI_ASSERT(rx_channel < rx_num_of_channels_)
+
+    // Number of cycles in the capture length. Integer for the coherent sampling.
+    const unsigned int cycles = static_cast<unsigned int>(lroundf(frequency * capture_len_ / sample_rate_));
+    // Phase index of the sine wave. Advanced modulo capture_len_, to avoid the overflow.
+    const unsigned int step = cycles % capture_len_;
+    unsigned int phase_index = 0;
+
+    // Clear all TX channels.
+    for (unsigned int ch = 0; ch < tx_num_of_channels_; ch++)
+        for (unsigned int i = 0; i < channel_len_; i++)
+            tx_channels_[ch][i] = 0.0f;
+
+    for (unsigned int block = 0; block < settle_blocks_ + capture_blocks_; block++) {
+        // Generate the sine wave. The phase index is kept in integer to keep the precision.
+        for (unsigned int i = 0; i < channel_len_; i++) {
+            tx_channels_[tx_channel][i] = amplitude * sinf(2.0f * static_cast<float>(M_PI) * phase_index / capture_len_);
+            phase_index += step;
+            if (phase_index >= capture_len_)
+                phase_index -= capture_len_;
+        }
+
+        audio_->TransmitAndReceive(tx_channels_, rx_channels_, tx_num_of_channels_, rx_num_of_channels_);
+
+        // Capture after settled.
+        if (block >= settle_blocks_)
+            for (unsigned int i = 0; i < channel_len_; i++)
+                capture_[(block - settle_blocks_) * channel_len_ + i] = rx_channels_[rx_channel][i];
+    }
+
+    MEASUREMENT_SYSLOG("Return")
+}
+
+} /* namespace murasaki */
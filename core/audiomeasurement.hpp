@@ -0,0 +1,145 @@
+/**
+ * @file audiomeasurement.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief THD+N, SNR and frequency response measurement on the DuplexAudio.
+ */
+
+#ifndef AUDIOMEASUREMENT_HPP_
+#define AUDIOMEASUREMENT_HPP_
+
+#include "duplexaudio.hpp"
+#include "audioanalyzer.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Built-in audio analyzer.
+ * @ingroup MURASAKI_HELPER_GROUP
+ * @details
+ * Generate a sine wave on the TX channel of the @ref DuplexAudio, and capture the RX channel.
+ * Then, analyze the captured data by @ref AudioAnalyzer. The external loop back from the
+ * codec output to the codec input is assumed. To check the algorithm without the hardware,
+ * use the @ref LoopbackPortAdapter.
+ *
+ * The member functions of this class call DuplexAudio::TransmitAndReceive() by itself.
+ * So, they have to be called from the audio task, instead of the usual audio processing.
+ * The audio processing is stopped during the measurement.
+ *
+ * The test frequency is rounded to the coherent frequency of the capture length.
+ * The capture length is channel_length * capture_blocks samples.
+ *
+ * @code
+ *     measurement = new murasaki::AudioMeasurement(audio, 48, 48000, 2, 2);
+ *     measurement->Report(0, 0);    // TX left to RX left.
+ * @endcode
+ */
+class AudioMeasurement
+{
+ public:
+    AudioMeasurement() = delete;
+    /**
+     * @brief Constructor.
+     * @param audio Pointer to the DuplexAudio to measure.
+     * @param channel_length Number of samples per channel in a block. Must be the same with the DuplexAudio.
+     * @param sample_rate Sampling frequency of the audio [Hz]. Used to calculate the frequency.
+     * @param tx_num_of_channels Number of the TX channels of the DuplexAudio.
+     * @param rx_num_of_channels Number of the RX channels of the DuplexAudio.
+     * @param capture_blocks Number of the blocks to analyze.
+     * @param settle_blocks Number of the blocks to skip before capture. Must cover the latency of the loop.
+     */
+    AudioMeasurement(
+                     murasaki::DuplexAudio *audio,
+                     unsigned int channel_length,
+                     unsigned int sample_rate,
+                     unsigned int tx_num_of_channels,
+                     unsigned int rx_num_of_channels,
+                     unsigned int capture_blocks = 16,
+                     unsigned int settle_blocks = 8);
+    virtual ~AudioMeasurement();
+
+    /**
+     * @brief Measure the THD, THD+N and SNR by single tone.
+     * @param frequency Test frequency [Hz]. Rounded to the coherent frequency.
+     * @param amplitude Peak amplitude of the test tone. 1.0 is full scale.
+     * @param tx_channel TX channel to output the test tone. Other channels output silence.
+     * @param rx_channel RX channel to analyze.
+     * @param result Pointer to the result.
+     */
+    void MeasureSingleTone(
+                           float frequency,
+                           float amplitude,
+                           unsigned int tx_channel,
+                           unsigned int rx_channel,
+                           murasaki::AudioAnalysisResult *result);
+
+    /**
+     * @brief Measure the noise floor.
+     * @param rx_channel RX channel to analyze.
+     * @return RMS noise level while TX is silent [dBFS].
+     */
+    float MeasureNoiseFloor(unsigned int rx_channel);
+
+    /**
+     * @brief Measure the frequency response.
+     * @param frequencies Array of the test frequencies [Hz]. Each frequency is rounded to the coherent frequency.
+     * @param num_of_frequencies Number of the element of the frequencies and gain_db.
+     * @param amplitude Peak amplitude of the test tone. 1.0 is full scale.
+     * @param tx_channel TX channel to output the test tone.
+     * @param rx_channel RX channel to analyze.
+     * @param gain_db Array to store the gain from TX to RX at each frequency [dB].
+     */
+    void MeasureFrequencyResponse(
+                                  const float *frequencies,
+                                  unsigned int num_of_frequencies,
+                                  float amplitude,
+                                  unsigned int tx_channel,
+                                  unsigned int rx_channel,
+                                  float *gain_db);
+
+    /**
+     * @brief Run the standard measurement and print the report.
+     * @param tx_channel TX channel to output the test tone.
+     * @param rx_channel RX channel to analyze.
+     * @details
+     * Measure the noise floor, the single tone of 1kHz -1dBFS and the frequency response of
+     * octave frequencies at -10dBFS. The result is printed through the murasaki::debugger.
+     */
+    void Report(
+                unsigned int tx_channel,
+                unsigned int rx_channel);
+
+ private:
+    /**
+     * @brief Output the sine wave and capture the RX.
+     * @param frequency Coherent frequency of the sine wave [Hz]. Ignored if amplitude is 0.
+     * @param amplitude Peak amplitude of the sine wave.
+     * @param tx_channel TX channel to output the test tone.
+     * @param rx_channel RX channel to capture.
+     * @details
+     * The captured data is stored in the capture_.
+     */
+    void Run(
+             float frequency,
+             float amplitude,
+             unsigned int tx_channel,
+             unsigned int rx_channel);
+
+    murasaki::DuplexAudio *const audio_;
+    const unsigned int channel_len_;
+    const unsigned int sample_rate_;
+    const unsigned int tx_num_of_channels_;
+    const unsigned int rx_num_of_channels_;
+    const unsigned int capture_blocks_;
+    const unsigned int settle_blocks_;
+    const unsigned int capture_len_;
+    murasaki::AudioAnalyzer analyzer_;
+    float **const tx_channels_;
+    float **const rx_channels_;
+    float *const capture_;
+};
+
+} /* namespace murasaki */
+
+#endif /* AUDIOMEASUREMENT_HPP_ */
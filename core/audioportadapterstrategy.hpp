@@ -48,6 +48,28 @@ class AudioPortAdapterStrategy : public murasaki::PeripheralStrategy {
                                  unsigned int channel_len
                                  ) = 0;
 
+    /**
+     * @brief Stop the TX DMA transfer.
+     * @details
+     * Called by the @ref DuplexAudio to recover from the error. After this call,
+     * the @ref StartTransferTx() is called again to restart.
+     *
+     * By default, do nothing. Override if the peripheral can be stopped.
+     */
+    virtual void StopTransferTx() {
+    }
+
+    /**
+     * @brief Stop the RX DMA transfer.
+     * @details
+     * Called by the @ref DuplexAudio to recover from the error. After this call,
+     * the @ref StartTransferRx() is called again to restart.
+     *
+     * By default, do nothing. Override if the peripheral can be stopped.
+     */
+    virtual void StopTransferRx() {
+    }
+
     /**
      * @brief Return how many DMA phase is implemented
      * @return 2 for Double buffer, 3 for Tripple buffer.
@@ -79,10 +101,13 @@ class AudioPortAdapterStrategy : public murasaki::PeripheralStrategy {
 
     /**
      * @brief Return the size of the one sample on memory for Tx channel
-     * @return 2 or 4. The unit is [Byte]
+     * @return 2, 3 or 4. The unit is [Byte]
      * @details
      * This function returns the size of the word which should be
      * allocated on the memory.
+     *
+     * 3 means the packed 24bit little endian format. The peripheral DMA have to be capable
+     * to transfer the 3 byte word without padding.
      */
     virtual unsigned int GetSampleWordSizeTx() = 0;
 
@@ -111,10 +136,13 @@ class AudioPortAdapterStrategy : public murasaki::PeripheralStrategy {
 
     /**
      * @brief Return the size of the one sample on memory for Rx channel
-     * @return 2 or 4. The unit is [Byte]
+     * @return 2, 3 or 4. The unit is [Byte]
      * @details
      * This function returns the size of the word which should be
      * allocated on the memory.
+     *
+     * 3 means the packed 24bit little endian format. The peripheral DMA have to be capable
+     * to transfer the 3 byte word without padding.
      */
     virtual unsigned int GetSampleWordSizeRx() = 0;
 
@@ -141,7 +169,8 @@ class AudioPortAdapterStrategy : public murasaki::PeripheralStrategy {
      * @details
      * A member function to detect error.
      *
-     * Note, we assume once this error call back is called, we can't recover.
+     * The implementation should report the error and return. Do not stop the system.
+     * The @ref DuplexAudio stops and restarts the transfer to recover from the error.
      */
     virtual bool HandleError(void *ptr)= 0;
 
@@ -0,0 +1,75 @@
+/**
+ * @file audiotapstrategy.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Strategy of the observer of the DuplexAudio DMA blocks.
+ */
+
+#ifndef AUDIOTAPSTRATEGY_HPP_
+#define AUDIOTAPSTRATEGY_HPP_
+
+#include <stdint.h>
+
+namespace murasaki {
+
+/**
+ * @brief Format of the DMA block passed to the audio tap.
+ * \ingroup MURASAKI_DEFINITION_GROUP
+ * @details
+ * The DMA block is interleaved. That is, word0 of ch0, word0 of ch1, ... word0 of chN-1, word1 of ch0...
+ */
+struct AudioTapFormat
+{
+    unsigned int block_size;        ///< Size of a DMA block [Byte].
+    unsigned int num_of_channels;   ///< Number of the interleaved channels.
+    unsigned int word_size;         ///< Size of a sample in the DMA block [Byte].
+    unsigned int shift;             ///< Left shift count to make a sample left aligned in the word.
+};
+
+/**
+ * @brief Strategy of the observer of the DuplexAudio DMA blocks.
+ * \ingroup MURASAKI_ABSTRACT_GROUP
+ * @details
+ * The derived object is registered to @ref DuplexAudio::AddTap(). Then, DuplexAudio
+ * passes the raw TX and RX DMA blocks to @ref Tap() at every TransmitAndReceive().
+ *
+ * The Tap() member function is called in the audio task. Do not block, and keep it short.
+ * Typically, the implementation just copies the blocks, and processes them in the other task.
+ */
+class AudioTapStrategy {
+ public:
+    virtual ~AudioTapStrategy() {
+    }
+    ;
+
+    /**
+     * @brief Receive the format of the DMA blocks.
+     * @param tx Format of the TX DMA block.
+     * @param rx Format of the RX DMA block.
+     * @details
+     * Called once from DuplexAudio::AddTap(). The implementation can allocate its buffer here.
+     */
+    virtual void Attach(
+                        const murasaki::AudioTapFormat &tx,
+                        const murasaki::AudioTapFormat &rx) = 0;
+
+    /**
+     * @brief Observe the DMA blocks.
+     * @param tx_block TX DMA block which will be transmitted.
+     * @param rx_block RX DMA block which was received.
+     * @param xrun true if the DuplexAudio detected missing DMA phases since the last block.
+     * @details
+     * Called from the DuplexAudio::TransmitAndReceive(), after the data conversion.
+     * The blocks are valid only during this call.
+     */
+    virtual void Tap(
+                     const uint8_t *tx_block,
+                     const uint8_t *rx_block,
+                     bool xrun) = 0;
+};
+
+}
+/* namespace murasaki */
+
+#endif /* AUDIOTAPSTRATEGY_HPP_ */
@@ -11,7 +11,11 @@
 namespace murasaki {
 
 CriticalSection::CriticalSection():
+#if MURASAKI_CONFIG_STATIC_ALLOCATION
+		mutex_(xSemaphoreCreateMutexStatic(&mutex_buffer_))
+#else
 		mutex_(xSemaphoreCreateMutex())            // create semaphore as "empty" state
+#endif
 
 {
     MURASAKI_ASSERT(nullptr != mutex_)
@@ -39,5 +43,35 @@ void CriticalSection::Leave()
     MURASAKI_ASSERT(result);    // true if xSemaphoreGive() success
 }
 
+RecursiveCriticalSection::RecursiveCriticalSection()
+        :
+#if MURASAKI_CONFIG_STATIC_ALLOCATION
+          mutex_(xSemaphoreCreateRecursiveMutexStatic(&mutex_buffer_))
+#else
+          mutex_(xSemaphoreCreateRecursiveMutex())
+#endif
+{
+    MURASAKI_ASSERT(nullptr != mutex_)
+}
+
+RecursiveCriticalSection::~RecursiveCriticalSection()
+{
+    if (nullptr != mutex_)
+        vSemaphoreDelete(mutex_);
+}
+
+void RecursiveCriticalSection::Enter()
+{
+    MURASAKI_ASSERT(! murasaki::IsInsideInterrupt());
+    bool result = xSemaphoreTakeRecursive(mutex_, portMAX_DELAY);
+    MURASAKI_ASSERT(result);    // true if xSemaphoreTakeRecursive() success
+}
+
+void RecursiveCriticalSection::Leave()
+{
+    MURASAKI_ASSERT(! murasaki::IsInsideInterrupt());
+    bool result = xSemaphoreGiveRecursive(mutex_);
+    MURASAKI_ASSERT(result);    // true if xSemaphoreGiveRecursive() success
+}
 
 } /* namespace murasaki */
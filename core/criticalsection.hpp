@@ -10,6 +10,10 @@
 #define CRITICALSECTION_HPP_
 #include <FreeRTOS.h>
 #include <semphr.h>
+#include <task.h>
+#include "murasaki_config.hpp"
+#include "murasaki_defs.hpp"
+#include "murasaki_assert.hpp"
 
 namespace murasaki {
 
@@ -53,10 +57,192 @@ class CriticalSection
      * member function.
      */
     void Leave();
+    /**
+     * \brief The task can wait for the other object inside this critical section.
+     */
+    static constexpr bool kCanBlock = true;
+ private:
+#if MURASAKI_CONFIG_STATIC_ALLOCATION
+    // Storage of the mutex. See MURASAKI_CONFIG_STATIC_ALLOCATION.
+    StaticSemaphore_t mutex_buffer_;
+#endif
+    SemaphoreHandle_t const mutex_;
+};
+
+/**
+ * \brief A critical section which can be entered again by the same task.
+ * \details
+ * Same with the \ref CriticalSection, except the task inside the critical section can call Enter() again.
+ * The critical section is left when the Leave() is called as many as the Enter().
+ *
+ * Useful to protect a sequence of the member functions which enter the same critical section.
+ * This class is for the task context only.
+ */
+class RecursiveCriticalSection
+{
+ public:
+    /**
+     * \brief Constructor. Creating recursive mutex internally.
+     */
+    RecursiveCriticalSection();
+    /**
+     * \brief Destructor. Deleting recursive mutex internally.
+     */
+    virtual ~RecursiveCriticalSection();
+    /**
+     * \brief Entering critical section
+     */
+    void Enter();
+    /**
+     * \brief Leaving crititical section
+     */
+    void Leave();
+    /**
+     * \brief The task can wait for the other object inside this critical section.
+     */
+    static constexpr bool kCanBlock = true;
  private:
+#if MURASAKI_CONFIG_STATIC_ALLOCATION
+    // Storage of the mutex. See MURASAKI_CONFIG_STATIC_ALLOCATION.
+    StaticSemaphore_t mutex_buffer_;
+#endif
     SemaphoreHandle_t const mutex_;
 };
 
+/**
+ * \brief A critical section by masking the interrupts.
+ * \details
+ * Mask the interrupts up to the configMAX_SYSCALL_INTERRUPT_PRIORITY by the BASEPRI register
+ * ( PRIMASK on Cortex-M0/M0+ ). Both the task and ISR can enter. The cost is a few tens of cycles.
+ *
+ * The section must be short, because it adds to the interrupt latency. And the task must not wait
+ * inside this section.
+ *
+ * The critical section can be nested in the same context.
+ */
+class InterruptCriticalSection
+{
+ public:
+    /**
+     * \brief Constructor.
+     */
+    InterruptCriticalSection()
+            : saved_(0), nest_(0)
+    {
+    }
+    /**
+     * \brief Entering critical section. Can be called from both task and ISR.
+     */
+    void Enter()
+    {
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        // Keep the mask of the outermost entry only. Nobody else can come here until it leaves.
+        if (nest_++ == 0)
+            saved_ = saved;
+    }
+    /**
+     * \brief Leaving crititical section. Can be called from both task and ISR.
+     */
+    void Leave()
+    {
+        if (--nest_ == 0)
+            taskEXIT_CRITICAL_FROM_ISR(saved_);
+    }
+    /**
+     * \brief The task must not wait inside this critical section.
+     */
+    static constexpr bool kCanBlock = false;
+ private:
+    UBaseType_t saved_;
+    unsigned int nest_;
+};
+
+/**
+ * \brief A critical section by suspending the scheduler.
+ * \details
+ * Prevent the other tasks to preempt, while the interrupts are kept enabled. So, the interrupt
+ * latency is not affected. The cost is a few tens of cycles, unless a task is woken by an ISR
+ * in the section.
+ *
+ * This class is for the task context only. The data shared with ISR is not protected. And the
+ * task must not wait inside this section.
+ *
+ * The critical section can be nested.
+ */
+class SchedulerCriticalSection
+{
+ public:
+    /**
+     * \brief Entering critical section.
+     */
+    void Enter()
+    {
+        MURASAKI_ASSERT(!murasaki::IsInsideInterrupt());
+        ::vTaskSuspendAll();
+    }
+    /**
+     * \brief Leaving crititical section.
+     */
+    void Leave()
+    {
+        ::xTaskResumeAll();
+    }
+    /**
+     * \brief The task must not wait inside this critical section.
+     */
+    static constexpr bool kCanBlock = false;
+};
+
+/**
+ * \brief Enter the critical section in the scope.
+ * \tparam T Type of the critical section.
+ * \details
+ * Enter the critical section at the construction, and leave at the destruction. So, the critical section is
+ * left at any return from the scope :
+ * @code
+ *     {
+ *         murasaki::CriticalSectionGuard<murasaki::InterruptCriticalSection> guard(&status_section_);
+ *         status_ = new_status;
+ *     }
+ * @endcode
+ */
+template<typename T>
+class CriticalSectionGuard
+{
+ public:
+    /**
+     * \brief Enter the critical section.
+     * \param section The critical section to enter.
+     */
+    explicit CriticalSectionGuard(T *section)
+            : section_(section)
+    {
+        section_->Enter();
+    }
+    /**
+     * \brief Leave the critical section.
+     */
+    ~CriticalSectionGuard()
+    {
+        section_->Leave();
+    }
+    CriticalSectionGuard(const CriticalSectionGuard&) = delete;
+    CriticalSectionGuard& operator=(const CriticalSectionGuard&) = delete;
+ private:
+    T *const section_;
+};
+
+/**
+ * \brief Critical section used by the peripheral classes.
+ * \details
+ * Chosen by the @ref PLATFORM_CONFIG_PERIPHERAL_CRITICAL_SECTION. The peripheral classes wait for
+ * the interrupt inside the critical section. So, it must be the class which the task can wait inside.
+ */
+typedef PLATFORM_CONFIG_PERIPHERAL_CRITICAL_SECTION PeripheralCriticalSection;
+
+static_assert(PeripheralCriticalSection::kCanBlock,
+              "PLATFORM_CONFIG_PERIPHERAL_CRITICAL_SECTION must be CriticalSection or RecursiveCriticalSection");
+
 /**
  * \} MURASAKI_SYNC_GROUP
  */
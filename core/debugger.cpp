@@ -15,6 +15,8 @@
 #include <algorithm>
 
 #include "murasaki_assert.hpp"
+#include "murasaki_atomic.hpp"
+#include "murasaki_timebase.hpp"
 
 // Watch the logger and trigger the rewind.
 static void AutoRePrintTaskBody(const void* ptr);
@@ -37,13 +39,16 @@ Debugger::Debugger(LoggerStrategy * logger)
                                             PLATFORM_CONFIG_DEBUG_TASK_PRIORITY, /* execusion priority of task */
                                             &helpers_, /* parameter to task */
                                             &TxTaskBody /* Task body */
-                                            ))
+                                            )),
+          lines_in_use_(0),
+          max_masked_cycles_(0)
 
 {
     // initialize internal variable;
     MURASAKI_ASSERT(logger != nullptr)
     MURASAKI_ASSERT(helpers_.fifo != nullptr)
     MURASAKI_ASSERT(tx_task_ != nullptr);
+    MURASAKI_ASSERT(0 < PLATFORM_CONFIG_DEBUG_NUM_OF_LINES && PLATFORM_CONFIG_DEBUG_NUM_OF_LINES <= 32);
 
     auto_reprint_enable_ = false;
     auto_reprint_task = nullptr;
@@ -67,44 +72,135 @@ Debugger::~Debugger()
         delete helpers_.fifo;
 }
 
+#if !MURASAKI_CONFIG_LIGHT_PRINTF
 void Debugger::Printf(const char * fmt, ...)
                       {
     // obtain variable parameter list
     va_list argp;
 
+    ::va_start(argp, fmt);
+    PrintLine(&Debugger::VFormatLine, fmt, &argp);
+    ::va_end(argp);
+}
+#endif
+
+void Debugger::VFormatLine(char *line, unsigned int size, const char *fmt, void *context)
+                           {
+    ::vsnprintf(line, size, fmt, *static_cast<va_list*>(context));
+}
+
+void Debugger::FormatArgsLine(char *line, unsigned int size, const char *fmt, void *context)
+                              {
+    const FormatArgList *list = static_cast<const FormatArgList*>(context);
+
+    murasaki::FormatString(line, size, fmt, list->args, list->num_of_args);
+}
+
+void Debugger::PrintLine(LineFormatter formatter, const char *fmt, void *context)
+                         {
+    unsigned int index;
+    uint32_t in_use;
+
     MURASAKI_ASSERT(nullptr != fmt);  // nullptr check. Perhaps, overkill.
 
-    portDISABLE_INTERRUPTS();  // ARM dependent API. OK to use in task and ISR.
-    {
-#if 0
-            // Test the remains of task stack in byte.
-            // To use the uxTaskGetStackHighWaterMark(), Add following to the
-            // FreeRTOSConfig.h
-            // #define INCLUDE_uxTaskGetStackHighWaterMark 1
-
-            ::snprintf((char *) line_,
-                    sizeof(line_) - 1,
-                    "stack remains : %8d bytes. ",
-                    (int) uxTaskGetStackHighWaterMark(tx_task_));
-            AppendToBuffer();
-#endif
-        ::va_start(argp, fmt);
-        // convert the number with formt string to the line string.
+    // Claim a free line buffer.
+    do {
+        in_use = murasaki::AtomicLoad(&lines_in_use_);
+        for (index = 0; index < PLATFORM_CONFIG_DEBUG_NUM_OF_LINES; index++)
+            if (!(in_use & (1u << index)))
+                break;
+    } while (index < PLATFORM_CONFIG_DEBUG_NUM_OF_LINES
+            && !murasaki::AtomicCompareAndSwap(&lines_in_use_, in_use, in_use | (1u << index)));
+
+    if (index < PLATFORM_CONFIG_DEBUG_NUM_OF_LINES) {
+        // Format with interrupts enabled. Nobody else touches this line buffer.
         // The string length have to be N - 1. Where N is the length of the destination variable.
-        ::vsnprintf((char *) line_, sizeof(line_) - 1, fmt, argp);
+        formatter(lines_[index], PLATFORM_CONFIG_DEBUG_LINE_SIZE - 1, fmt, context);
 
-        ::va_end(argp);
-        // Append the line to the buffer to be sent.
-        helpers_.fifo->Put(reinterpret_cast<uint8_t*>(line_), ::strlen(line_));
+        // Append the line to the buffer to be sent. Lock-free.
+        PutLine(lines_[index], true);
 
+        // Release the line buffer.
+        uint32_t mask = 1u << index;
+        do {
+            in_use = murasaki::AtomicLoad(&lines_in_use_);
+        } while (!murasaki::AtomicCompareAndSwap(&lines_in_use_, in_use, in_use & ~mask));
+    }
+    else {
+        // All line buffers are in use by the nested Printf(). Format in the emergency buffer with interrupts disabled.
+        // Save and restore the mask because this may be called in the interrupt disabled region.
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        unsigned int start = murasaki::GetCycleCounter();
+        {
+            formatter(emergency_line_, sizeof(emergency_line_) - 1, fmt, context);
+            // Never block in the critical section.
+            PutLine(emergency_line_, false);
+        }
+        unsigned int duration = murasaki::GetCycleCounter() - start;
+        if (duration > max_masked_cycles_)
+            max_masked_cycles_ = duration;
+        taskEXIT_CRITICAL_FROM_ISR(saved);
     }
-    portENABLE_INTERRUPTS();
 
     // Notify to the consumer task, the new data has come.
     helpers_.fifo->NotifyData();
 
 }
 
+void Debugger::PutLine(const char *line, bool can_block)
+                       {
+    unsigned int size = ::strlen(line);
+    unsigned int position;
+
+    // Store entire line or nothing, by the overflow policy.
+    if (helpers_.fifo->ReserveMessage(size, &position, can_block)) {
+        helpers_.fifo->Write(position, reinterpret_cast<const uint8_t*>(line), size);
+        helpers_.fifo->Commit();
+    }
+}
+
+void Debugger::SetOverflowPolicy(murasaki::DebuggerOverflowPolicy policy)
+                                 {
+    helpers_.fifo->SetOverflowPolicy(policy);
+}
+
+murasaki::DebuggerOverflowPolicy Debugger::GetOverflowPolicy()
+{
+    return helpers_.fifo->GetOverflowPolicy();
+}
+
+bool Debugger::WaitRoom(unsigned int size)
+                        {
+    return helpers_.fifo->WaitRoom(size, PLATFORM_CONFIG_DEBUG_BLOCK_TIMEOUT);
+}
+
+unsigned int Debugger::GetMaxMaskedCycles()
+{
+    return max_masked_cycles_;
+}
+
+void Debugger::PutDeferredLog(const uint32_t payload[], unsigned int num_of_words)
+                              {
+    MURASAKI_ASSERT(nullptr != payload);
+    MURASAKI_ASSERT(0 < num_of_words && num_of_words <= 255);
+
+    // Start of frame and length.
+    const uint8_t header[2] = { 0, static_cast<uint8_t>(num_of_words) };
+    const unsigned int payload_size = num_of_words * sizeof(uint32_t);
+    unsigned int position;
+
+    // Reserve entire frame or nothing, by the overflow policy. The truncated frame breaks the decoding.
+    // The reservation is lock-free. So, the interrupts are kept enabled.
+    if (helpers_.fifo->ReserveMessage(sizeof(header) + payload_size, &position, true)) {
+        helpers_.fifo->Write(position, header, sizeof(header));
+        helpers_.fifo->Write(position + sizeof(header), reinterpret_cast<const uint8_t*>(payload), payload_size);
+        helpers_.fifo->Commit();
+    }
+
+    // Notify to the consumer task, the new data has come.
+    helpers_.fifo->NotifyData();
+}
+
 char Debugger::GetchFromTask()
 {
     MURASAKI_ASSERT(! murasaki::IsInsideInterrupt());
@@ -185,17 +281,53 @@ static void TxTaskBody(const void* ptr)
     // This struct contains the logger and fifo.
     const murasaki::LoggingHelpers * const helpers = static_cast<const murasaki::LoggingHelpers * const >(ptr);
 
-    // allocate a copy buffer.
-    const int block_size = 100;
-    uint8_t block[block_size];
+    // The drop count which is reported already.
+    unsigned int reported_messages = 0;
+    unsigned int reported_bytes = 0;
+    // The size of the span under output by the logger.
+    unsigned int in_flight = 0;
 
     while (true) {
-        // Copy data from FIFO
-        unsigned int copy_size = helpers->fifo->Get(block, block_size);
-
-        // Then, put it to logger, if data exsit.
-        if (copy_size != 0)
-            helpers->logger->putMessage(reinterpret_cast<char *>(block), copy_size);
+        const uint8_t *span;
+        unsigned int dropped_messages, dropped_bytes;
+
+        // Keep the timebase extension up to date, in case the tick hook is not installed.
+        // The FIFO wait is 1 second at longest.
+        murasaki::GetTimebaseTicks();
+
+        // Obtain the data inside FIFO, without copy.
+        // The logger can take up to 65535 bytes at once.
+        // If a span is under output, obtain the next span after it. In this case, Peek() doesn't wait.
+        unsigned int span_size = std::min(helpers->fifo->Peek(&span, in_flight), 65535u);
+
+        // Finish the previous output, and free its span.
+        if (in_flight != 0) {
+            helpers->logger->WaitMessage();
+            helpers->fifo->Consume(in_flight);
+            in_flight = 0;
+        }
+
+        // If messages were dropped since the last report, tell it directly through the logger.
+        // Only between the messages. Otherwise, the marker cuts a text line or a binary frame.
+        helpers->fifo->GetDropped(&dropped_messages, &dropped_bytes);
+        if (dropped_messages != reported_messages && helpers->fifo->IsAtMessageBoundary()) {
+            char marker[64];
+
+            ::snprintf(marker, sizeof(marker), "\n*** %u messages ( %u bytes ) dropped ***\n",
+                       dropped_messages - reported_messages,
+                       dropped_bytes - reported_bytes);
+            helpers->logger->putMessage(marker, ::strlen(marker));
+            reported_messages = dropped_messages;
+            reported_bytes = dropped_bytes;
+        }
+
+        // Then, start to put the next span to the logger directly from the FIFO, if data exsit.
+        // The span is not overwritten until it is consumed.
+        // The logger outputs it while this task prepares the next span. So, the line is kept busy.
+        if (span_size != 0) {
+            helpers->logger->StartMessage(reinterpret_cast<char *>(const_cast<uint8_t *>(span)), span_size);
+            in_flight = span_size;
+        }
     }
 
 }
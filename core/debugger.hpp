@@ -19,6 +19,7 @@
 #include "murasaki_config.hpp"
 #include "debuggerfifo.hpp"
 #include "simpletask.hpp"
+#include "murasaki_format.hpp"
 
 namespace murasaki {
 
@@ -32,6 +33,7 @@ namespace murasaki {
  * There are several configurable parameters of this class:
  * \li \ref PLATFORM_CONFIG_DEBUG_BUFFER_SIZE
  * \li \ref PLATFORM_CONFIG_DEBUG_LINE_SIZE
+ * \li \ref PLATFORM_CONFIG_DEBUG_NUM_OF_LINES
  * \li \ref PLATFORM_CONFIG_DEBUG_TASK_STACK_SIZE
  * \li \ref PLATFORM_CONFIG_DEBUG_TASK_PRIORITY
  * \li @ref PLATFORM_CONFIG_DEBUG_SERIAL_TIMEOUT
@@ -68,9 +70,86 @@ class Debugger
      *
      * This member function is non-blocking, non-asynchronous, thread safe and re-entrant.
      *
+     * The string is formatted in one of the line buffers with interrupts enabled. Then, copied into
+     * the lock-free FIFO. So, the vsnprintf() doesn't add to the interrupt latency. Only when all line buffers are in use,
+     * the string is formatted in the emergency line buffer with interrupts disabled.
+     * See @ref PLATFORM_CONFIG_DEBUG_NUM_OF_LINES.
+     *
      * At 2018/Jan/14 measurement, 49bytes was used.
+     *
+     * If the @ref MURASAKI_CONFIG_LIGHT_PRINTF is true, this member function is replaced by the
+     * variadic template version, which formats by @ref murasaki::FormatString().
      */
+#if MURASAKI_CONFIG_LIGHT_PRINTF
+    template<typename ... Args>
+    void Printf(const char *fmt, Args ... args)
+                {
+        // One more element to avoid the zero length array.
+        const murasaki::FormatArg arg_list[sizeof...(Args) + 1] = { murasaki::FormatArg(args)... };
+        FormatArgList context = { arg_list, sizeof...(Args) };
+
+        PrintLine(&Debugger::FormatArgsLine, fmt, &context);
+    }
+#else
     void Printf(const char *fmt, ...);
+#endif
+
+    /**
+     * @brief Change the behavior when the internal buffer is full.
+     * @param policy The new policy. The default is @ref PLATFORM_CONFIG_DEBUG_OVERFLOW_POLICY.
+     * @details
+     * The number of the dropped messages is reported in the output as "N messages ( M bytes ) dropped",
+     * when the output resumes.
+     */
+    void SetOverflowPolicy(murasaki::DebuggerOverflowPolicy policy);
+
+    /**
+     * @brief Current policy when the internal buffer is full.
+     * @return The policy.
+     */
+    murasaki::DebuggerOverflowPolicy GetOverflowPolicy();
+
+    /**
+     * @brief Wait for the room in the internal buffer.
+     * @param size Size of the room to wait [byte].
+     * @return true if there is the room. false if timeout.
+     * @details
+     * Wait up to @ref PLATFORM_CONFIG_DEBUG_BLOCK_TIMEOUT. Use to pace a long output from a task, without
+     * changing the overflow policy of the other producers. The room may be taken by the other producers
+     * before the output.
+     *
+     * Never waits in ISR, in the critical section or while the scheduler is suspended. Then, returns
+     * whether there is the room now.
+     */
+    bool WaitRoom(unsigned int size);
+
+    /**
+     * @brief The longest time of the interrupt disabled region in Printf().
+     * @return Duration by @ref GetCycleCounter(). 0 if the emergency line buffer has never been used.
+     */
+    unsigned int GetMaxMaskedCycles();
+
+    /**
+     * @brief Store a deferred log frame.
+     * @param payload Array of the words : format ID, timestamp and arguments.
+     * @param num_of_words Number of the words in payload. Up to 255.
+     * @details
+     * Called from the @ref MURASAKI_DEFERRED_LOG and murasaki::Telemetry. Usually, application doesn't call this member function directly.
+     *
+     * The frame is stored into the internal circular buffer as binary :
+     * @li 0x00 as start of frame. The text message by Printf() never contains 0x00.
+     * @li num_of_words in 1 byte.
+     * @li payload in little endian.
+     *
+     * If the buffer doesn't have enough room, the frame is handled by the overflow policy of SetOverflowPolicy().
+     * The frame is stored or discarded entirely. So, the frame is never truncated.
+     *
+     * This member function is thread safe and re-entrant. Can be called from both task and ISR. It is non-blocking,
+     * except in the @ref kdopBlock policy. In that policy, the caller task waits for the room up to
+     * the @ref PLATFORM_CONFIG_DEBUG_BLOCK_TIMEOUT. The caller in ISR, in a critical section or with the scheduler
+     * suspended never waits.
+     */
+    void PutDeferredLog(const uint32_t payload[], unsigned int num_of_words);
 
     /**
      * \brief Receive one character from serial port.
@@ -115,6 +194,48 @@ class Debugger
     void DoPostMortem();
 
  protected:
+    /**
+     * @brief Formatter of a line.
+     * @param line Line buffer to store the string.
+     * @param size Size of the line buffer [byte].
+     * @param fmt Format string.
+     * @param context Arguments of the format. The type depends on the formatter.
+     */
+    typedef void (*LineFormatter)(char *line, unsigned int size, const char *fmt, void *context);
+
+    /**
+     * @brief Arguments of the FormatArgsLine().
+     */
+    struct FormatArgList
+    {
+        const murasaki::FormatArg *args;
+        unsigned int num_of_args;
+    };
+
+    /**
+     * @brief Format a line by vsnprintf(). The context is a pointer to va_list.
+     */
+    static void VFormatLine(char *line, unsigned int size, const char *fmt, void *context);
+    /**
+     * @brief Format a line by murasaki::FormatString(). The context is a pointer to FormatArgList.
+     */
+    static void FormatArgsLine(char *line, unsigned int size, const char *fmt, void *context);
+
+    /**
+     * @brief Claim a line buffer, format and store it into the FIFO.
+     * @param formatter Formatter of the line.
+     * @param fmt Format string.
+     * @param context Arguments passed to the formatter.
+     */
+    void PrintLine(LineFormatter formatter, const char *fmt, void *context);
+
+    /**
+     * @brief Store a line into the FIFO by the overflow policy.
+     * @param line Null terminated string.
+     * @param can_block false if called in the critical section.
+     */
+    void PutLine(const char *line, bool can_block);
+
     const murasaki::LoggingHelpers helpers_;
     /**
      * \brief Handle to the transmission control task.
@@ -132,7 +253,7 @@ class Debugger
     bool auto_reprint_enable_;
 
     /**
-     * @brief FIFO for the snprintf()
+     * @brief Line buffers for the snprintf()
      * @details
      * This variable can be local variable of the printf() member function.
      * In this case, the implementation of the printf() is much easier.
@@ -140,8 +261,22 @@ class Debugger
      *
      * Probably, having bigger task for each task doesn't pay, and it may cuase stack overflow bug
      * at the debug or assertion. This is not preferable.
+     *
+     * Instead, each Printf() claims one of these buffers by lines_in_use_.
+     */
+    char lines_[PLATFORM_CONFIG_DEBUG_NUM_OF_LINES][PLATFORM_CONFIG_DEBUG_LINE_SIZE];
+    /**
+     * @brief Bit mask of the line buffers in use. "1" means in use.
+     */
+    volatile uint32_t lines_in_use_;
+    /**
+     * @brief Line buffer used with interrupts disabled, when all lines_ are in use.
+     */
+    char emergency_line_[PLATFORM_CONFIG_DEBUG_LINE_SIZE];
+    /**
+     * @brief The longest interrupt disabled duration in Printf().
      */
-    char line_[PLATFORM_CONFIG_DEBUG_LINE_SIZE];
+    volatile unsigned int max_masked_cycles_;
 
     /**
      * @brief Syslog severity threshold
@@ -13,14 +13,28 @@
 #include "murasaki_defs.hpp"
 #include <debuggerfifo.hpp>
 #include "murasaki_assert.hpp"
+#include "murasaki_atomic.hpp"
+#include <algorithm>
 
 namespace murasaki {
 
 DebuggerFifo::DebuggerFifo(unsigned int buffer_size)
-        : FifoStrategy(buffer_size),
-          sync_(new Synchronizer())
+        : LockFreeFifo(buffer_size),
+          sync_(new Synchronizer()),
+          room_sync_(new Synchronizer()),
+          starts_(new uint32_t[(GetCapacity() + 31) / 32]()),
+          policy_(PLATFORM_CONFIG_DEBUG_OVERFLOW_POLICY),
+          in_use_(0),
+          discard_pending_(false),
+          pending_size_(0),
+          dropped_messages_(0),
+          dropped_bytes_(0)
 {
     MURASAKI_ASSERT(sync_ != nullptr);
+    MURASAKI_ASSERT(room_sync_ != nullptr);
+    MURASAKI_ASSERT(starts_ != nullptr);
+    // Each word of the starts_ covers 32 bytes. A message never wraps around inside a word.
+    MURASAKI_ASSERT(GetCapacity() >= 32);
 
     // Clean up buffer.
     // This is essential to outptu clear data when ReWind() is called at very initial stage.
@@ -34,6 +48,10 @@ DebuggerFifo::~DebuggerFifo()
 {
     if (sync_ != nullptr)
         delete sync_;
+    if (room_sync_ != nullptr)
+        delete room_sync_;
+    if (starts_ != nullptr)
+        delete[] starts_;
 }
 
 void DebuggerFifo::NotifyData()
@@ -43,6 +61,184 @@ void DebuggerFifo::NotifyData()
 
 }
 
+unsigned int DebuggerFifo::Put(uint8_t const data[], unsigned int size)
+                               {
+    unsigned int position;
+
+    if (!ReserveMessage(size, &position, true))
+        return 0;
+
+    Write(position, data, size);
+    Commit();
+
+    return size;
+}
+
+bool DebuggerFifo::ReserveMessage(unsigned int size, unsigned int *position, bool can_block)
+                                  {
+    // Usually, there is room.
+    if (Reserve(size, position)) {
+        MarkMessage(*position, size);
+        return true;
+    }
+
+    switch (policy_) {
+        case kdopOverwriteOldest:
+            // Discard the oldest unsent messages, then, retry.
+            if (DiscardOldest(size) && Reserve(size, position)) {
+                MarkMessage(*position, size);
+                return true;
+            }
+            break;
+        case kdopBlock:
+            // Wait only in the task context, while the scheduler is running and not suspended,
+            // and the interrupts are not masked.
+            if (can_block && CanBlock()) {
+                TickType_t start = ::xTaskGetTickCount();
+                TickType_t timeout = pdMS_TO_TICKS(PLATFORM_CONFIG_DEBUG_BLOCK_TIMEOUT);
+
+                // The consumer releases the room_sync_ at each Consume(). Check the room again and again.
+                while (::xTaskGetTickCount() - start < timeout) {
+                    room_sync_->Wait(PLATFORM_CONFIG_DEBUG_BLOCK_TIMEOUT);
+                    if (Reserve(size, position)) {
+                        MarkMessage(*position, size);
+                        return true;
+                    }
+                }
+            }
+            break;
+        case kdopDropNewest:
+        default:
+            break;
+    }
+
+    // Discard this message entirely.
+    murasaki::AtomicAdd(&dropped_messages_, 1);
+    murasaki::AtomicAdd(&dropped_bytes_, size);
+    return false;
+}
+
+bool DebuggerFifo::WaitRoom(unsigned int size, unsigned int timeout_ms)
+                            {
+    if (!CanBlock())
+        return GetAvailable() >= size;
+
+    TickType_t start = ::xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(timeout_ms);
+
+    // The consumer releases the room_sync_ at each Consume().
+    while (GetAvailable() < size) {
+        if (::xTaskGetTickCount() - start >= timeout)
+            return false;
+        room_sync_->Wait(timeout_ms);
+    }
+    return true;
+}
+
+bool DebuggerFifo::CanBlock()
+{
+    return !murasaki::IsInsideInterrupt() && !murasaki::IsInterruptMasked()
+            && ::xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+}
+
+void DebuggerFifo::MarkMessage(uint32_t position, unsigned int size)
+                               {
+    const unsigned int index_mask = GetCapacity() - 1;
+    unsigned int offset = 0;
+
+    // Set the bit of the first byte, and clear the bits of the rest. They may be left by the old messages.
+    // The region is reserved by this producer. But the other producers may update the other bits of the same word.
+    while (offset < size) {
+        unsigned int index = (position + offset) & index_mask;
+        unsigned int bit = index % 32;
+        unsigned int width = std::min(32 - bit, size - offset);
+        uint32_t range = ((width == 32) ? 0xFFFFFFFFu : ((1u << width) - 1)) << bit;
+        uint32_t start = (offset == 0) ? (1u << bit) : 0;
+        uint32_t value;
+
+        do {
+            value = murasaki::AtomicLoad(&starts_[index / 32]);
+        } while (!murasaki::AtomicCompareAndSwap(&starts_[index / 32], value, (value & ~range) | start));
+
+        offset += width;
+    }
+}
+
+bool DebuggerFifo::IsMessageStart(uint32_t position)
+                                  {
+    unsigned int index = position & (GetCapacity() - 1);
+
+    return (starts_[index / 32] >> (index % 32)) & 1;
+}
+
+bool DebuggerFifo::IsReadAtBoundary()
+{
+    // The committed position is always at the end of a message.
+    return GetReadable() == 0 || IsMessageStart(GetReadPosition());
+}
+
+unsigned int DebuggerFifo::NextMessage(uint32_t read, unsigned int offset, unsigned int limit)
+                                       {
+    const unsigned int index_mask = GetCapacity() - 1;
+
+    for (offset++; offset < limit; offset++) {
+        unsigned int index = (read + offset) & index_mask;
+        uint32_t bits = starts_[index / 32] >> (index % 32);
+
+        if (bits & 1)
+            return offset;
+        // No message starts in the rest of this word.
+        if (bits == 0)
+            offset += 31 - index % 32;
+    }
+    return limit;
+}
+
+bool DebuggerFifo::DiscardMessages(unsigned int size)
+                                   {
+    unsigned int shortage = size - std::min(size, GetAvailable());
+    unsigned int readable = GetReadable();
+    unsigned int length = 0;
+    unsigned int messages = 0;
+
+    if (shortage == 0)
+        return true;
+
+    // Discard the messages from the oldest, until the shortage is covered.
+    while (length < shortage && length < readable) {
+        length = NextMessage(GetReadPosition(), length, readable);
+        messages++;
+    }
+
+    Discard(length);
+    murasaki::AtomicAdd(&dropped_messages_, messages);
+    murasaki::AtomicAdd(&dropped_bytes_, length);
+
+    // The rest may be reserved but not committed by other producers.
+    return GetAvailable() >= size;
+}
+
+bool DebuggerFifo::DiscardOldest(unsigned int size)
+                                 {
+    bool room = false;
+
+    // Short critical section to exclude the consumer and other producers on the overflow path.
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        // The span in use by the consumer, or the oldest message partially sent must not be discarded.
+        if (in_use_ == 0 && IsReadAtBoundary())
+            room = DiscardMessages(size);
+        else {
+            // Discard the unsent messages after them, at the Consume().
+            discard_pending_ = true;
+            pending_size_ = std::max(static_cast<unsigned int>(pending_size_), size);
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    return room;
+}
+
 unsigned int DebuggerFifo::Get(uint8_t data[], unsigned int size)
                                {
     unsigned int ret_val;
@@ -50,11 +246,13 @@ unsigned int DebuggerFifo::Get(uint8_t data[], unsigned int size)
     if (!post_mortem_) {  // if normal condition
         MURASAKI_ASSERT(! murasaki::IsInsideInterrupt())
 
-        taskENTER_CRITICAL();
+        // Exclude the producer discarding the oldest data.
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
         {
             ret_val = inherited::Get(data, size);
         }
-        taskEXIT_CRITICAL();
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+        room_sync_->Release();
 
         // wait for the arriaval of the data.
         if (ret_val == 0)
@@ -68,13 +266,96 @@ unsigned int DebuggerFifo::Get(uint8_t data[], unsigned int size)
 
 }
 
+unsigned int DebuggerFifo::Peek(uint8_t const **data, unsigned int offset)
+                                {
+    unsigned int ret_val;
+
+    if (!post_mortem_) {  // if normal condition
+        MURASAKI_ASSERT(! murasaki::IsInsideInterrupt())
+
+        // Mark the span in use. The producer doesn't discard it.
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        {
+            // If the discard is pending, don't hand out the new span. Let the spans in use drain, then discard.
+            if (offset != 0 && discard_pending_)
+                ret_val = 0;
+            else
+                ret_val = inherited::Peek(data, offset);
+            in_use_ = offset + ret_val;
+        }
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+
+        // wait for the arriaval of the data, only when no span is in use.
+        if (ret_val == 0 && offset == 0)
+            sync_->Wait(1000);
+    }
+    else
+        // if undefined exception happend, no sync processing
+        ret_val = inherited::Peek(data, offset);
+
+    return ret_val;
+}
+
+void DebuggerFifo::Consume(unsigned int size)
+                            {
+    if (!post_mortem_) {  // if normal condition
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        {
+            inherited::Consume(size);
+            in_use_ -= std::min(size, static_cast<unsigned int>(in_use_));
+
+            // Discard the unsent messages, as requested during the span was in use.
+            // Wait for the message partially sent to be sent entirely.
+            if (discard_pending_ && in_use_ == 0 && IsReadAtBoundary()) {
+                DiscardMessages(pending_size_);
+                discard_pending_ = false;
+                pending_size_ = 0;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+
+        // Wake the blocking producer.
+        room_sync_->Release();
+    }
+    else
+        // if undefined exception happend, no sync processing
+        inherited::Consume(size);
+}
+
+void DebuggerFifo::SetOverflowPolicy(murasaki::DebuggerOverflowPolicy policy)
+                                     {
+    policy_ = policy;
+}
+
+murasaki::DebuggerOverflowPolicy DebuggerFifo::GetOverflowPolicy()
+{
+    return policy_;
+}
+
+void DebuggerFifo::GetDropped(unsigned int *messages, unsigned int *bytes)
+                              {
+    MURASAKI_ASSERT(nullptr != messages);
+    MURASAKI_ASSERT(nullptr != bytes);
+
+    *messages = murasaki::AtomicLoad(&dropped_messages_);
+    *bytes = murasaki::AtomicLoad(&dropped_bytes_);
+}
+
+bool DebuggerFifo::IsAtMessageBoundary()
+{
+    bool boundary;
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    boundary = IsReadAtBoundary();
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    return boundary;
+}
+
 void DebuggerFifo::ReWind()
 {
-    portDISABLE_INTERRUPTS();
-    {
-        inherited::ReWind();
-    }
-    portENABLE_INTERRUPTS();
+    // Moving the read position is atomic. No need to lock.
+    inherited::ReWind();
 }
 
 void DebuggerFifo::SetPostMortem() {
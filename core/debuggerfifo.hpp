@@ -9,9 +9,10 @@
 #ifndef DEBUGGERFIFO_HPP_
 #define DEBUGGERFIFO_HPP_
 
-#include <fifostrategy.hpp>
+#include <lockfreefifo.hpp>
 #include <loggerstrategy.hpp>
 #include "synchronizer.hpp"
+#include "murasaki_defs.hpp"
 
 namespace murasaki {
 
@@ -21,15 +22,18 @@ namespace murasaki {
  * Non blocking , thread safe FIFO
  *
  * The Put member function returns with "copied" data count.
- * If the internal buffer is full, it returns without copy data.
- * This is thread safe and ISR/Task bi-modal.
+ * If the internal buffer is full, it behaves as the overflow policy. The message is never truncated.
+ * The start of each message is recorded. So, the kdopOverwriteOldest policy discards the oldest messages entirely.
+ * See @ref PLATFORM_CONFIG_DEBUG_OVERFLOW_POLICY.
+ * This is thread safe and ISR/Task bi-modal. The Put() is lock-free unless the buffer is full.
+ * So, it doesn't disable the interrupts. See @ref LockFreeFifo.
  *
  * The Get member function returns with "copied" data count and data.
  * If the internal buffer is empty, it returns without copied data.
  *
  * @ingroup MURASAKI_HELPER_GROUP
  */
-class DebuggerFifo : public FifoStrategy
+class DebuggerFifo : public LockFreeFifo
 {
  public:
     /**
@@ -48,6 +52,35 @@ class DebuggerFifo : public FifoStrategy
      * @brief Notyify new data is in the buffer, to the receiver task.
      */
     virtual void NotifyData();
+    /**
+     * @brief Put a message into the internal buffer.
+     * @param data Message to be copied to the internal buffer
+     * @param size Size of the message [byte]
+     * @return size if stored. 0 if discarded.
+     * @details
+     * The message is stored entirely, or discarded entirely, by the overflow policy.
+     * The blocking policy waits only in the task context.
+     */
+    virtual unsigned int Put(uint8_t const data[], unsigned int size);
+    /**
+     * @brief Reserve a region for a message, by the overflow policy.
+     * @param size Size of the message [byte].
+     * @param position Returns the position of the region. See LockFreeFifo::Write().
+     * @param can_block If false, the kdopBlock policy doesn't wait. Set false in the critical section.
+     * @return true if reserved. Then, LockFreeFifo::Commit() must be called. false if discarded.
+     * @details
+     * If the message is discarded, it is counted as dropped.
+     */
+    bool ReserveMessage(unsigned int size, unsigned int *position, bool can_block);
+    /**
+     * @brief Wait for the room in the internal buffer.
+     * @param size Size of the room [byte].
+     * @param timeout_ms Timeout [mS].
+     * @return true if there is the room. false if timeout.
+     * @details
+     * Doesn't wait if the caller can't block. Then, returns whether there is the room now.
+     */
+    bool WaitRoom(unsigned int size, unsigned int timeout_ms);
     /**
      * @brief Get the data from the internal buffer. This is thread safe function. Do not call from ISR.
      * @param data Data buffer to receive from the internal buffer
@@ -56,9 +89,55 @@ class DebuggerFifo : public FifoStrategy
      */
     virtual unsigned int Get(uint8_t data[], unsigned int size);
     /**
-     * @brief Mark all the data inside the internal buffer as "not sent". Thread safe.
+     * @brief Obtain the data in the internal buffer without copy. This is thread safe function. Do not call from ISR.
+     * @param data Returns the pointer to the data inside the internal buffer.
+     * @param offset Skip this size from the oldest data [byte]. Usually, the size of the span in use.
+     * @return The size of the contiguous data [byte]. 0, if the internal buffer is empty
+     * @details
+     * If the internal buffer is empty and the offset is 0, wait for the data for a while. Then, return 0.
+     * If the offset is not 0, return immediately. So, the caller can obtain the next span during
+     * the current span is in use.
+     *
+     * The data is kept until Consume() is called.
+     */
+    virtual unsigned int Peek(uint8_t const **data, unsigned int offset = 0);
+    /**
+     * @brief Free the data obtained by Peek(). This is thread safe function. Do not call from ISR.
+     * @param size The size to free [byte].
+     * @details
+     * If the kdopOverwriteOldest policy requested to discard the data during the span is in use,
+     * the unsent data is discarded here.
+     */
+    virtual void Consume(unsigned int size);
+    /**
+     * @brief Mark all the data inside the internal buffer as "not sent". Call from task.
      */
     virtual void ReWind();
+    /**
+     * @brief Change the overflow policy.
+     * @param policy The new policy. The default is @ref PLATFORM_CONFIG_DEBUG_OVERFLOW_POLICY.
+     */
+    void SetOverflowPolicy(murasaki::DebuggerOverflowPolicy policy);
+    /**
+     * @brief Obtain the overflow policy.
+     * @return The current policy.
+     */
+    murasaki::DebuggerOverflowPolicy GetOverflowPolicy();
+    /**
+     * @brief Obtain the accumulated count of the dropped data.
+     * @param messages Returns the number of the dropped messages. Including the old messages discarded by the
+     * kdopOverwriteOldest policy.
+     * @param bytes Returns the number of the dropped bytes.
+     */
+    void GetDropped(unsigned int *messages, unsigned int *bytes);
+    /**
+     * @brief Check whether the oldest unsent data starts a message.
+     * @return true if the data obtained by Peek() with offset 0 starts a message, or there is no data.
+     * @details
+     * The consumer can insert its own message into the output only at this boundary. Otherwise, it cuts
+     * a text line or a binary frame.
+     */
+    bool IsAtMessageBoundary();
     /**
      * @brief Transit to the post mortem mode.
      * @details
@@ -69,10 +148,37 @@ class DebuggerFifo : public FifoStrategy
     virtual void SetPostMortem();
      private:
     // Alias to call the parent member function.
-    typedef FifoStrategy inherited;
+    typedef LockFreeFifo inherited;
+    // Try to make room by discarding the oldest messages. Return true if there is enough room.
+    bool DiscardOldest(unsigned int size);
+    // Discard the oldest messages entirely to make the room of size. Call in the critical section, at the boundary.
+    bool DiscardMessages(unsigned int size);
+    // True if the producer can wait for the room.
+    bool CanBlock();
+    // Record the start of a reserved message.
+    void MarkMessage(uint32_t position, unsigned int size);
+    // True if a message starts at the position.
+    bool IsMessageStart(uint32_t position);
+    // True if the oldest unsent data starts a message. Call in the critical section.
+    bool IsReadAtBoundary();
+    // Offset of the next message start after the offset from the read position. limit if not found.
+    unsigned int NextMessage(uint32_t read, unsigned int offset, unsigned int limit);
     // For the communication between generator / consumer.
     Synchronizer *const sync_;
+    // For the blocking producer to wait for the room.
+    Synchronizer *const room_sync_;
+    // Bit map of the message start. A bit per byte of the buffer. The overwrite policy discards the whole messages.
+    volatile uint32_t *const starts_;
     bool post_mortem_;
+    volatile murasaki::DebuggerOverflowPolicy policy_;
+    // Size of the data in use by the consumer, from the oldest. The spans obtained by Peek() and not consumed yet.
+    volatile unsigned int in_use_;
+    // True if the producer requests to discard the unsent data after the span.
+    volatile bool discard_pending_;
+    // Room requested by the pending discard [byte].
+    volatile unsigned int pending_size_;
+    volatile uint32_t dropped_messages_;
+    volatile uint32_t dropped_bytes_;
 };
 
 /**
@@ -18,10 +18,10 @@ namespace murasaki {
 DebuggerUart::DebuggerUart(UART_HandleTypeDef *const uart)
         :
         peripheral_(uart),
-        tx_sync_(new murasaki::Synchronizer),
-        rx_sync_(new murasaki::Synchronizer),
-        tx_critical_section_(new murasaki::CriticalSection),
-        rx_critical_section_(new murasaki::CriticalSection)
+        tx_sync_(new murasaki::PeripheralSynchronizer),
+        rx_sync_(new murasaki::PeripheralSynchronizer),
+        tx_critical_section_(new murasaki::PeripheralCriticalSection),
+        rx_critical_section_(new murasaki::PeripheralCriticalSection)
 {
     // Setup internal variable with given uart structure.
 
@@ -84,25 +84,41 @@ murasaki::UartStatus DebuggerUart::Transmit(
                                             unsigned int size,
                                             unsigned int timeout_ms)
                                             {
+    TransmitStart(data, size);
+
+    return TransmitWait(timeout_ms);  // always return OK in this class.
+}
+
+murasaki::UartStatus DebuggerUart::TransmitStart(
+                                                 const uint8_t *data,
+                                                 unsigned int size)
+                                                 {
     MURASAKI_ASSERT(nullptr != data)
     MURASAKI_ASSERT(65536 >= size);
 
     // make this methold re-entrant in task context.
+    // Leave at the TransmitWait().
     tx_critical_section_->Enter();
-    {
-        // Keep coherency between the L2 and cache before DMA
-        // No need to invalidate
-        murasaki::CleanDataCacheByAddress(
-                                          const_cast<uint8_t*>(data),
-                                          size);
-
-        HAL_StatusTypeDef status = HAL_UART_Transmit_DMA(peripheral_,
-                                                         const_cast<uint8_t*>(data),
-                                                         size);
-        MURASAKI_ASSERT(HAL_OK == status);
 
-        tx_sync_->Wait(timeout_ms);
-    }
+    // Keep coherency between the L2 and cache before DMA
+    // No need to invalidate
+    murasaki::CleanDataCacheByAddress(
+                                      const_cast<uint8_t*>(data),
+                                      size);
+
+    HAL_StatusTypeDef status = HAL_UART_Transmit_DMA(peripheral_,
+                                                     const_cast<uint8_t*>(data),
+                                                     size);
+    MURASAKI_ASSERT(HAL_OK == status);
+
+    return murasaki::kursOK;
+}
+
+murasaki::UartStatus DebuggerUart::TransmitWait(unsigned int timeout_ms)
+                                                {
+    tx_sync_->Wait(timeout_ms);
+
+    // Entered at the TransmitStart().
     tx_critical_section_->Leave();
 
     return murasaki::kursOK;  // always return OK in this class.
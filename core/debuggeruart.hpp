@@ -9,7 +9,7 @@
 #ifndef DEBUGGER_UART_HPP_
 #define DEBUGGER_UART_HPP_
 
-#include <synchronizer.hpp>
+#include <notificationsynchronizer.hpp>
 #include <uartstrategy.hpp>
 #include "criticalsection.hpp"
 
@@ -103,6 +103,29 @@ class DebuggerUart : public UartStrategy
                                           const uint8_t *data,
                                           unsigned int size,
                                           unsigned int timeout_ms);
+    /**
+     * \brief Start to transmit raw data through an UART by DMA.
+     * \param data Data buffer to be transmitted. Must be kept until TransmitWait() returns.
+     * \param size The count of the data ( byte ) to be transfered. Must be smaller than 65536
+     * \return Always murasaki::kursOK.
+     * \details
+     * Start the DMA and return immediately. The calling task must call TransmitWait() to finish the transmission.
+     * The mutex is kept locked from this member function until the TransmitWait(). So, the other tasks
+     * can't interrupt the transmission.
+     *
+     * This function is forbiddedn to call from ISR.
+     */
+    virtual murasaki::UartStatus TransmitStart(
+                                               const uint8_t *data,
+                                               unsigned int size);
+    /**
+     * \brief Wait for the end of the transmission started by TransmitStart().
+     * \param timeout_ms Time out limit by milliseconds.
+     * \return Always returns OK
+     * \details
+     * This function is forbiddedn to call from ISR.
+     */
+    virtual murasaki::UartStatus TransmitWait(unsigned int timeout_ms);
     /**
      * \brief Receive raw data through an UART by synchronous mode.
      * \param data Data buffer to place the received data..
@@ -174,11 +197,11 @@ class DebuggerUart : public UartStrategy
      protected:
     UART_HandleTypeDef *const peripheral_;
 
-    Synchronizer *const tx_sync_;
-    Synchronizer *const rx_sync_;
+    PeripheralSynchronizer *const tx_sync_;
+    PeripheralSynchronizer *const rx_sync_;
 
-    CriticalSection *const tx_critical_section_;
-    CriticalSection *const rx_critical_section_;
+    PeripheralCriticalSection *const tx_critical_section_;
+    PeripheralCriticalSection *const rx_critical_section_;
      private:
     /**
      * @brief Return the Platform dependent device control handle.
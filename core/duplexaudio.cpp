@@ -9,12 +9,14 @@
 #include <cstdint>
 
 #include "duplexaudio.hpp"
+#include "audioconversion.hpp"
 #include "murasaki_assert.hpp"
 #include "murasaki_syslog.hpp"
 #include "callbackrepositorysingleton.hpp"
 
 // Macro for easy-to-read
-#define AUDIO_SYSLOG(fmt, ...)    MURASAKI_SYSLOG(this, kfaAudio, kseDebug, fmt, ##__VA_ARGS__)
+// The debug messages are in the path of every audio block. Each call site is limited to 10 messages/S.
+#define AUDIO_SYSLOG(fmt, ...)    MURASAKI_SYSLOG_RATE_LIMITED(this, kfaAudio, kseDebug, 10, 10, fmt, ##__VA_ARGS__)
 
 namespace murasaki {
 
@@ -36,10 +38,17 @@ DuplexAudio::DuplexAudio(
         rx_dma_buffer_(new uint8_t[buffer_size_rx_]),
         // Initialize for the first execusion
         current_dma_phase_(0),
+        // The first DMA phase is 0. So, the previous one is the last phase.
+        last_dma_phase_(peripheral_adapter_->GetNumberOfDMAPhase() - 1),
         // Set it true to trigger the first DMA transfer.
         first_transfer_(true),
         // Create an sync object between interrupt and TransmitAndReceive member function.
-        sync_(new murasaki::Synchronizer())
+        sync_(new murasaki::PeripheralSynchronizer()),
+        recovery_pending_(false),
+        recovering_(false),
+        outage_start_(0),
+        statistics_ { 0, 0, 0, 0, 0, 0, 0 },
+        num_of_taps_(0)
 {
 
     AUDIO_SYSLOG("Enter.  channel_length : %d ",
@@ -118,27 +127,71 @@ void DuplexAudio::TransmitAndReceive(
     MURASAKI_ASSERT(peripheral_adapter_->GetNumberOfChannelsTx() == tx_num_of_channels)
     MURASAKI_ASSERT(peripheral_adapter_->GetNumberOfChannelsRx() == rx_num_of_channels)
 
-    if (first_transfer_) { /* Is first time transfer? Then, trigger the DMA */
-        AUDIO_SYSLOG("Starting Transfer");
+    // Loop until a valid block is received. Usually, only once.
+    // If the error is reported or DMA is stalled, restart the transfer and wait again.
+    while (true) {
+        if (recovery_pending_)
+            Recover();
 
-        // Actual DMA transfer is done by the peripheral_adapter_
-        peripheral_adapter_->StartTransferTx(tx_dma_buffer_, channel_len_);
-        peripheral_adapter_->StartTransferRx(rx_dma_buffer_, channel_len_);
+        if (first_transfer_) { /* Is first time transfer? Then, trigger the DMA */
+            AUDIO_SYSLOG("Starting Transfer");
 
-        // Mark it to avoid the second kick.
-        first_transfer_ = false;
+            // Actual DMA transfer is done by the peripheral_adapter_
+            // Start TX and RX without interruption to keep them in lockstep.
+            taskENTER_CRITICAL();
+            peripheral_adapter_->StartTransferTx(tx_dma_buffer_, channel_len_);
+            peripheral_adapter_->StartTransferRx(rx_dma_buffer_, channel_len_);
+            taskEXIT_CRITICAL();
+
+            // Mark it to avoid the second kick.
+            first_transfer_ = false;
+        }
+
+        // Waiting for the completion of DMA transfer.
+        // The sync_ is released in the DmaCallback() and HandleError()
+        AUDIO_SYSLOG("Sync waiting");
+        bool released = sync_->Wait(PLATFORM_CONFIG_AUDIO_DMA_TIMEOUT);
+        AUDIO_SYSLOG("Sync released");
+
+        if (!released) {
+            // No DMA interrupt. Assume the transfer is stalled.
+            MURASAKI_SYSLOG(this, kfaAudio, kseError, "DMA time out")
+            statistics_.timeouts++;
+            if (!recovery_pending_) {
+                outage_start_ = ::xTaskGetTickCount();
+                recovery_pending_ = true;
+            }
+        }
+
+        if (!recovery_pending_)
+            break;
     }
 
-    // Waiting for the completion of DMA transfer.
-    // The sync_ is released in the DmaCallback()
-    AUDIO_SYSLOG("Sync waiting");
-    sync_->Wait();
-    AUDIO_SYSLOG("Sync released");
+    // Is this the first block after the restart? Then, record the outage.
+    if (recovering_) {
+        unsigned int outage_ms = (::xTaskGetTickCount() - outage_start_) * portTICK_PERIOD_MS;
+
+        statistics_.last_outage_ms = outage_ms;
+        statistics_.total_outage_ms += outage_ms;
+        if (statistics_.max_outage_ms < outage_ms)
+            statistics_.max_outage_ms = outage_ms;
+        recovering_ = false;
+
+        MURASAKI_SYSLOG(this, kfaAudio, kseWarning, "Transfer restarted. Outage : %u mS", outage_ms)
+    }
 
     // Check whether DMA phase is OK.
     // current_dma_phase_ is updated in the DmaCallback()
     MURASAKI_ASSERT(current_dma_phase_ < peripheral_adapter_->GetNumberOfDMAPhase())
 
+    // If the phase is not the next of the last one, some DMA phases were missed.
+    bool xrun = (current_dma_phase_ != (last_dma_phase_ + 1) % peripheral_adapter_->GetNumberOfDMAPhase());
+    last_dma_phase_ = current_dma_phase_;
+    if (xrun) {
+        statistics_.xruns++;
+        MURASAKI_SYSLOG(this, kfaAudio, kseWarning, "DMA phase is skipped")
+    }
+
     // Processing is depend on the word size. So, get the Word size.
     // Note that we check only the TX word size. We assume the word TX and RX are identical, in the duplex audio.
     switch (peripheral_adapter_->GetSampleWordSizeRx()) {
@@ -206,11 +259,6 @@ void DuplexAudio::TransmitAndReceive(
             int32_t *const tx_current_dma_data = reinterpret_cast<int32_t*>(&tx_dma_buffer_[current_dma_phase_ * block_size_tx_]);
             int32_t *const rx_current_dma_data = reinterpret_cast<int32_t*>(&rx_dma_buffer_[current_dma_phase_ * block_size_rx_]);
 
-            // Scale factor to convert between integer type on the DMA and normalized floating point data
-            // Too keep the absolute maximum number as 1.0, using the _MIN value.
-            //  | INT32_MAX | +1 = | INT32_MIN |
-            const float scale = -1.0 * INT32_MIN;
-
             // If the data size is 24bit ( 3byte ), the RX data have to be shifted 8 bit left
             // The TX have to be shifted 8 bit right.
             unsigned int shift = peripheral_adapter_->GetSampleShiftSizeRx();
@@ -248,20 +296,14 @@ void DuplexAudio::TransmitAndReceive(
 
             // copy from RX DMA buffer.
             // The data order in the rx_channels and rx_current_dma_data follows tx.
-            for (unsigned int ch_idx = 0; ch_idx < rx_num_of_channels; ch_idx++)
-                for (unsigned int wo_idx = 0; wo_idx < channel_len_; wo_idx++)
-                    rx_channels[ch_idx][wo_idx] =
-                            (rx_current_dma_data[wo_idx * rx_num_of_channels + ch_idx] << shift) / scale;
+            murasaki::UnpackInt32ToFloat(rx_current_dma_data, rx_channels, rx_num_of_channels, channel_len_, shift);
 
             // copy to TX DMA buffer.
             // The tx_current dma_data is the raw buffer to the audio device.
-            // In this buffer, the data order is ch0-word0, ch0-word1, ch1-word0, so on.
+            // In this buffer, the data order is ch0-word0, ch1-word0,... ch0-word1, so on.
             // The tx=channels are given as parameter from caller.
             // This is array of pointers. Each pointers in array point the word buffers.
-            for (unsigned int ch_idx = 0; ch_idx < tx_num_of_channels; ch_idx++)
-                for (unsigned int wo_idx = 0; wo_idx < channel_len_; wo_idx++)
-                    tx_current_dma_data[wo_idx * tx_num_of_channels + ch_idx] =
-                            static_cast<int32_t>(fminf(tx_channels[ch_idx][wo_idx] * scale, INT32_MAX)) >> shift;
+            murasaki::PackFloatToInt32(tx_channels, tx_current_dma_data, tx_num_of_channels, channel_len_, shift);
 
             // Is half word swap required by the port hardware?
             // If yes, swap the all data in TX DMA buffer
@@ -286,12 +328,54 @@ void DuplexAudio::TransmitAndReceive(
 
             break;
         }
+        case 3: {
+            AUDIO_SYSLOG("Case:Word size is 3");
+
+            // Obtain the start address of the DMA buffer to transfer
+            // The data is packed 24bit. So, handle as byte array.
+            uint8_t *const tx_current_dma_data = &tx_dma_buffer_[current_dma_phase_ * block_size_tx_];
+            uint8_t *const rx_current_dma_data = &rx_dma_buffer_[current_dma_phase_ * block_size_rx_];
+
+            AUDIO_SYSLOG("block_size_tx_ : %d", block_size_tx_);
+            AUDIO_SYSLOG("block_size_rx_ : %d", block_size_rx_);
+
+            AUDIO_SYSLOG("TX DMA BUFFER is %08p", tx_current_dma_data)
+            AUDIO_SYSLOG("RX DMA BUFFER is %08p", rx_current_dma_data)
+
+            // Invalidate the DMA RX data buffer on cache. Then, ready to read.
+            murasaki::CleanAndInvalidateDataCacheByAddress(rx_current_dma_data, block_size_rx_);
+
+            // Unpack the 3 byte little endian words from RX DMA buffer.
+            murasaki::UnpackInt24ToFloat(rx_current_dma_data,
+                                         rx_channels,
+                                         rx_num_of_channels,
+                                         channel_len_,
+                                         peripheral_adapter_->GetSampleShiftSizeRx());
+
+            // Pack the 3 byte little endian words into TX DMA buffer.
+            murasaki::PackFloatToInt24(tx_channels,
+                                       tx_current_dma_data,
+                                       tx_num_of_channels,
+                                       channel_len_,
+                                       peripheral_adapter_->GetSampleShiftSizeTx());
+
+            // Flush the DMA TX data buffer on cache to main memory.
+            murasaki::CleanDataCacheByAddress(tx_current_dma_data, block_size_tx_);
+
+            break;
+        }
         default:
             MURASAKI_SYSLOG(this, kfaAudio, kseError, "Unknown word size")
             MURASAKI_ASSERT(false)
             ;
     }
 
+    // Pass the raw DMA blocks to the observers.
+    for (unsigned int i = 0; i < num_of_taps_; i++)
+        taps_[i]->Tap(&tx_dma_buffer_[current_dma_phase_ * block_size_tx_],
+                      &rx_dma_buffer_[current_dma_phase_ * block_size_rx_],
+                      xrun);
+
     AUDIO_SYSLOG("Return");
 }
 
@@ -339,6 +423,19 @@ bool DuplexAudio::HandleError(void *peripheral)
     // Call the HandleError of the audio port.
     bool retval = peripheral_adapter_->HandleError(peripheral);
 
+    if (retval) {
+        statistics_.errors++;
+
+        // Request the restart. TX and RX may report the error at once. Record only the first one.
+        if (!recovery_pending_) {
+            outage_start_ = murasaki::IsInsideInterrupt() ? ::xTaskGetTickCountFromISR() : ::xTaskGetTickCount();
+            recovery_pending_ = true;
+        }
+
+        // Wake the TransmitAndReceive() to restart the transfer.
+        sync_->Release();
+    }
+
     AUDIO_SYSLOG(
                  "Return with %s",
                  (retval ? "true" : "false"));
@@ -346,6 +443,68 @@ bool DuplexAudio::HandleError(void *peripheral)
     return retval;
 }
 
+void DuplexAudio::AddTap(murasaki::AudioTapStrategy *tap)
+                         {
+    AUDIO_SYSLOG("Enter, tap : %p", tap);
+
+    MURASAKI_ASSERT(nullptr != tap)
+    MURASAKI_ASSERT(num_of_taps_ < NUM_OF_AUDIO_TAPS)
+
+    murasaki::AudioTapFormat tx_format = {
+            block_size_tx_,
+            peripheral_adapter_->GetNumberOfChannelsTx(),
+            peripheral_adapter_->GetSampleWordSizeTx(),
+            peripheral_adapter_->GetSampleShiftSizeTx() };
+    murasaki::AudioTapFormat rx_format = {
+            block_size_rx_,
+            peripheral_adapter_->GetNumberOfChannelsRx(),
+            peripheral_adapter_->GetSampleWordSizeRx(),
+            peripheral_adapter_->GetSampleShiftSizeRx() };
+
+    // Let the tap know the format, then register.
+    tap->Attach(tx_format, rx_format);
+    taps_[num_of_taps_++] = tap;
+
+    AUDIO_SYSLOG("Return");
+}
+
+void DuplexAudio::GetStatistics(murasaki::AudioStatistics *statistics)
+                                {
+    MURASAKI_ASSERT(nullptr != statistics)
+
+    *statistics = statistics_;
+}
+
+void DuplexAudio::Recover()
+{
+    MURASAKI_SYSLOG(this, kfaAudio, kseWarning, "Restarting transfer")
+
+    // Stop both DMA.
+    peripheral_adapter_->StopTransferTx();
+    peripheral_adapter_->StopTransferRx();
+
+    // Re-prime the buffers with silence.
+    for (unsigned int i = 0; i < buffer_size_tx_; i++)
+        tx_dma_buffer_[i] = 0;
+    for (unsigned int i = 0; i < buffer_size_rx_; i++)
+        rx_dma_buffer_[i] = 0;
+    murasaki::CleanDataCacheByAddress(tx_dma_buffer_, buffer_size_tx_);
+    murasaki::CleanAndInvalidateDataCacheByAddress(rx_dma_buffer_, buffer_size_rx_);
+
+    // Reset the phase as the first transfer.
+    current_dma_phase_ = 0;
+    last_dma_phase_ = peripheral_adapter_->GetNumberOfDMAPhase() - 1;
+
+    // Discard the release by the error or the last DMA interrupt.
+    sync_->Wait(0);
+
+    // DMA is stopped. So, no interrupt can modify it.
+    recovery_pending_ = false;
+    first_transfer_ = true;
+    recovering_ = true;
+    statistics_.recoveries++;
+}
+
 bool DuplexAudio::Match(void *peripheral_handle) {
     AUDIO_SYSLOG("Enter, peripheral : %p", peripheral_handle);
 
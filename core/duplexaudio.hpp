@@ -9,12 +9,31 @@
 #ifndef DUPLEXAUDIO_HPP_
 #define DUPLEXAUDIO_HPP_
 
-#include "synchronizer.hpp"
+#include "murasaki_config.hpp"
+#include "notificationsynchronizer.hpp"
 #include "audioportadapterstrategy.hpp"
+#include "audiotapstrategy.hpp"
 #include "peripheralstrategy.hpp"
 
 namespace murasaki {
 
+/**
+ * @brief Statistics of the @ref DuplexAudio.
+ * @ingroup MURASAKI_DEFINITION_GROUP
+ * @details
+ * The outage is the duration from the error detection to the first block after the restart.
+ */
+struct AudioStatistics
+{
+    unsigned int errors;            ///< Number of the error reported by the audio port.
+    unsigned int timeouts;          ///< Number of the DMA interrupt time out.
+    unsigned int recoveries;        ///< Number of the restart of the transfer.
+    unsigned int xruns;             ///< Number of the skipped DMA phase detection.
+    unsigned int last_outage_ms;    ///< Duration of the last outage [mS].
+    unsigned int max_outage_ms;     ///< Duration of the longest outage [mS].
+    unsigned int total_outage_ms;   ///< Total duration of the outage [mS].
+};
+
 /**
  * @ingroup MURASAKI_GROUP
  * @brief Stereo Audio is served by this class.
@@ -249,7 +268,15 @@ class DuplexAudio : public PeripheralStrategy {
      * @return True if the peripheral matches with own peripheral which was given by constructor. Otherwise false.
      * @details
      * This function calls the @ref AudioPortAdapterStrategy::HandleError() which knows how to handle.
-     * Usually, this error call back is unable to recover. So, assertion may be triggered.
+     * If the error is reported by the audio port, the transfer is restarted in the TransmitAndReceive().
+     * To restart, both TX and RX DMA are stopped and filled by silence. Then, both are restarted together.
+     * The TransmitAndReceive() returns after receiving the first block of the restarted transfer.
+     *
+     * The stall of the DMA is detected by the time out @ref PLATFORM_CONFIG_AUDIO_DMA_TIMEOUT, and
+     * recovered in the same way.
+     *
+     * The number of the errors and the outage duration are recorded in the statistics.
+     * See @ref GetStatistics().
      *
      * This member function have to be called from the error call back of SAI/I2S HAL
      *
@@ -267,6 +294,13 @@ class DuplexAudio : public PeripheralStrategy {
      * @endcode
      */
     virtual bool HandleError(void *peripheral);
+
+    /**
+     * @brief Obtain the statistics.
+     * @param statistics Pointer to the struct to receive the copy of the statistics.
+     */
+    void GetStatistics(murasaki::AudioStatistics *statistics);
+
     /**
      * @details Check if audio port peripheral handle matched with given handle.
      * @param peripheral_handle
@@ -274,6 +308,18 @@ class DuplexAudio : public PeripheralStrategy {
      */
     virtual bool Match(void *peripheral_handle);
 
+    /**
+     * @brief Register an observer of the DMA blocks.
+     * @param tap Pointer to the observer.
+     * @details
+     * The registered tap receives the raw TX and RX DMA blocks at every TransmitAndReceive().
+     * The tap is called in the context of the TransmitAndReceive(). So, the tap must not block.
+     *
+     * Up to @ref NUM_OF_AUDIO_TAPS taps can be registered. Call this member function before
+     * the first TransmitAndReceive().
+     */
+    void AddTap(murasaki::AudioTapStrategy *tap);
+
  protected:
     /**
      * @brief Dummy member function.
@@ -284,6 +330,13 @@ class DuplexAudio : public PeripheralStrategy {
     virtual void* GetPeripheralHandle();
 
  private:
+    /**
+     * @brief Stop the transfer and prepare to restart.
+     * @details
+     * Stop both DMA, fill the buffers by silence and reset the phase.
+     * The transfer is restarted as the first transfer.
+     */
+    void Recover();
 
     murasaki::AudioPortAdapterStrategy *const peripheral_adapter_;
     /**
@@ -328,6 +381,13 @@ class DuplexAudio : public PeripheralStrategy {
      * 0, 1, 2 for triple buffer.
      */
     unsigned int current_dma_phase_;
+    /**
+     * @brief Phase number of the DMA buffer phase which was processed last time.
+     * @details
+     * Used to detect the xrun. If the current phase is not the next of this phase,
+     * some DMA blocks were missed.
+     */
+    unsigned int last_dma_phase_;
     /**
      * @brief flat to kick start the transfer.
      */
@@ -335,7 +395,7 @@ class DuplexAudio : public PeripheralStrategy {
     /**
      * @brief Synchronization between DMA interrupt and audio transfer.
      */
-    murasaki::Synchronizer *const sync_;
+    murasaki::PeripheralSynchronizer *const sync_;
 
     /**
      * @brief Scratch pad for the Stereo usage.
@@ -346,6 +406,32 @@ class DuplexAudio : public PeripheralStrategy {
      */
     float *rx_stereo_[2];
 
+    /**
+     * @brief Set by the error. The transfer have to be restarted.
+     */
+    volatile bool recovery_pending_;
+    /**
+     * @brief True between the restart and the first block.
+     */
+    bool recovering_;
+    /**
+     * @brief Tick count when the outage started.
+     */
+    volatile TickType_t outage_start_;
+    /**
+     * @brief Statistics of the transfer.
+     */
+    murasaki::AudioStatistics statistics_;
+
+    /**
+     * @brief Registered taps.
+     */
+    murasaki::AudioTapStrategy *taps_[NUM_OF_AUDIO_TAPS];
+    /**
+     * @brief Number of the registered taps.
+     */
+    unsigned int num_of_taps_;
+
 };
 
 } /* namespace murasaki */
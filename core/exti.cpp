@@ -213,6 +213,17 @@ murasaki::InterruptStatus Exti::Wait(unsigned int timeout)
     return ret_val;
 }
 
+void Exti::AttachWaitSet(murasaki::WaitSet *wait_set, uint32_t bits)
+                         {
+    EXTI_SYSLOG("Enter")
+
+    sync_->AttachWaitSet(wait_set, bits);
+    // The task is ready to handle the interrupt through the wait set.
+    ready_ = true;
+
+    EXTI_SYSLOG("Exit.")
+}
+
 bool Exti::Release(unsigned int line)
                    {
     EXTI_SYSLOG("Enter")
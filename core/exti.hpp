@@ -10,6 +10,7 @@
 
 #include "interruptstrategy.hpp"
 #include "synchronizer.hpp"
+#include "waitset.hpp"
 
 #ifdef HAL_EXTI_MODULE_ENABLED
 
@@ -100,6 +101,16 @@ class Exti : public InterruptStrategy {
      */
     virtual murasaki::InterruptStatus Wait(unsigned int timeout = murasaki::kwmsIndefinitely);
 
+    /**
+     * @brief Signal a murasaki::WaitSet at every interrupt.
+     * @param wait_set The WaitSet to signal. nullptr to detach.
+     * @param bits Bits to signal.
+     * @details
+     * Wait for the WaitSet, instead of the Wait(). Then, take the interrupt by Wait(0) without blocking.
+     * This member function turns the interrupt ready, as same as the Wait().
+     */
+    virtual void AttachWaitSet(murasaki::WaitSet *wait_set, uint32_t bits);
+
     /**
      * @details Release the waiting task
      * @param line Interrupt line bit map given from the HAL_GPIO_EXTI_Callback()
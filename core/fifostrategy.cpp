@@ -32,36 +32,20 @@ FifoStrategy::~FifoStrategy()
 
 unsigned int FifoStrategy::Put(uint8_t const data[], unsigned int size)
 {
-    unsigned int avairable;
-
-    // check the avairable area size. Data is append to the head
-    if (head_ > tail_)  // there is no wrap around
-        avairable = size_of_buffer_ - (head_ - tail_);
-    else if (tail_ > head_)
-        avairable = tail_ - head_;
-    else
-        avairable = size_of_buffer_;
-
-    // If we fill up buffer entirely, we can not distinguish full and empty from the
-    // comparing tail_ and head_.
-    // This can be fixed if we add new variable "length", but it get complex.
-    // To save this problem, we clip the vacant size by buffsersize-1.
-    if (avairable > 0)
-        avairable--;
-
     // clip the line size by available room in the buffer.
-    unsigned int copy_size = std::min(size, avairable);
+    unsigned int copy_size = std::min(size, FifoStrategy::GetAvailable());
 
     // Now, we can copy from line to buffer.
-    for (unsigned int i = 0; i < copy_size; i++) {
-        // newest data is appended to the point of head_
-        buffer_[head_] = data[i];
-        head_++;
+    // newest data is appended to the point of head_. Copy until the end of buffer, then, wrap around.
+    unsigned int first = std::min(copy_size, size_of_buffer_ - head_);
+
+    ::memcpy(&buffer_[head_], data, first);
+    ::memcpy(&buffer_[0], &data[first], copy_size - first);
 
-        // wrap around the head index;
-        if (head_ >= size_of_buffer_)
-            head_ -= size_of_buffer_;
-    }  // end for loop.
+    head_ += copy_size;
+    // wrap around the head index;
+    if (head_ >= size_of_buffer_)
+        head_ -= size_of_buffer_;
 
     return copy_size;
 
@@ -98,6 +82,59 @@ unsigned int FifoStrategy::Get(uint8_t data[], unsigned int size)
     return copy_size;
 }
 
+unsigned int FifoStrategy::GetAvailable()
+{
+    unsigned int avairable;
+
+    // check the avairable area size. Data is append to the head
+    if (head_ > tail_)  // there is no wrap around
+        avairable = size_of_buffer_ - (head_ - tail_);
+    else if (tail_ > head_)
+        avairable = tail_ - head_;
+    else
+        avairable = size_of_buffer_;
+
+    // If we fill up buffer entirely, we can not distinguish full and empty from the
+    // comparing tail_ and head_.
+    // This can be fixed if we add new variable "length", but it get complex.
+    // To save this problem, we clip the vacant size by buffsersize-1.
+    if (avairable > 0)
+        avairable--;
+
+    return avairable;
+}
+
+unsigned int FifoStrategy::Peek(uint8_t const **data, unsigned int offset)
+                                {
+    MURASAKI_ASSERT(nullptr != data);
+
+    unsigned int stored = (head_ >= tail_) ? head_ - tail_ : size_of_buffer_ - tail_ + head_;
+    MURASAKI_ASSERT(offset <= stored);
+
+    // Skip the offset.
+    unsigned int position = tail_ + offset;
+    if (position >= size_of_buffer_)
+        position -= size_of_buffer_;
+
+    *data = &buffer_[position];
+
+    if (head_ >= position)
+        return head_ - position;
+    else
+        // position > head_
+        return size_of_buffer_ - position;    // stop once, at the end of buffer.
+}
+
+void FifoStrategy::Consume(unsigned int size)
+                           {
+    // update tail.
+    tail_ += size;
+
+    // if tail_ reaches the end, wrap around.
+    if (tail_ >= size_of_buffer_)
+        tail_ -= size_of_buffer_;
+}
+
 void FifoStrategy::ReWind()
 {
     // by setting tail as head+1, the entire buffer is marked as "not sent"
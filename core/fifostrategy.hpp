@@ -56,6 +56,30 @@ class FifoStrategy
      * @return The count of copied data. 0, if the internal buffer is empty
      */
     virtual unsigned int Get(uint8_t data[], unsigned int size);
+    /**
+     * @brief Room of the internal buffer.
+     * @return The count of data which can be put without discard [byte].
+     */
+    virtual unsigned int GetAvailable();
+    /**
+     * @brief Obtain the oldest data in the internal buffer, without copy.
+     * @param data Returns the pointer to the data inside the internal buffer.
+     * @param offset Skip this size from the oldest data [byte]. Must be smaller than or equal to the stored data.
+     * @return The size of the contiguous data [byte]. 0, if the internal buffer is empty
+     * @details
+     * The returned span stops at the end of the internal buffer. The rest is returned by the next Peek().
+     * The span is kept until the Consume() is called. Then, the caller can read it directly. For example,
+     * by DMA.
+     *
+     * By giving the size of the span in use as offset, the caller can obtain the next span before consuming
+     * the current one. For example, to prepare the next DMA during the current DMA.
+     */
+    virtual unsigned int Peek(uint8_t const **data, unsigned int offset = 0);
+    /**
+     * @brief Remove the data from the internal buffer.
+     * @param size The size to remove [byte]. Must be smaller than or equal to the value returned by Peek().
+     */
+    virtual void Consume(unsigned int size);
     /*
      * @brief Mark all the data inside the internal buffer as "not sent".
      */
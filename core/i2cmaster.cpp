@@ -21,8 +21,8 @@ namespace murasaki {
 I2cMaster::I2cMaster(I2C_HandleTypeDef *i2c_handle)
         :
         peripheral_(i2c_handle),
-        sync_(new Synchronizer),
-        critical_section_(new CriticalSection),
+        sync_(new PeripheralSynchronizer),
+        critical_section_(new PeripheralCriticalSection),
         interrupt_status_(ki2csUnknown)
 
 {
@@ -10,7 +10,7 @@
 #define I2CMASTER_HPP_
 
 #include <i2cmasterstrategy.hpp>
-#include <synchronizer.hpp>
+#include <notificationsynchronizer.hpp>
 #include "criticalsection.hpp"
 
 // Check whether I2C module is enabled by CubeIDE.
@@ -249,8 +249,8 @@ class I2cMaster : public I2cMasterStrategy
 
  protected:
     I2C_HandleTypeDef *const peripheral_;  // SPI peripheral handle
-    Synchronizer *const sync_;  // sync between task and interrupt
-    CriticalSection *const critical_section_;  // protect memberfunction
+    PeripheralSynchronizer *const sync_;  // sync between task and interrupt
+    PeripheralCriticalSection *const critical_section_;  // protect memberfunction
     volatile I2cStatus interrupt_status_;  // status variable from interrupt
 };
 
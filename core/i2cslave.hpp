@@ -11,7 +11,7 @@
 #define I2CSLAVE_HPP_
 
 #include <i2cslavestrategy.hpp>
-#include <synchronizer.hpp>
+#include <notificationsynchronizer.hpp>
 #include "criticalsection.hpp"
 
 // Check whether I2C module is enabled by CubeIDE.
@@ -185,8 +185,8 @@ class I2cSlave : public I2cSlaveStrategy {
     virtual void* GetPeripheralHandle();
      protected:
     I2C_HandleTypeDef *const peripheral_;  // SPI peripheral handle
-    Synchronizer *const sync_;  // sync between task and interrupt
-    CriticalSection *const critical_section_;  // protect member function
+    PeripheralSynchronizer *const sync_;  // sync between task and interrupt
+    PeripheralCriticalSection *const critical_section_;  // protect member function
     volatile I2cStatus interrupt_status_;  // status variable from interrupt
 };
 
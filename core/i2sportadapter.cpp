@@ -81,25 +81,24 @@ bool I2sPortAdapter::HandleError(void *ptr) {
     // Is this interrupt for this peripheral?
     if (this->Match(ptr)) {
         I2SAUDIO_SYSLOG("Pointer matched")
-        uint32_t error_code = rx_peripheral_->ErrorCode;
+        uint32_t error_code = reinterpret_cast<I2S_HandleTypeDef*>(ptr)->ErrorCode;
         // Check error and display it.
-        if (HAL_I2S_ERROR_OVR | error_code) {
+        if (HAL_I2S_ERROR_OVR & error_code) {
             MURASAKI_SYSLOG(this, kfaI2s, kseError, "HAL_I2S_ERROR_OVR")
         }
-        if (HAL_I2S_ERROR_UDR | error_code) {
+        if (HAL_I2S_ERROR_UDR & error_code) {
             MURASAKI_SYSLOG(this, kfaI2s, kseError, "HAL_I2S_ERROR_UDR")
         }
-        if (HAL_I2S_ERROR_PRESCALER | error_code) {
+        if (HAL_I2S_ERROR_PRESCALER & error_code) {
             MURASAKI_SYSLOG(this, kfaI2s, kseError, "HAL_I2S_ERROR_PRESCALER")
         }
-        if (HAL_I2S_ERROR_TIMEOUT | error_code) {
+        if (HAL_I2S_ERROR_TIMEOUT & error_code) {
             MURASAKI_SYSLOG(this, kfaI2s, kseError, "HAL_I2S_ERROR_TIMEOUT")
         }
-        if (HAL_I2S_ERROR_DMA | error_code) {
+        if (HAL_I2S_ERROR_DMA & error_code) {
             MURASAKI_SYSLOG(this, kfaI2s, kseError, "HAL_I2S_ERROR_DMA")
         }
-        // This is fatal condition.
-        MURASAKI_ASSERT(false)
+        // The recovery is done by the DuplexAudio. Just report the match.
         return true;
     }
     else {
@@ -216,6 +215,30 @@ void I2sPortAdapter::StartTransferRx(
     I2SAUDIO_SYSLOG("Return")
 }
 
+void I2sPortAdapter::StopTransferTx()
+{
+    I2SAUDIO_SYSLOG("Enter.")
+
+    MURASAKI_ASSERT(nullptr != tx_peripheral_)
+
+    // Stop both DMA and I2S. The error flags are cleared by the next start.
+    HAL_I2S_DMAStop(tx_peripheral_);
+
+    I2SAUDIO_SYSLOG("Return")
+}
+
+void I2sPortAdapter::StopTransferRx()
+{
+    I2SAUDIO_SYSLOG("Enter.")
+
+    MURASAKI_ASSERT(nullptr != rx_peripheral_)
+
+    // Stop both DMA and I2S. The error flags are cleared by the next start.
+    HAL_I2S_DMAStop(rx_peripheral_);
+
+    I2SAUDIO_SYSLOG("Return")
+}
+
 unsigned int I2sPortAdapter::GetSampleWordSizeRx()
 {
     I2SAUDIO_SYSLOG("Enter.")
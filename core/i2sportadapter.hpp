@@ -104,6 +104,20 @@ class I2sPortAdapter : public AudioPortAdapterStrategy {
                                  uint8_t *rx_buffer,
                                  unsigned int channel_len
                                  );
+
+    /**
+     * @brief Stop the TX DMA transfer.
+     * @details
+     * Stop the I2S peripheral and its DMA. Called by the DuplexAudio to recover from the error.
+     */
+    virtual void StopTransferTx();
+
+    /**
+     * @brief Stop the RX DMA transfer.
+     * @details
+     * Stop the I2S peripheral and its DMA. Called by the DuplexAudio to recover from the error.
+     */
+    virtual void StopTransferRx();
     /**
      * @brief Return how many DMA phase is implemented
      * @return Always return 2 for STM32 I2S, because the cyclic DMA has halfway and complete interrupt.
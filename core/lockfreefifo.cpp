@@ -0,0 +1,206 @@
+/*
+ * lockfreefifo.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <lockfreefifo.hpp>
+#include <murasaki_assert.hpp>
+#include <murasaki_atomic.hpp>
+#include <algorithm>
+#include <string.h>
+
+// The position is counted in 24bit, and wraps around.
+#define POSITION_MASK 0x00FFFFFFu
+// The number of the in-flight reservations is stored in the upper 8bit.
+#define INFLIGHT_SHIFT 24
+#define INFLIGHT_ONE (1u << INFLIGHT_SHIFT)
+
+namespace murasaki {
+
+// Largest power of 2 which is smaller than or equal to the size.
+static unsigned int FloorPowerOf2(unsigned int size)
+                                  {
+    unsigned int capacity = 1;
+
+    while (capacity <= size / 2)
+        capacity *= 2;
+    return capacity;
+}
+
+LockFreeFifo::LockFreeFifo(unsigned int buffer_size)
+        : FifoStrategy(buffer_size),
+          capacity_(FloorPowerOf2(buffer_size)),
+          reserve_(0),
+          committed_(0),
+          read_(0)
+{
+    // The distance between the positions must be distinguished in 24bit.
+    MURASAKI_ASSERT(capacity_ <= (POSITION_MASK + 1) / 4);
+}
+
+LockFreeFifo::~LockFreeFifo()
+{
+}
+
+unsigned int LockFreeFifo::DoReserve(unsigned int size, bool partial, unsigned int *position)
+                                     {
+    while (true) {
+        uint32_t reserve = murasaki::AtomicLoad(&reserve_);
+        uint32_t head = reserve & POSITION_MASK;
+        uint32_t used = (head - murasaki::AtomicLoad(&read_)) & POSITION_MASK;
+        // The used area may exceed the capacity after ReWind().
+        unsigned int available = (used < capacity_) ? capacity_ - used : 0;
+        unsigned int reserved = partial ? std::min(size, available) : size;
+
+        if (reserved == 0 || reserved > available)
+            return 0;
+        // Too many producers in flight.
+        if ((reserve >> INFLIGHT_SHIFT) == (0xFFFFFFFFu >> INFLIGHT_SHIFT))
+            return 0;
+
+        // Advance the head and count up the in-flight at once.
+        uint32_t desired = (reserve & ~POSITION_MASK) + INFLIGHT_ONE + ((head + reserved) & POSITION_MASK);
+        if (murasaki::AtomicCompareAndSwap(&reserve_, reserve, desired)) {
+            *position = head;
+            return reserved;
+        }
+        // Other producer reserved in between. Try again.
+    }
+}
+
+bool LockFreeFifo::Reserve(unsigned int size, unsigned int *position)
+                           {
+    MURASAKI_ASSERT(nullptr != position);
+
+    return DoReserve(size, false, position) != 0;
+}
+
+void LockFreeFifo::Write(unsigned int position, uint8_t const data[], unsigned int size)
+                         {
+    unsigned int index = position & (capacity_ - 1);
+    unsigned int first = std::min(size, capacity_ - index);
+
+    // Copy until the end of buffer, then, wrap around.
+    ::memcpy(&buffer_[index], data, first);
+    ::memcpy(&buffer_[0], &data[first], size - first);
+}
+
+void LockFreeFifo::Commit()
+{
+    uint32_t reserve;
+    uint32_t desired;
+
+    // Count down the in-flight.
+    do {
+        reserve = murasaki::AtomicLoad(&reserve_);
+        MURASAKI_ASSERT((reserve >> INFLIGHT_SHIFT) != 0);
+        desired = reserve - INFLIGHT_ONE;
+    } while (!murasaki::AtomicCompareAndSwap(&reserve_, reserve, desired));
+
+    // If other producers are in flight, the last one publishes.
+    if ((desired >> INFLIGHT_SHIFT) != 0)
+        return;
+
+    // All regions before the head are committed. Publish the head.
+    // The committed position only goes forward. Other producer may have published newer head already.
+    uint32_t head = desired & POSITION_MASK;
+    while (true) {
+        uint32_t committed = murasaki::AtomicLoad(&committed_);
+        uint32_t distance = (head - committed) & POSITION_MASK;
+
+        if (distance == 0 || distance > POSITION_MASK / 2)
+            break;
+        if (murasaki::AtomicCompareAndSwap(&committed_, committed, head))
+            break;
+    }
+}
+
+unsigned int LockFreeFifo::Put(uint8_t const data[], unsigned int size)
+                               {
+    unsigned int position;
+    unsigned int copy_size = DoReserve(size, true, &position);
+
+    if (copy_size != 0) {
+        Write(position, data, copy_size);
+        Commit();
+    }
+
+    return copy_size;
+}
+
+unsigned int LockFreeFifo::Get(uint8_t data[], unsigned int size)
+                               {
+    uint8_t const *span;
+    unsigned int copy_size = std::min(size, LockFreeFifo::Peek(&span));
+
+    ::memcpy(data, span, copy_size);
+    LockFreeFifo::Consume(copy_size);
+
+    return copy_size;
+}
+
+unsigned int LockFreeFifo::Peek(uint8_t const **data, unsigned int offset)
+                                {
+    MURASAKI_ASSERT(nullptr != data);
+
+    uint32_t read = (murasaki::AtomicLoad(&read_) + offset) & POSITION_MASK;
+    unsigned int readable = (murasaki::AtomicLoad(&committed_) - read) & POSITION_MASK;
+    unsigned int index = read & (capacity_ - 1);
+
+    // The offset must be inside the committed data.
+    MURASAKI_ASSERT(readable <= capacity_);
+
+    *data = &buffer_[index];
+
+    // Stop once at the end of buffer.
+    return std::min(readable, capacity_ - index);
+}
+
+void LockFreeFifo::Consume(unsigned int size)
+                           {
+    // Free the region after the reading.
+    murasaki::AtomicStore(&read_, (murasaki::AtomicLoad(&read_) + size) & POSITION_MASK);
+}
+
+unsigned int LockFreeFifo::GetAvailable()
+{
+    uint32_t head = murasaki::AtomicLoad(&reserve_) & POSITION_MASK;
+    uint32_t used = (head - murasaki::AtomicLoad(&read_)) & POSITION_MASK;
+
+    return (used < capacity_) ? capacity_ - used : 0;
+}
+
+unsigned int LockFreeFifo::Discard(unsigned int size)
+                                   {
+    uint32_t read = murasaki::AtomicLoad(&read_);
+    unsigned int discarded = std::min(size, (murasaki::AtomicLoad(&committed_) - read) & POSITION_MASK);
+
+    murasaki::AtomicStore(&read_, (read + discarded) & POSITION_MASK);
+
+    return discarded;
+}
+
+unsigned int LockFreeFifo::GetCapacity()
+{
+    return capacity_;
+}
+
+uint32_t LockFreeFifo::GetReadPosition()
+{
+    return murasaki::AtomicLoad(&read_);
+}
+
+unsigned int LockFreeFifo::GetReadable()
+{
+    return (murasaki::AtomicLoad(&committed_) - murasaki::AtomicLoad(&read_)) & POSITION_MASK;
+}
+
+void LockFreeFifo::ReWind()
+{
+    // By setting the read position as one buffer before, the entire buffer is marked as "not sent".
+    murasaki::AtomicStore(&read_, (murasaki::AtomicLoad(&committed_) - capacity_) & POSITION_MASK);
+}
+
+} /* namespace murasaki */
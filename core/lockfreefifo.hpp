@@ -0,0 +1,187 @@
+/**
+ * @file lockfreefifo.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Lock-free multi-producer single-consumer FIFO.
+ */
+
+#ifndef LOCKFREEFIFO_HPP_
+#define LOCKFREEFIFO_HPP_
+
+#include <fifostrategy.hpp>
+
+namespace murasaki {
+
+/**
+ * @brief Lock-free multi-producer single-consumer FIFO.
+ * @details
+ * The producers put data by reserve / commit. The reservation is done by the compare and swap.
+ * So, the producers never disable the interrupts ( except the Cortex-M0 class CPU, where the
+ * compare and swap itself is done in a few instructions of the critical section ).
+ * Then, the producer can be any task or ISR at any priority.
+ *
+ * @li @ref Reserve() allocates a region in the buffer atomically.
+ * @li @ref Write() copies the data into the reserved region. This can be done with interrupts enabled.
+ * @li @ref Commit() makes the reserved region visible to the consumer.
+ *
+ * Because the regions are reserved in the order, the consumer can read the data only when
+ * all reservations before are committed. The consumer sees the region after the last producer
+ * in the flight commits.
+ *
+ * The reservation word packs the write position ( 24bit ) and the number of the in-flight
+ * reservations ( 8bit ). So, up to 255 producers can reserve at once.
+ *
+ * Only one task can call Get().
+ *
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+class LockFreeFifo : public FifoStrategy
+{
+ public:
+    LockFreeFifo() = delete;
+    /**
+     * @brief Create an internal buffer
+     * @param buffer_size Size of the internal buffer to be allocated [byte]
+     * @details
+     * Only the power of 2 part of the buffer_size is used. For example, 4096 for the buffer_size 5000.
+     * The buffer_size must be smaller than or equal to 4M byte.
+     */
+    LockFreeFifo(unsigned int buffer_size);
+    /**
+     * @brief Delete an internal buffer
+     */
+    virtual ~LockFreeFifo();
+    /**
+     * @brief Put the data into the internal buffer.
+     * @param data Data to be copied to the internal buffer
+     * @param size Data count to be copied
+     * @return The count of copied data. 0, if the internal buffer is full.
+     * @details
+     * Reserve, write and commit at once. If there is not enough room, the data is truncated.
+     * Can be called from both task and ISR.
+     */
+    virtual unsigned int Put(uint8_t const data[], unsigned int size);
+    /**
+     * @brief Get the data from the internal buffer.
+     * @param data Data buffer to receive from the internal buffer
+     * @param size Size of the data parameter.
+     * @return The count of copied data. 0, if the internal buffer is empty
+     * @details
+     * Only the committed data is read. Only one task can call this member function.
+     */
+    virtual unsigned int Get(uint8_t data[], unsigned int size);
+    /**
+     * @brief Room of the internal buffer.
+     * @return The count of data which can be reserved now [byte].
+     * @details
+     * The value is just a snapshot. Other producer may reserve after this call.
+     */
+    virtual unsigned int GetAvailable();
+    /**
+     * @brief Obtain the oldest committed data in the internal buffer, without copy.
+     * @param data Returns the pointer to the data inside the internal buffer.
+     * @param offset Skip this size from the oldest data [byte]. Must be smaller than or equal to the committed data.
+     * @return The size of the contiguous data [byte]. 0, if the internal buffer is empty
+     * @details
+     * The producers don't overwrite the span until Consume() is called. Only one task can call this member function.
+     */
+    virtual unsigned int Peek(uint8_t const **data, unsigned int offset = 0);
+    /**
+     * @brief Free the data in the internal buffer.
+     * @param size The size to free [byte]. Must be smaller than or equal to the value returned by Peek().
+     */
+    virtual void Consume(unsigned int size);
+    /**
+     * @brief Mark all the data inside the internal buffer as "not sent".
+     * @details
+     * Call from the consumer side. The region which is reserved but not committed yet may be
+     * re-sent with the old contents.
+     */
+    virtual void ReWind();
+    /**
+     * @brief Reserve a region in the internal buffer.
+     * @param size Size of the region [byte].
+     * @param position Returns the position of the region. Pass it to the Write().
+     * @return true if reserved. false if there is not enough room.
+     * @details
+     * The entire size is reserved or nothing. If this member function returns true,
+     * Commit() must be called. Otherwise, the consumer can't read any data after this region.
+     *
+     * Can be called from both task and ISR.
+     */
+    bool Reserve(unsigned int size, unsigned int *position);
+    /**
+     * @brief Copy the data into the reserved region.
+     * @param position The position returned by Reserve().
+     * @param data Data to be copied.
+     * @param size Data count to be copied.
+     * @details
+     * The region may wrap around at the end of the buffer. This member function handles it.
+     * Can be called several times to the same reservation, by shifting the position.
+     */
+    void Write(unsigned int position, uint8_t const data[], unsigned int size);
+    /**
+     * @brief Commit the reserved region.
+     * @details
+     * Once all the reservations in flight are committed, the consumer can read them.
+     */
+    void Commit();
+
+ protected:
+    /**
+     * @brief Discard the oldest data.
+     * @param size The size to discard [byte].
+     * @return The size discarded actually. Up to the committed data.
+     * @details
+     * This member function moves the read position. Then, the caller must prevent the consumer to
+     * access the FIFO during this call.
+     */
+    unsigned int Discard(unsigned int size);
+    /**
+     * @brief Size of the power of 2 part of the buffer.
+     * @return Capacity [byte]. The index in the buffer is position & ( capacity - 1 ).
+     */
+    unsigned int GetCapacity();
+    /**
+     * @brief Position of the oldest data.
+     * @return The position where the next data will be read.
+     */
+    uint32_t GetReadPosition();
+    /**
+     * @brief Size of the committed data which is not read yet.
+     * @return Size [byte].
+     */
+    unsigned int GetReadable();
+
+ private:
+    /**
+     * @brief Reserve atomically.
+     * @param size Requested size [byte].
+     * @param partial If true, reserve as much as possible. If false, reserve size or nothing.
+     * @param position Returns the position of the region.
+     * @return Reserved size. 0 if nothing is reserved.
+     */
+    unsigned int DoReserve(unsigned int size, bool partial, unsigned int *position);
+
+    /**
+     * @brief Size of the power of 2 part of the buffer [byte].
+     */
+    const unsigned int capacity_;
+    /**
+     * @brief Write position ( lower 24bit ) and number of the in-flight reservations ( upper 8bit ).
+     */
+    volatile uint32_t reserve_;
+    /**
+     * @brief The position until where the consumer can read.
+     */
+    volatile uint32_t committed_;
+    /**
+     * @brief The position of where the next data will be read.
+     */
+    volatile uint32_t read_;
+};
+
+} /* namespace murasaki */
+
+#endif /* LOCKFREEFIFO_HPP_ */
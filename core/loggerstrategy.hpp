@@ -51,6 +51,27 @@ class LoggerStrategy
      * For example, if there is not room in FIFO anymore, this member function will just return without putting data.
      */
     virtual void putMessage(char message[], unsigned int size) = 0;
+    /**
+     * \brief Start the message output.
+     * \param message Non null terminated character array. Must be kept until WaitMessage() returns.
+     * \param size Byte length of the message parameter.
+     * \details
+     * Start to output the message and return without waiting. The WaitMessage() must be called after this
+     * member function by the same task. The caller can prepare the next message during the output.
+     *
+     * By default, this member function calls the putMessage(). The derived class can override it to
+     * overlap the output and the preparation of the next message.
+     */
+    virtual void StartMessage(char message[], unsigned int size)
+                              {
+        putMessage(message, size);
+    }
+    /**
+     * \brief Wait for the end of the output started by StartMessage().
+     */
+    virtual void WaitMessage()
+    {
+    }
     /**
      * \brief Character input member function.
      * \return A character from input is returned.
@@ -0,0 +1,143 @@
+/*
+ * loopbackportadapter.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <string.h>
+
+#include "loopbackportadapter.hpp"
+#include "murasaki_syslog.hpp"
+#include "murasaki_assert.hpp"
+
+// Macro for easy-to-read
+#define LOOPBACK_SYSLOG(fmt, ...)    MURASAKI_SYSLOG( this , kfaAudio, kseDebug, fmt, ##__VA_ARGS__)
+
+namespace murasaki {
+
+LoopbackPortAdapter::LoopbackPortAdapter(
+                                         unsigned int num_of_channels,
+                                         unsigned int word_size,
+                                         unsigned int num_of_phase
+                                         )
+        :
+        num_of_channels_(num_of_channels),
+        word_size_(word_size),
+        num_of_phase_(num_of_phase),
+        tx_buffer_(nullptr),
+        rx_buffer_(nullptr),
+        block_size_(0),
+        phase_(0)
+{
+    MURASAKI_ASSERT(num_of_channels_ > 0)
+    MURASAKI_ASSERT(2 <= word_size_ && word_size_ <= 4)
+    MURASAKI_ASSERT(2 == num_of_phase_ || 3 == num_of_phase_)
+}
+
+LoopbackPortAdapter::~LoopbackPortAdapter()
+{
+}
+
+unsigned int LoopbackPortAdapter::Step()
+                                      {
+    unsigned int transferred_phase = phase_;
+
+    // Copy only when the both buffers are ready.
+    if (tx_buffer_ != nullptr && rx_buffer_ != nullptr)
+        ::memcpy(&rx_buffer_[phase_ * block_size_],
+                 &tx_buffer_[phase_ * block_size_],
+                 block_size_);
+
+    // Advance the phase, as the circular DMA does.
+    phase_ = (phase_ + 1) % num_of_phase_;
+
+    return transferred_phase;
+}
+
+void LoopbackPortAdapter::StartTransferTx(
+                                          uint8_t *tx_buffer,
+                                          unsigned int channel_len)
+                                          {
+    LOOPBACK_SYSLOG("Enter %p, %d", tx_buffer, channel_len)
+
+    MURASAKI_ASSERT(nullptr != tx_buffer)
+
+    tx_buffer_ = tx_buffer;
+    block_size_ = channel_len * num_of_channels_ * word_size_;
+    phase_ = 0;
+
+    LOOPBACK_SYSLOG("Return")
+}
+
+void LoopbackPortAdapter::StartTransferRx(
+                                          uint8_t *rx_buffer,
+                                          unsigned int channel_len)
+                                          {
+    LOOPBACK_SYSLOG("Enter %p, %d", rx_buffer, channel_len)
+
+    MURASAKI_ASSERT(nullptr != rx_buffer)
+
+    rx_buffer_ = rx_buffer;
+    block_size_ = channel_len * num_of_channels_ * word_size_;
+    phase_ = 0;
+
+    LOOPBACK_SYSLOG("Return")
+}
+
+unsigned int LoopbackPortAdapter::GetNumberOfDMAPhase()
+{
+    return num_of_phase_;
+}
+
+unsigned int LoopbackPortAdapter::GetNumberOfChannelsTx()
+{
+    return num_of_channels_;
+}
+
+unsigned int LoopbackPortAdapter::GetSampleShiftSizeTx()
+{
+    return 0;
+}
+
+unsigned int LoopbackPortAdapter::GetSampleWordSizeTx()
+{
+    return word_size_;
+}
+
+unsigned int LoopbackPortAdapter::GetNumberOfChannelsRx()
+{
+    return num_of_channels_;
+}
+
+unsigned int LoopbackPortAdapter::GetSampleShiftSizeRx()
+{
+    return 0;
+}
+
+unsigned int LoopbackPortAdapter::GetSampleWordSizeRx()
+{
+    return word_size_;
+}
+
+bool LoopbackPortAdapter::HandleError(void *ptr)
+                                      {
+    return Match(ptr);
+}
+
+bool LoopbackPortAdapter::Match(void *peripheral_handle)
+                                {
+    return peripheral_handle == this;
+}
+
+void* LoopbackPortAdapter::GetPeripheralHandle()
+{
+    return this;
+}
+
+bool LoopbackPortAdapter::IsInt16SwapRequired()
+{
+    return false;
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,158 @@
+/**
+ * @file loopbackportadapter.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Simulated audio port which loops back TX to RX.
+ */
+
+#ifndef LOOPBACKPORTADAPTER_HPP_
+#define LOOPBACKPORTADAPTER_HPP_
+
+#include <audioportadapterstrategy.hpp>
+
+namespace murasaki {
+
+/**
+ * @brief Simulated audio port adapter for the @ref murasaki::DuplexAudio.
+ * @details
+ * This adapter doesn't touch any peripheral. Instead, it copies the TX DMA buffer to
+ * the RX DMA buffer. So, the @ref DuplexAudio class and the algorithm on it can be
+ * tested without the audio codec.
+ *
+ * There is no DMA. The caller plays the role of DMA by calling @ref Step() periodically.
+ * Step() copies one DMA phase of the TX buffer to the same phase of the RX buffer, and
+ * returns the phase. The returned phase have to be passed to the DuplexAudio::DmaCallback().
+ * The peripheral handle for DmaCallback() is obtained by @ref GetPeripheralHandle().
+ *
+ * @code
+ *     audio_port = new murasaki::LoopbackPortAdapter(2, 4);
+ *     audio = new murasaki::DuplexAudio( audio_port, 48 );
+ *     ...
+ *     // In the timer ISR, or a thread of the host simulator.
+ *     audio->DmaCallback(audio_port->GetPeripheralHandle(), audio_port->Step());
+ * @endcode
+ *
+ * \ingroup MURASAKI_GROUP
+ */
+class LoopbackPortAdapter : public AudioPortAdapterStrategy {
+ public:
+    LoopbackPortAdapter() = delete;
+    /**
+     * @brief Constructor.
+     * @param num_of_channels Number of the channels of both TX and RX.
+     * @param word_size Size of a sample in the DMA buffer. 2, 3 or 4 [Byte]. 3 means packed 24bit.
+     * @param num_of_phase Number of the DMA phases. 2 or 3.
+     */
+    LoopbackPortAdapter(
+                        unsigned int num_of_channels,
+                        unsigned int word_size,
+                        unsigned int num_of_phase = 2
+                        );
+
+    virtual ~LoopbackPortAdapter();
+
+    /**
+     * @brief Simulate one DMA phase.
+     * @return The phase which has been transferred. Pass it to the DuplexAudio::DmaCallback().
+     * @details
+     * Copy the TX DMA buffer of the current phase to the RX DMA buffer of the same phase.
+     * Then, advance the phase.
+     *
+     * Until both StartTransferTx() and StartTransferRx() are called, nothing is copied.
+     */
+    unsigned int Step();
+
+    /**
+     * @brief Record the TX buffer.
+     * @param tx_buffer The TX DMA buffer.
+     * @param channel_len Number of the samples per channel in a DMA phase.
+     */
+    virtual void StartTransferTx(
+                                 uint8_t *tx_buffer,
+                                 unsigned int channel_len
+                                 );
+
+    /**
+     * @brief Record the RX buffer.
+     * @param rx_buffer The RX DMA buffer.
+     * @param channel_len Number of the samples per channel in a DMA phase.
+     */
+    virtual void StartTransferRx(
+                                 uint8_t *rx_buffer,
+                                 unsigned int channel_len
+                                 );
+    /**
+     * @brief Return how many DMA phase is implemented
+     * @return The number of phase given by constructor.
+     */
+    virtual unsigned int GetNumberOfDMAPhase();
+    /**
+     * @brief Return how many channels are in the transfer.
+     * @return The number of channels given by constructor.
+     */
+    virtual unsigned int GetNumberOfChannelsTx();
+    /**
+     * @brief Return the bit count to shift to make the DMA data to right align in TX I2S frame.
+     * @return Always 0.
+     */
+    virtual unsigned int GetSampleShiftSizeTx();
+    /**
+     * @brief Return the size of the one sample on memory for Tx channel
+     * @return The word size given by constructor. The unit is [Byte]
+     */
+    virtual unsigned int GetSampleWordSizeTx();
+    /**
+     * @brief Return how many channels are in the transfer.
+     * @return The number of channels given by constructor.
+     */
+    virtual unsigned int GetNumberOfChannelsRx();
+    /**
+     * @brief Return the bit count to shift to make the DMA data to right align in RX I2S frame.
+     * @return Always 0.
+     */
+    virtual unsigned int GetSampleShiftSizeRx();
+    /**
+     * @brief Return the size of the one sample on memory for Rx channel
+     * @return The word size given by constructor. The unit is [Byte]
+     */
+    virtual unsigned int GetSampleWordSizeRx();
+    /**
+     * @brief Handling error report of device.
+     * @param ptr Pointer to this object.
+     * @return true if ptr matches with this object.
+     * @details
+     * There is no error in the simulated port.
+     */
+    virtual bool HandleError(void *ptr);
+    /**
+     * @brief Check if peripheral handle matched with given handle.
+     * @param peripheral_handle
+     * @return true if peripheral_handle is this object.
+     */
+    virtual bool Match(void *peripheral_handle);
+    /**
+     * @brief pass the raw peripheral handler
+     * @return Pointer to this object. There is no raw peripheral.
+     */
+    virtual void* GetPeripheralHandle();
+    /**
+     * @brief Display half word swap is required. .
+     * @return Always false.
+     */
+    virtual bool IsInt16SwapRequired();
+
+ private:
+    const unsigned int num_of_channels_;
+    const unsigned int word_size_;
+    const unsigned int num_of_phase_;
+    uint8_t *tx_buffer_;
+    uint8_t *rx_buffer_;
+    unsigned int block_size_;
+    unsigned int phase_;
+};
+
+}
+/* namespace murasaki */
+
+#endif /* LOOPBACKPORTADAPTER_HPP_ */
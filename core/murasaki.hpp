@@ -15,6 +15,7 @@
 // Include HAL to refer from submodules of murasaki.
 #include <debugger.hpp>
 #include <fifostrategy.hpp>
+#include <lockfreefifo.hpp>
 #include <taskstrategy.hpp>
 
 // Configurations
@@ -24,8 +25,18 @@
 // Task and Stack
 #include "simpletask.hpp"
 
+// Synchronization
+#include "synchronizer.hpp"
+#include "notificationsynchronizer.hpp"
+#include "criticalsection.hpp"
+#include "waitset.hpp"
+
 // Algorithm
 #include "duplexaudio.hpp"
+#include "audioconversion.hpp"
+#include "audiomeasurement.hpp"
+#include "audiocapture.hpp"
+#include "audiofanout.hpp"
 
 // Peripherals
 #include "uart.hpp"
@@ -39,20 +50,31 @@
 #include "bitout.hpp"
 #include "saiportadapter.hpp"
 #include "i2sportadapter.hpp"
+#include "loopbackportadapter.hpp"
 #include "quadratureencoder.hpp"
 #include "adc.hpp"
 #include "exti.hpp"
 
 // Utilities
 #include "murasaki_utility.hpp"
+#include "murasaki_pool.hpp"
+#include "murasaki_heaptrace.hpp"
+#include "murasaki_taskstats.hpp"
 
 // Third party strategy.
 #include "audiocodecstrategy.hpp"
 
 // Debuggers
 #include "uartlogger.hpp"
+#include "rttlogger.hpp"
 #include "murasaki_assert.hpp"
 #include "murasaki_syslog.hpp"
+#include "murasaki_deferredlog.hpp"
+#include "murasaki_timebase.hpp"
+#include "murasaki_trace.hpp"
+#include "murasaki_format.hpp"
+#include "telemetry.hpp"
+#include "taskmonitor.hpp"
 
 
 // platforms
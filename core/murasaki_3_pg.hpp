@@ -303,6 +303,14 @@
  * @li C++ new / delete operators have to be called after FreeRTOS started.
  * @li C++ new / delete operators have to be called in the task context.
  *
+ * To avoid the heap at all, set the @ref MURASAKI_CONFIG_STATIC_ALLOCATION true. The @ref operator new allocates
+ * from a static arena, and the semaphores and the tasks are created by the static API of FreeRTOS.
+ * The RAM budget is checked by the linker, and the boot is deterministic. In this mode, the @ref operator delete
+ * doesn't free the memory. So, the objects have to be created once at the initialization.
+ *
+ * For the application which allocates and frees at run time, set the @ref MURASAKI_CONFIG_POOL_ALLOCATOR true.
+ * The small objects are allocated from the fixed size blocks in O(1), without fragmentation.
+ *
  */
 
 /**
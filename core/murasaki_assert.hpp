@@ -19,7 +19,7 @@
 
 // Remove directory path from __FILE__
 #ifndef __MURASAKI__FILE__
-#define __MURASAKI__FILE__  (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
+#define __MURASAKI__FILE__  (murasaki::FileBaseName(__FILE__))
 #endif
 
 /**
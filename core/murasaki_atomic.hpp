@@ -0,0 +1,96 @@
+/**
+ * @file murasaki_atomic.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Atomic operations for the lock-free data structures.
+ * @details
+ * On the ARMv7-M and ARMv8-M mainline CPU, the compare and swap is done by LDREX/STREX.
+ * The ARMv6-M CPU ( Cortex-M0, M0+, M1 ) doesn't have these instructions. In this case,
+ * the compare and swap is done inside a very short critical section.
+ */
+
+#ifndef MURASAKI_ATOMIC_HPP_
+#define MURASAKI_ATOMIC_HPP_
+
+#include <stdint.h>
+#include <FreeRTOS.h>
+#include <task.h>
+
+namespace murasaki {
+
+/**
+ * @brief Load the 32bit variable.
+ * @param ptr Pointer to the variable.
+ * @return The value of the variable.
+ * @details
+ * The memory access after this load is not reordered before this load.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+static inline uint32_t AtomicLoad(volatile uint32_t *ptr)
+                                  {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Store the 32bit variable.
+ * @param ptr Pointer to the variable.
+ * @param value The value to store.
+ * @details
+ * The memory access before this store is not reordered after this store.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+static inline void AtomicStore(volatile uint32_t *ptr, uint32_t value)
+                               {
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Compare and swap the 32bit variable.
+ * @param ptr Pointer to the variable.
+ * @param expected The value which the variable is expected to have.
+ * @param desired The new value.
+ * @return true if the variable was expected, and it was replaced by desired. false if not replaced.
+ * @details
+ * This function can be called from both task and ISR.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+static inline bool AtomicCompareAndSwap(volatile uint32_t *ptr, uint32_t expected, uint32_t desired)
+                                        {
+    // Detect by the compiler, not by the CMSIS header. This header may be included before the CMSIS.
+#if defined ( __ARM_ARCH_6M__ ) || defined ( __CORE_CM0_H_GENERIC ) ||defined ( __CORE_CM0PLUS_H_GENERIC ) || defined ( __CORE_CM1_H_GENERIC )
+    // No LDREX/STREX. Mask the interrupt only during the compare and swap.
+    bool swapped = false;
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    if (*ptr == expected) {
+        *ptr = desired;
+        swapped = true;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    return swapped;
+#else
+    // Compiled to the LDREX/STREX loop.
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * @brief Add to the 32bit variable.
+ * @param ptr Pointer to the variable.
+ * @param value The value to add.
+ * @details
+ * This function can be called from both task and ISR.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+static inline void AtomicAdd(volatile uint32_t *ptr, uint32_t value)
+                             {
+    uint32_t current;
+
+    do {
+        current = AtomicLoad(ptr);
+    } while (!AtomicCompareAndSwap(ptr, current, current + value));
+}
+
+} /* namespace murasaki */
+
+#endif /* MURASAKI_ATOMIC_HPP_ */
@@ -0,0 +1,69 @@
+/*
+ * murasaki_audiobenchmark.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include "murasaki.hpp"
+
+void murasaki::AudioConversionBenchmark(
+                                        unsigned int num_of_channels,
+                                        unsigned int channel_len,
+                                        unsigned int iterations)
+                                        {
+    const unsigned int num_of_samples = num_of_channels * channel_len;
+    float **channels = new float*[num_of_channels];
+    int32_t *dma32 = new int32_t[num_of_samples];
+    // Allocate by word to align the packed data.
+    uint32_t *dma24 = new uint32_t[(num_of_samples * 3 + 3) / 4];
+    unsigned int unpack32 = 0, pack32 = 0, unpack24 = 0, pack24 = 0;
+
+    MURASAKI_ASSERT(nullptr != channels)
+    MURASAKI_ASSERT(nullptr != dma32)
+    MURASAKI_ASSERT(nullptr != dma24)
+    MURASAKI_ASSERT(0 < iterations)
+
+    // Fill the channels with a ramp.
+    for (unsigned int ch = 0; ch < num_of_channels; ch++) {
+        channels[ch] = new float[channel_len];
+        MURASAKI_ASSERT(nullptr != channels[ch])
+        for (unsigned int i = 0; i < channel_len; i++)
+            channels[ch][i] = (static_cast<float>(i) / channel_len) * 2.0f - 1.0f;
+    }
+
+    for (unsigned int count = 0; count < iterations; count++) {
+        unsigned int start;
+
+        start = murasaki::GetCycleCounter();
+        murasaki::PackFloatToInt32(channels, dma32, num_of_channels, channel_len, 8);
+        pack32 += murasaki::GetCycleCounter() - start;
+
+        start = murasaki::GetCycleCounter();
+        murasaki::UnpackInt32ToFloat(dma32, channels, num_of_channels, channel_len, 8);
+        unpack32 += murasaki::GetCycleCounter() - start;
+
+        start = murasaki::GetCycleCounter();
+        murasaki::PackFloatToInt24(channels, reinterpret_cast<uint8_t*>(dma24), num_of_channels, channel_len, 0);
+        pack24 += murasaki::GetCycleCounter() - start;
+
+        start = murasaki::GetCycleCounter();
+        murasaki::UnpackInt24ToFloat(reinterpret_cast<uint8_t*>(dma24), channels, num_of_channels, channel_len, 0);
+        unpack24 += murasaki::GetCycleCounter() - start;
+    }
+
+    murasaki::debugger->Printf("\n            Audio conversion benchmark\n");
+    murasaki::debugger->Printf("%d channels x %d samples, average of %d iterations\n", num_of_channels, channel_len, iterations);
+    murasaki::debugger->Printf("Format         | DMA block [Byte] | Pack [cycle] | Unpack [cycle]\n");
+    murasaki::debugger->Printf("---------------+------------------+--------------+---------------\n");
+    murasaki::debugger->Printf("32bit          | %16d | %12d | %13d\n",
+                               num_of_samples * 4, pack32 / iterations, unpack32 / iterations);
+    murasaki::debugger->Printf("Packed 24bit   | %16d | %12d | %13d\n",
+                               num_of_samples * 3, pack24 / iterations, unpack24 / iterations);
+
+    for (unsigned int ch = 0; ch < num_of_channels; ch++)
+        delete[] channels[ch];
+    delete[] channels;
+    delete[] dma32;
+    delete[] dma24;
+}
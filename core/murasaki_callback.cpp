@@ -33,12 +33,16 @@
  */
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
                              {
+    MURASAKI_TRACE_CALLBACK_ENTER(huart);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(huart);
     // Convert it to the appropriate type.
     murasaki::UartStrategy *uart = reinterpret_cast<murasaki::UartStrategy*>(peripheral);
     // Handle the callback by the object.
     uart->TransmitCompleteCallback(huart);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(huart);
 }
 
 /**
@@ -58,12 +62,16 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
  */
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
                              {
+    MURASAKI_TRACE_CALLBACK_ENTER(huart);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(huart);
     // Convert it to the appropriate type.
     murasaki::UartStrategy *uart = reinterpret_cast<murasaki::UartStrategy*>(peripheral);
     // Handle the callback by the object.
     uart->ReceiveCompleteCallback(huart);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(huart);
 }
 
 /**
@@ -82,6 +90,8 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
  * murasaki::Uart::HandleError() function.
  */
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+    MURASAKI_TRACE_CALLBACK_ENTER(huart);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(huart);
     // Convert it to the appropriate type.
@@ -89,6 +99,7 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
     // Handle the callback by the object.
     uart->HandleError(huart);
 
+    MURASAKI_TRACE_CALLBACK_EXIT(huart);
 }
 
 /* -------------------------- SPI ---------------------------------- */
@@ -111,12 +122,16 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
  * murasaki::Spi::TransmitAndReceiveCompleteCallback () function.
  */
 void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hspi);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hspi);
     // Convert it to the appropriate type.
     murasaki::SpiCallbackStrategy *spi = reinterpret_cast<murasaki::SpiCallbackStrategy*>(peripheral);
     // Handle the callback by the object.
     spi->TransmitAndReceiveCompleteCallback(hspi);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hspi);
 }
 
 /**
@@ -135,12 +150,16 @@ void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
  * murasaki::Uart::HandleError() function.
  */
 void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hspi);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hspi);
     // Convert it to the appropriate type.
     murasaki::SpiCallbackStrategy *spi = reinterpret_cast<murasaki::SpiCallbackStrategy*>(peripheral);
     // Handle the callback by the object.
     spi->HandleError(hspi);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hspi);
 }
 
 #endif
@@ -166,6 +185,8 @@ void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi) {
  */
 void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
                                   {
+    MURASAKI_TRACE_CALLBACK_ENTER(hi2c);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hi2c);
     // Convert it to the appropriate type.
@@ -173,6 +194,7 @@ void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
     // Handle the callback by the object.
     i2c->TransmitCompleteCallback(hi2c);
 
+    MURASAKI_TRACE_CALLBACK_EXIT(hi2c);
 }
 
 /**
@@ -190,12 +212,16 @@ void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
  * murasaki::Uart::ReceiveCompleteCallback() function.
  */
 void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hi2c);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hi2c);
     // Convert it to the appropriate type.
     murasaki::I2cCallbackStrategy *i2c = reinterpret_cast<murasaki::I2cCallbackStrategy*>(peripheral);
     // Handle the callback by the object.
     i2c->ReceiveCompleteCallback(hi2c);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hi2c);
 }
 /**
  * @brief Essential to sync up with I2C.
@@ -214,12 +240,16 @@ void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
  */
 void HAL_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef *hi2c)
                                  {
+    MURASAKI_TRACE_CALLBACK_ENTER(hi2c);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hi2c);
     // Convert it to the appropriate type.
     murasaki::I2cCallbackStrategy *i2c = reinterpret_cast<murasaki::I2cCallbackStrategy*>(peripheral);
     // Handle the callback by the object.
     i2c->TransmitCompleteCallback(hi2c);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hi2c);
 }
 
 /**
@@ -237,12 +267,16 @@ void HAL_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef *hi2c)
  * murasaki::I2cSlave::ReceiveCompleteCallback() function.
  */
 void HAL_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hi2c);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hi2c);
     // Convert it to the appropriate type.
     murasaki::I2cCallbackStrategy *i2c = reinterpret_cast<murasaki::I2cCallbackStrategy*>(peripheral);
     // Handle the callback by the object.
     i2c->ReceiveCompleteCallback(hi2c);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hi2c);
 }
 
 /**
@@ -261,6 +295,8 @@ void HAL_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef *hi2c) {
  * murasaki::I2c::HandleError() function.
  */
 void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hi2c);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hi2c);
     // Convert it to the appropriate type.
@@ -268,6 +304,7 @@ void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
     // Handle the callback by the object.
     i2c->HandleError(hi2c);
 
+    MURASAKI_TRACE_CALLBACK_EXIT(hi2c);
 }
 
 #endif
@@ -289,6 +326,7 @@ void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
  */
 void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
                               {
+    MURASAKI_TRACE_CALLBACK_ENTER(hadc);
 
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hadc);
@@ -296,6 +334,8 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
     murasaki::AdcStrategy *adc = reinterpret_cast<murasaki::AdcStrategy*>(peripheral);
     // Handle the callback by the object.
     adc->ConversionCompleteCallback(hadc);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hadc);
 }
 
 /**
@@ -308,12 +348,16 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
  */
 void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc)
                            {
+    MURASAKI_TRACE_CALLBACK_ENTER(hadc);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hadc);
     // Convert it to the appropriate type.
     murasaki::AdcStrategy *adc = reinterpret_cast<murasaki::AdcStrategy*>(peripheral);
     // Handle the callback by the object.
     adc->HandleError(hadc);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hadc);
 }
 
 #endif
@@ -330,6 +374,8 @@ void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc)
  * The second parameter of the ReceiveCallback() have to be 0 which mean the halfway interrupt.
  */
 void HAL_SAI_RxHalfCpltCallback(SAI_HandleTypeDef *hsai) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hsai);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hsai);
     // Convert it to the appropriate type.
@@ -337,6 +383,7 @@ void HAL_SAI_RxHalfCpltCallback(SAI_HandleTypeDef *hsai) {
     // Handle the callback by the object.
     audio->DmaCallback(hsai, 0);
 
+    MURASAKI_TRACE_CALLBACK_EXIT(hsai);
 }
 
 /**
@@ -349,12 +396,16 @@ void HAL_SAI_RxHalfCpltCallback(SAI_HandleTypeDef *hsai) {
  * The second parameter of the ReceiveCallback() have to be 1 which mean the complete interrupt.
  */
 void HAL_SAI_RxCpltCallback(SAI_HandleTypeDef *hsai) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hsai);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hsai);
     // Convert it to the appropriate type.
     murasaki::DuplexAudio *audio = reinterpret_cast<murasaki::DuplexAudio*>(peripheral);
     // Handle the callback by the object.
     audio->DmaCallback(hsai, 1);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hsai);
 }
 
 /**
@@ -368,12 +419,16 @@ void HAL_SAI_RxCpltCallback(SAI_HandleTypeDef *hsai) {
  */
 
 void HAL_SAI_ErrorCallback(SAI_HandleTypeDef *hsai) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hsai);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hsai);
     // Convert it to the appropriate type.
     murasaki::DuplexAudio *audio = reinterpret_cast<murasaki::DuplexAudio*>(peripheral);
     // Handle the callback by the object.
     audio->HandleError(hsai);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hsai);
 }
 
 #endif
@@ -390,12 +445,16 @@ void HAL_SAI_ErrorCallback(SAI_HandleTypeDef *hsai) {
  * The second parameter of the ReceiveCallback() have to be 0 which mean the halfway interrupt.
  */
 void HAL_I2S_RxHalfCpltCallback(I2S_HandleTypeDef *hi2s) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hi2s);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hi2s);
     // Convert it to the appropriate type.
     murasaki::DuplexAudio *audio = reinterpret_cast<murasaki::DuplexAudio*>(peripheral);
     // Handle the callback by the object.
     audio->DmaCallback(hi2s, 0);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hi2s);
 }
 
 /**
@@ -408,12 +467,16 @@ void HAL_I2S_RxHalfCpltCallback(I2S_HandleTypeDef *hi2s) {
  * The second parameter of the ReceiveCallback() have to be 1 which mean the complete interrupt.
  */
 void HAL_I2S_RxCpltCallback(I2S_HandleTypeDef *hi2s) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hi2s);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hi2s);
     // Convert it to the appropriate type.
     murasaki::DuplexAudio *audio = reinterpret_cast<murasaki::DuplexAudio*>(peripheral);
     // Handle the callback by the object.
     audio->DmaCallback(hi2s, 1);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hi2s);
 }
 
 /**
@@ -427,12 +490,16 @@ void HAL_I2S_RxCpltCallback(I2S_HandleTypeDef *hi2s) {
  */
 
 void HAL_I2S_ErrorCallback(I2S_HandleTypeDef *hi2s) {
+    MURASAKI_TRACE_CALLBACK_ENTER(hi2s);
+
     // Obtain the responding object.
     murasaki::PeripheralStrategy *peripheral = murasaki::CallbackRepositorySingleton::GetInstance()->GetPeripheralObject(hi2s);
     // Convert it to the appropriate type.
     murasaki::DuplexAudio *audio = reinterpret_cast<murasaki::DuplexAudio*>(peripheral);
     // Handle the callback by the object.
     audio->HandleError(hi2s);
+
+    MURASAKI_TRACE_CALLBACK_EXIT(hi2s);
 }
 #endif
 
@@ -454,12 +521,16 @@ void HAL_I2S_ErrorCallback(I2S_HandleTypeDef *hi2s) {
  * macro to identify that EXTI is FOO_Pin
  */
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+    MURASAKI_TRACE_CALLBACK_ENTER(GPIO_Pin);
+
     if (murasaki::Exti::isReady()) {
         // Obtain the responding object.
         murasaki::InterruptStrategy *exti = murasaki::ExtiCallbackRepositorySingleton::GetInstance()->GetExtiObject(GPIO_Pin);
         // Handle the callback by the object.
         exti->Release(GPIO_Pin);
     }
+
+    MURASAKI_TRACE_CALLBACK_EXIT(GPIO_Pin);
 }
 
 /*
@@ -37,6 +37,22 @@
 #define PLATFORM_CONFIG_DEBUG_LINE_SIZE  256
 #endif
 
+/**
+ * \def PLATFORM_CONFIG_DEBUG_NUM_OF_LINES
+ * \brief Number of the line buffers in the debug printf.
+ * \details
+ * Each murasaki::Debugger::Printf() call formats the string into one of these line buffers with interrupts enabled.
+ * So, this is the number of the tasks and ISRs which can format at the same time. If all line buffers are in use,
+ * the Printf() formats into an emergency line buffer with interrupts disabled.
+ *
+ * Each line buffer has @ref PLATFORM_CONFIG_DEBUG_LINE_SIZE bytes. Up to 32.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_DEBUG_NUM_OF_LINES
+#define PLATFORM_CONFIG_DEBUG_NUM_OF_LINES  4
+#endif
+
 /**
  * \def PLATFORM_CONFIG_DEBUG_BUFFER_SIZE
  * \brief Size[byte] of the circular buffer to be transmitted through the serial port.
@@ -49,6 +65,35 @@
 #define PLATFORM_CONFIG_DEBUG_BUFFER_SIZE  4096
 #endif
 
+/**
+ * \def PLATFORM_CONFIG_DEBUG_OVERFLOW_POLICY
+ * \brief Behavior of the debug printf when the circular buffer is full.
+ * \details
+ * Choose from the murasaki::DebuggerOverflowPolicy :
+ * \li murasaki::kdopDropNewest : Discard the new message entirely. Never truncated.
+ * \li murasaki::kdopOverwriteOldest : Discard the oldest unsent messages entirely to store the new message.
+ * \li murasaki::kdopBlock : Wait for the room up to @ref PLATFORM_CONFIG_DEBUG_BLOCK_TIMEOUT in the task context.
+ *
+ * The discarded messages and bytes are counted. The count is reported in the output as "N messages dropped".
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_DEBUG_OVERFLOW_POLICY
+#define PLATFORM_CONFIG_DEBUG_OVERFLOW_POLICY  murasaki::kdopDropNewest
+#endif
+
+/**
+ * \def PLATFORM_CONFIG_DEBUG_BLOCK_TIMEOUT
+ * \brief Timeout[mS] of the debug printf to wait for the room in the circular buffer.
+ * \details
+ * Used only when the @ref PLATFORM_CONFIG_DEBUG_OVERFLOW_POLICY is murasaki::kdopBlock.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_DEBUG_BLOCK_TIMEOUT
+#define PLATFORM_CONFIG_DEBUG_BLOCK_TIMEOUT  100
+#endif
+
 /**
  * \def PLATFORM_CONFIG_DEBUG_SERIAL_TIMEOUT
  * \brief Timeout of the serial port to transmit the string through the Debug class.
@@ -90,6 +135,22 @@
 #define PLATFORM_CONFIG_DEBUG_TASK_PRIORITY  murasaki::ktpHigh
 #endif
 
+// For audio **********************************************************
+/**
+ * \def PLATFORM_CONFIG_AUDIO_DMA_TIMEOUT
+ * \brief Time out of the audio DMA interrupt [mS].
+ * \details
+ * If the murasaki::DuplexAudio doesn't receive the DMA interrupt in this duration, it
+ * assumes the transfer is stalled, and restarts the transfer.
+ *
+ * This value have to be longer than the period of the audio block.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_AUDIO_DMA_TIMEOUT
+#define PLATFORM_CONFIG_AUDIO_DMA_TIMEOUT  1000
+#endif
+
 // For assertion ******************************************************
 /**
  * \def MURASAKI_CONFIG_NODEBUG
@@ -118,6 +179,85 @@
 #define MURASAKI_CONFIG_NOSYSLOG false
 #endif
 
+/**
+ * \def MURASAKI_CONFIG_DEFERRED_SYSLOG
+ * \brief Use the deferred binary logging for \ref MURASAKI_SYSLOG.
+ * \details
+ * Set this macro to true, to make the \ref MURASAKI_SYSLOG store only the format ID, timestamp and
+ * raw arguments, instead of the formatted text. The text is rebuilt by the host side decoder
+ * tools/murasaki_logdecode.py with the ELF file. See \ref MURASAKI_DEFERRED_LOG.
+ *
+ * Set this macro false, to format the message on the target.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_DEFERRED_SYSLOG
+#define MURASAKI_CONFIG_DEFERRED_SYSLOG false
+#endif
+
+/**
+ * \def MURASAKI_CONFIG_SYSLOG_MIN_SEVERITY
+ * \brief The lowest severity of \ref MURASAKI_SYSLOG compiled in.
+ * \details
+ * The \ref MURASAKI_SYSLOG with the severity lower than this value is removed at the compile time.
+ * The arguments are not evaluated, and no code is generated. For example, set murasaki::kseError
+ * for the production build, to remove all debug messages from the hot path.
+ *
+ * The messages with the severity higher than or equal to murasaki::kseError are never removed,
+ * as same as the run time filter.
+ *
+ * The run time threshold by murasaki::SetSyslogSeverityThreshold() is still applied to the compiled in messages.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_SYSLOG_MIN_SEVERITY
+#define MURASAKI_CONFIG_SYSLOG_MIN_SEVERITY murasaki::kseDebug
+#endif
+
+/**
+ * \def MURASAKI_CONFIG_SYSLOG_FACILITY_MASK
+ * \brief Facility mask of \ref MURASAKI_SYSLOG compiled in.
+ * \details
+ * The \ref MURASAKI_SYSLOG with the facility which is "0" in this mask is removed at the compile time,
+ * unless its severity is higher than or equal to murasaki::kseError.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_SYSLOG_FACILITY_MASK
+#define MURASAKI_CONFIG_SYSLOG_FACILITY_MASK murasaki::kfaAll
+#endif
+
+/**
+ * \def PLATFORM_CONFIG_SYSLOG_REPORT_INTERVAL
+ * \brief Interval of the report of the suppressed syslog messages [mS].
+ * \details
+ * The number of the messages suppressed by the rate limit is reported before the syslog message,
+ * if this interval has passed since the last report. See murasaki::SetSyslogRateLimit().
+ * Set 0 to disable the automatic report.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_SYSLOG_REPORT_INTERVAL
+#define PLATFORM_CONFIG_SYSLOG_REPORT_INTERVAL 10000
+#endif
+
+/**
+ * \def MURASAKI_CONFIG_LIGHT_PRINTF
+ * \brief Use the type-safe formatter in the murasaki::Debugger::Printf().
+ * \details
+ * Set this macro to true, to replace the vsnprintf() in the Debugger::Printf() and \ref MURASAKI_SYSLOG
+ * by the variadic template formatter murasaki::FormatString(). The formatter knows the type of the
+ * arguments, uses no heap and supports the floating point without the float support of the printf family.
+ * See murasaki_format.hpp for the supported format.
+ *
+ * Set this macro false, to use the vsnprintf().
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_LIGHT_PRINTF
+#define MURASAKI_CONFIG_LIGHT_PRINTF false
+#endif
+
 /**
  * @def MURASAKI_CONFIG_NOCYCCNT
  * @brief Doesn't run the CYCCNT counter.
@@ -130,6 +270,383 @@
 #define MURASAKI_CONFIG_NOCYCCNT false
 #endif
 
+// For trace recorder ******************************************************
+/**
+ * @def MURASAKI_CONFIG_TRACE
+ * @brief Enable the trace recorder.
+ * @details
+ * Set this macro to true, to record the task switches, the synchronizer wait / release and the HAL callbacks
+ * into the RAM ring. See @ref MURASAKI_TRACE. Set this macro false, to remove the recorder entirely.
+ *
+ * To record the task switches, include murasaki_tracehook.h at the end of the FreeRTOSConfig.h.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_TRACE
+#define MURASAKI_CONFIG_TRACE false
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS
+ * @brief Number of the records in the trace ring.
+ * @details
+ * Must be power of 2. Each record takes 16 bytes. Once the ring is full, the oldest record is overwritten.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS
+#define PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS 256
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_TRACE_NUM_OF_TASKS
+ * @brief Number of the task names kept by the trace recorder.
+ * @details
+ * The name of the task is registered at its creation. The tasks over this number are shown by their address.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_TRACE_NUM_OF_TASKS
+#define PLATFORM_CONFIG_TRACE_NUM_OF_TASKS 16
+#endif
+
+// For synchronizer ********************************************************
+/**
+ * @def MURASAKI_CONFIG_NOTIFICATION_SYNCHRONIZER
+ * @brief Use the task notification to synchronize the peripheral classes and their interrupts.
+ * @details
+ * Set this macro to true, to make the murasaki::PeripheralSynchronizer the murasaki::NotificationSynchronizer.
+ * The Uart, DebuggerUart, SpiMaster, SpiSlave, I2cMaster, I2cSlave, Adc and DuplexAudio wait for their interrupts
+ * by the direct to task notification, instead of the binary semaphore.
+ *
+ * Set this macro false, to use the murasaki::Synchronizer.
+ *
+ * The configTASK_NOTIFICATION_ARRAY_ENTRIES must be bigger than 1 ( FreeRTOS V10.4.0 or later ), to keep the
+ * index 0 for the stream buffer and the other libraries.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_NOTIFICATION_SYNCHRONIZER
+#define MURASAKI_CONFIG_NOTIFICATION_SYNCHRONIZER false
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_NOTIFICATION_SYNCHRONIZER_INDEX
+ * @brief Index of the task notification used by the murasaki::NotificationSynchronizer.
+ * @details
+ * Used only when the configTASK_NOTIFICATION_ARRAY_ENTRIES is bigger than 1. By default, the last entry,
+ * to keep the index 0 for the stream buffer and the other libraries.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_NOTIFICATION_SYNCHRONIZER_INDEX
+#define PLATFORM_CONFIG_NOTIFICATION_SYNCHRONIZER_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_PERIPHERAL_CRITICAL_SECTION
+ * @brief Critical section class used by the peripheral classes.
+ * @details
+ * The Uart, DebuggerUart, SpiMaster, SpiSlave, I2cMaster, I2cSlave and Adc serialize their transactions by this class.
+ * Choose from murasaki::CriticalSection and murasaki::RecursiveCriticalSection. The murasaki::RecursiveCriticalSection
+ * lets the task call the member functions while it is in the same critical section of the peripheral.
+ *
+ * The InterruptCriticalSection and SchedulerCriticalSection can't be used, because the peripheral classes wait for
+ * the interrupt inside the critical section.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_PERIPHERAL_CRITICAL_SECTION
+#define PLATFORM_CONFIG_PERIPHERAL_CRITICAL_SECTION murasaki::CriticalSection
+#endif
+
+// For memory allocation *************************************************
+/**
+ * @def MURASAKI_CONFIG_STATIC_ALLOCATION
+ * @brief Allocate all memory statically, without the heap.
+ * @details
+ * Set this macro to true, to bring up the platform with zero heap use :
+ * @li The operator new allocates from a static arena of @ref PLATFORM_CONFIG_STATIC_ARENA_SIZE bytes. The arena
+ * is never freed, and the operator delete of the arena memory is an assertion failure. So, the objects must be
+ * created once at the initialization, as usual in the InitPlatform(). The functions which create and delete
+ * the objects temporarily can't be used : murasaki::SynchronizerBenchmark(), murasaki::CriticalSectionBenchmark(),
+ * murasaki::PrintfLatencyBenchmark(), murasaki::TelemetryBenchmark() and murasaki::AudioConversionBenchmark(). The memory from the pool of the
+ * @ref MURASAKI_CONFIG_POOL_ALLOCATOR can be freed.
+ * @li The murasaki::Synchronizer, murasaki::CriticalSection and murasaki::RecursiveCriticalSection create their
+ * semaphores inside themselves by the xSemaphoreCreate*Static() API.
+ * @li The murasaki::TaskStrategy creates the task by xTaskCreateStatic(). The stack is given by the constructor,
+ * or allocated from the arena.
+ *
+ * Because the arena is a static array, the linker checks the RAM budget. The configSUPPORT_STATIC_ALLOCATION must be
+ * 1 in the FreeRTOSConfig.h. Then, the application must provide the vApplicationGetIdleTaskMemory() and the
+ * vApplicationGetTimerTaskMemory(). The CubeIDE generates them.
+ *
+ * Set this macro false, to allocate from the FreeRTOS heap.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_STATIC_ALLOCATION
+#define MURASAKI_CONFIG_STATIC_ALLOCATION false
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_STATIC_ARENA_SIZE
+ * @brief Size[byte] of the static arena for the operator new.
+ * @details
+ * Used only when the @ref MURASAKI_CONFIG_STATIC_ALLOCATION is true. murasaki::GetStaticArenaUsage() tells
+ * the used size, to tune this value.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_STATIC_ARENA_SIZE
+#define PLATFORM_CONFIG_STATIC_ARENA_SIZE 32768
+#endif
+
+/**
+ * @def MURASAKI_CONFIG_POOL_ALLOCATOR
+ * @brief Allocate the small objects from the size-class pool.
+ * @details
+ * Set this macro to true, to let the operator new allocate from the fixed size blocks. The allocation and
+ * the free are O(1), and not fragmented. And they are allowed in ISR, as far as the size class has a free block.
+ *
+ * The large requests and the requests to the exhausted class fall back to the FreeRTOS heap, or the static arena
+ * of @ref MURASAKI_CONFIG_STATIC_ALLOCATION. See murasaki::ReportPoolAllocator() for the statistics.
+ *
+ * This allocator needs C++14 or later, to check the size classes at compile time.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_POOL_ALLOCATOR
+#define MURASAKI_CONFIG_POOL_ALLOCATOR false
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_POOL_BLOCK_SIZES
+ * @brief Block size[byte] of each size class of the pool allocator.
+ * @details
+ * An initializer list. The sizes must be ascending, and multiple of the portBYTE_ALIGNMENT.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_POOL_BLOCK_SIZES
+#define PLATFORM_CONFIG_POOL_BLOCK_SIZES { 16, 32, 64, 128, 256 }
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_POOL_NUM_OF_BLOCKS
+ * @brief Number of blocks of each size class of the pool allocator.
+ * @details
+ * An initializer list with the same length as @ref PLATFORM_CONFIG_POOL_BLOCK_SIZES.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_POOL_NUM_OF_BLOCKS
+#define PLATFORM_CONFIG_POOL_NUM_OF_BLOCKS { 64, 64, 32, 16, 8 }
+#endif
+
+/**
+ * @def MURASAKI_CONFIG_HEAP_TRACE
+ * @brief Trace the owner and the caller of each allocation by the operator new.
+ * @details
+ * Set this macro to true, to add a header to each allocation. The live bytes, the peak bytes and the
+ * allocation counts are recorded for each owner. See murasaki_heaptrace.hpp and murasaki::ReportHeapUsage().
+ *
+ * The header costs some bytes for each allocation. And the allocation and the free take longer.
+ *
+ * The murasaki::HeapOwner uses a thread local storage pointer. See @ref PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_HEAP_TRACE
+#define MURASAKI_CONFIG_HEAP_TRACE false
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_HEAP_TRACE_NUM_OF_OWNERS
+ * @brief Number of the owners recorded by the heap trace.
+ * @details
+ * The owners over this number are recorded together as "others".
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_HEAP_TRACE_NUM_OF_OWNERS
+#define PLATFORM_CONFIG_HEAP_TRACE_NUM_OF_OWNERS 16
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX
+ * @brief Index of the thread local storage pointer to keep the murasaki::HeapOwner scope of each task.
+ * @details
+ * Must be smaller than the configNUM_THREAD_LOCAL_STORAGE_POINTERS of the FreeRTOSConfig.h.
+ * Choose the index which is not used by the other software.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX
+#define PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX 0
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_FREERTOS_HEAP_STATS
+ * @brief The FreeRTOS has vPortGetHeapStats().
+ * @details
+ * The murasaki::ReportHeapUsage() prints the fragmentation of the FreeRTOS heap by vPortGetHeapStats(), if this
+ * macro is true. It is available in the FreeRTOS V10.2.1 or later, with the heap_4.c or the heap_5.c.
+ * By default, true if the kernel version is V10.2.1 or later. Set false if the other heap implementation is used.
+ *
+ * If false, only the free size by xPortGetFreeHeapSize() is printed.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_FREERTOS_HEAP_STATS
+#define PLATFORM_CONFIG_FREERTOS_HEAP_STATS ( (tskKERNEL_VERSION_MAJOR > 10) || \
+    ( (tskKERNEL_VERSION_MAJOR == 10) && ( (tskKERNEL_VERSION_MINOR > 2) || \
+            ( (tskKERNEL_VERSION_MINOR == 2) && (tskKERNEL_VERSION_BUILD >= 1) ) ) ) )
+#endif
+
+// For task statistics *****************************************************
+/**
+ * @def MURASAKI_CONFIG_TASK_STATISTICS
+ * @brief Measure the CPU usage, the context switches and the time slice of each task.
+ * @details
+ * Set this macro to true, to measure the tasks at every task switch by the murasaki::GetTimebaseCounter().
+ * See murasaki_taskstats.hpp and murasaki::TaskMonitor.
+ *
+ * The task switch hooks are needed. Include murasaki_tracehook.h at the end of the FreeRTOSConfig.h.
+ *
+ * The measurement of each task is found by a thread local storage pointer. See @ref PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef MURASAKI_CONFIG_TASK_STATISTICS
+#define MURASAKI_CONFIG_TASK_STATISTICS false
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_TASK_STATISTICS_NUM_OF_TASKS
+ * @brief Number of the tasks measured by the task statistics.
+ * @details
+ * The tasks are registered at their creation, including the idle task and the timer task of the FreeRTOS.
+ * The tasks over this number are not measured.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_TASK_STATISTICS_NUM_OF_TASKS
+#define PLATFORM_CONFIG_TASK_STATISTICS_NUM_OF_TASKS 16
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX
+ * @brief Index of the thread local storage pointer to keep the measurement of each task.
+ * @details
+ * Must be smaller than the configNUM_THREAD_LOCAL_STORAGE_POINTERS of the FreeRTOSConfig.h, and different
+ * from @ref PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX if the heap trace is enabled.
+ * Choose the index which is not used by the other software.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX
+#define PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX 1
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_TASK_MONITOR_TASK_STACK_SIZE
+ * @brief Size[Byte] of the task inside murasaki::TaskMonitor.
+ * @details
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_TASK_MONITOR_TASK_STACK_SIZE
+#define PLATFORM_CONFIG_TASK_MONITOR_TASK_STACK_SIZE 512
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_TASK_MONITOR_TASK_PRIORITY
+ * @brief The task priority of the murasaki::TaskMonitor.
+ * @details
+ * The report is printed from this task. Keep it low, not to disturb the measured tasks.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_TASK_MONITOR_TASK_PRIORITY
+#define PLATFORM_CONFIG_TASK_MONITOR_TASK_PRIORITY murasaki::ktpLow
+#endif
+
+// For RTT logger **********************************************************
+/**
+ * @def PLATFORM_CONFIG_RTT_UP_BUFFER_SIZE
+ * @brief Size[byte] of the ring from the target to the host in the murasaki::RttLogger.
+ * @details
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_RTT_UP_BUFFER_SIZE
+#define PLATFORM_CONFIG_RTT_UP_BUFFER_SIZE 1024
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_RTT_DOWN_BUFFER_SIZE
+ * @brief Size[byte] of the ring from the host to the target in the murasaki::RttLogger.
+ * @details
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_RTT_DOWN_BUFFER_SIZE
+#define PLATFORM_CONFIG_RTT_DOWN_BUFFER_SIZE 16
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_RTT_SECTION
+ * @brief Attribute to place the control block and the rings of the murasaki::RttLogger.
+ * @details
+ * If the D-cache is enabled, the murasaki::RttLogger cleans and invalidates the rings and the offsets for the
+ * probe. But the write offset and the read offset share a cache line. If the host updates the read offset
+ * just before the write back of the write offset, the update is undone, and the host reads a part of the
+ * ring again. To avoid it, place them in the non-cacheable region set by the MPU. For example :
+ * @code
+ * #define PLATFORM_CONFIG_RTT_SECTION __attribute__((section(".rtt_nocache")))
+ * @endcode
+ * The section must be defined by the linker script. By default, empty.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_RTT_SECTION
+#define PLATFORM_CONFIG_RTT_SECTION
+#endif
+
+// For telemetry ***********************************************************
+/**
+ * @def PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS
+ * @brief Number of the variables registered to a murasaki::Telemetry.
+ * @details
+ * Up to 32.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS
+#define PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS 16
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_TELEMETRY_TASK_STACK_SIZE
+ * @brief Size[Byte] of the task inside murasaki::Telemetry.
+ * @details
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_TELEMETRY_TASK_STACK_SIZE
+#define PLATFORM_CONFIG_TELEMETRY_TASK_STACK_SIZE 256
+#endif
+
+/**
+ * @def PLATFORM_CONFIG_TELEMETRY_TASK_PRIORITY
+ * @brief The task priority of the murasaki::Telemetry.
+ * @details
+ * To keep the sampling period, the priority have to be higher than the tasks which changes the variables.
+ * In other hand, it have to be lower than the debug task, to send the frames.
+ *
+ * To override the definition here, define same macro inside @ref platform_config.hpp.
+ */
+#ifndef PLATFORM_CONFIG_TELEMETRY_TASK_PRIORITY
+#define PLATFORM_CONFIG_TELEMETRY_TASK_PRIORITY murasaki::ktpAboveNormal
+#endif
+
 /**
  * @def NUM_OF_CALLBACK_OBJECTS
  * @brief The number of the interrupt callback handling objects.
@@ -156,6 +673,30 @@
 #define NUM_OF_EXTI_OBJECTS 8
 #endif
 
+/**
+ * @def NUM_OF_AUDIO_TAPS
+ * @brief The number of the tap objects per murasaki::DuplexAudio.
+ * @details
+ * Up to this number, murasaki::DuplexAudio can pass the DMA blocks to the taps.
+ *
+ * Usually, 2 is enough.
+ */
+#ifndef NUM_OF_AUDIO_TAPS
+#define NUM_OF_AUDIO_TAPS 2
+#endif
+
+/**
+ * @def NUM_OF_AUDIO_FANOUT_READERS
+ * @brief The number of the reader objects per murasaki::AudioFanout.
+ * @details
+ * Up to this number, murasaki::AudioFanoutReader can read the same RX stream.
+ *
+ * Usually, 4 is enough.
+ */
+#ifndef NUM_OF_AUDIO_FANOUT_READERS
+#define NUM_OF_AUDIO_FANOUT_READERS 4
+#endif
+
 /**
  * \}
  * end of the MURASAKI_PLATFORM_CONFIGURATION
@@ -0,0 +1,176 @@
+/**
+ * @file murasaki_deferredlog.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Deferred binary logging.
+ * @details
+ * The deferred log doesn't format the message on the target. Instead, it stores the address
+ * of the format string, the timestamp and the raw arguments into the debugger FIFO as a binary frame.
+ * The format string is placed in the ".murasaki_fmt" section. The host side decoder
+ * tools/murasaki_logdecode.py reads the section from the ELF file and rebuilds the text.
+ *
+ * The cost per call is a few tens of word copies, instead of the vsnprintf() with interrupts disabled.
+ * And the size of a frame is 10 bytes + 4 bytes per argument.
+ */
+
+#ifndef MURASAKI_DEFERREDLOG_HPP_
+#define MURASAKI_DEFERREDLOG_HPP_
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+#include "debugger.hpp"
+#include "murasaki_defs.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Number of the words to store an argument of the deferred log.
+ * @details
+ * Integers up to 32bit and pointers take 1 word. 64bit integers and floating points take 2 words.
+ * The floating point is stored as double, as same as the variable argument of printf().
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+template<typename T>
+struct DeferredLogArgWords
+{
+    /// Number of the words.
+    static constexpr unsigned int value = (std::is_floating_point<T>::value || sizeof(T) > sizeof(uint32_t)) ? 2 : 1;
+};
+
+/**
+ * @brief Total number of the words to store the arguments of the deferred log.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+template<typename ... Args>
+struct DeferredLogWords;
+
+/**
+ * @brief Total number of the words. Terminal case.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+template<>
+struct DeferredLogWords<>
+{
+    /// Number of the words.
+    static constexpr unsigned int value = 0;
+};
+
+/**
+ * @brief Total number of the words. Recursive case.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+template<typename T, typename ... Rest>
+struct DeferredLogWords<T, Rest...>
+{
+    /// Number of the words.
+    static constexpr unsigned int value = DeferredLogArgWords<T>::value + DeferredLogWords<Rest...>::value;
+};
+
+// Store an integer or enum argument.
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, uint32_t*>::type
+PackDeferredLogArg(uint32_t *words, T arg)
+                   {
+    const uint64_t value = static_cast<uint64_t>(arg);
+
+    *words++ = static_cast<uint32_t>(value);
+    if (DeferredLogArgWords<T>::value == 2)
+        *words++ = static_cast<uint32_t>(value >> 32);
+    return words;
+}
+
+// Store a floating point argument as double.
+template<typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value, uint32_t*>::type
+PackDeferredLogArg(uint32_t *words, T arg)
+                   {
+    const double value = arg;
+
+    ::memcpy(words, &value, sizeof(value));
+    return words + 2;
+}
+
+// Store a pointer argument. The string is stored as its address.
+template<typename T>
+inline typename std::enable_if<std::is_pointer<T>::value, uint32_t*>::type
+PackDeferredLogArg(uint32_t *words, T arg)
+                   {
+    *words++ = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(arg));
+    return words;
+}
+
+// Terminal case of the argument packing.
+inline void PackDeferredLogArgs(uint32_t *words)
+                                {
+}
+
+// Store the arguments from left to right.
+template<typename T, typename ... Rest>
+inline void PackDeferredLogArgs(uint32_t *words, T first, Rest ... rest)
+                                {
+    PackDeferredLogArgs(PackDeferredLogArg(words, first), rest...);
+}
+
+/**
+ * @brief Store a deferred log frame.
+ * @param format Format string in the ".murasaki_fmt" section. The address is used as ID.
+ * @param args Arguments of the format.
+ * @details
+ * Use @ref MURASAKI_DEFERRED_LOG instead of calling this function directly. The format string must be
+ * placed in the ".murasaki_fmt" section. Otherwise, the decoder can't find it.
+ *
+ * The "%s" argument is stored as an address. The decoder can print the string only when it is a constant
+ * in the ELF file. Do not pass the string in RAM.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+template<typename ... Args>
+inline void DeferredLog(const char *format, Args ... args)
+                        {
+    // ID, timestamp and arguments.
+    uint32_t payload[2 + DeferredLogWords<Args...>::value];
+
+    static_assert(sizeof(payload) / sizeof(payload[0]) <= 255, "Too many arguments for deferred log");
+
+    payload[0] = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(format));
+    payload[1] = murasaki::GetCycleCounter();
+    PackDeferredLogArgs(&payload[2], args...);
+
+    murasaki::debugger->PutDeferredLog(payload, sizeof(payload) / sizeof(payload[0]));
+}
+
+} /* namespace murasaki */
+
+// Convert the __LINE__ to the string literal.
+#define MURASAKI_DEFERRED_STRINGIFY_(x) #x
+#define MURASAKI_DEFERRED_STRINGIFY(x) MURASAKI_DEFERRED_STRINGIFY_(x)
+
+/**
+ * \def MURASAKI_DEFERRED_LOG
+ * \param FORMAT Message format as printf style. Must be a string literal.
+ * \brief Output the message by deferred binary logging.
+ * \details
+ * Place the FORMAT in the ".murasaki_fmt" section, and store its address, the cycle counter and the arguments
+ * into the debugger FIFO. Can be called from both task and ISR.
+ *
+ * The stored frame is decoded on the host :
+ * @code
+ * python3 tools/murasaki_logdecode.py build/app.elf < serial_capture.bin
+ * @endcode
+ *
+ * The text by @ref murasaki::Debugger::Printf() can be mixed in the same stream. The decoder passes it through.
+ *
+ * The section ".murasaki_fmt" is placed next to the ".rodata" by the linker, as orphan section.
+ * Keep it in the linker script by KEEP(*(.murasaki_fmt)) if the --gc-sections removes it.
+ *
+ * \ingroup MURASAKI_GROUP
+ */
+#define MURASAKI_DEFERRED_LOG( FORMAT, ... )\
+    {\
+        static const char murasaki_deferred_format[] __attribute__((section(".murasaki_fmt"), used)) = FORMAT;\
+        murasaki::DeferredLog(murasaki_deferred_format, ##__VA_ARGS__);\
+    }
+
+#endif /* MURASAKI_DEFERREDLOG_HPP_ */
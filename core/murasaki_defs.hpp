@@ -269,6 +269,59 @@ enum InterruptStatus {
     kisTimeOut   //!< kisTimeOut Time out happen
 };
 
+/**
+ * @brief Policy of the debugger FIFO when there is no room for the new message.
+ * @details
+ * See @ref PLATFORM_CONFIG_DEBUG_OVERFLOW_POLICY.
+ */
+enum DebuggerOverflowPolicy {
+    kdopDropNewest = 0,     //!< kdopDropNewest discards the new message entirely.
+    kdopOverwriteOldest,    //!< kdopOverwriteOldest discards the oldest unsent messages entirely to store the new message.
+    kdopBlock               //!< kdopBlock waits for the room in the task context. Discard the new message in ISR or by timeout.
+};
+
+/**
+ * @brief Kind of the event in the trace recorder.
+ * @details
+ * See @ref MURASAKI_TRACE.
+ */
+enum TraceEvent {
+    kteTaskSwitchedIn = 0,  //!< kteTaskSwitchedIn : A task starts to run. The object is the task, the argument is its priority.
+    kteTaskSwitchedOut,     //!< kteTaskSwitchedOut : A task stops to run. The object is the task.
+    ktePriorityChange,      //!< ktePriorityChange : Priority inheritance or disinheritance. The object is the task, the argument is the new priority.
+    kteCallbackEnter,       //!< kteCallbackEnter : Entry of the HAL callback. The object is the handle, the argument is the name of the callback.
+    kteCallbackExit,        //!< kteCallbackExit : Exit of the HAL callback. The object is the handle, the argument is the name of the callback.
+    kteWaitBegin,           //!< kteWaitBegin : A task starts to wait for the synchronizer. The argument is the timeout [mS].
+    kteWaitEnd,             //!< kteWaitEnd : A task is released or timed out. The argument is 1 if released.
+    kteRelease              //!< kteRelease : The synchronizer is released. The argument is 1 if it is released from ISR.
+};
+
+/**
+ * @brief Type of the variable in the telemetry.
+ * @details
+ * See murasaki::Telemetry. The value is sent to the host in the descriptor frame.
+ */
+enum TelemetryType {
+    ktlInt8 = 0,    //!< ktlInt8 : int8_t.
+    ktlUint8,       //!< ktlUint8 : uint8_t.
+    ktlInt16,       //!< ktlInt16 : int16_t.
+    ktlUint16,      //!< ktlUint16 : uint16_t.
+    ktlInt32,       //!< ktlInt32 : int32_t.
+    ktlUint32,      //!< ktlUint32 : uint32_t.
+    ktlFloat        //!< ktlFloat : float.
+};
+
+/**
+ * @brief Behavior of the murasaki::RttLogger when the ring is full.
+ * @details
+ * The values are same with the flags of the SEGGER RTT. So, the host tool can change it.
+ */
+enum RttMode {
+    krmSkip = 0,    //!< krmSkip discards the entire message if the ring doesn't have enough room.
+    krmTrim = 1,    //!< krmTrim stores the message as possible, and discards the rest.
+    krmBlock = 2    //!< krmBlock waits for the reader to drain the ring.
+};
+
 /**
  * @brief Task class dedicated priority
  * @details
@@ -326,6 +379,41 @@ static inline bool IsInsideInterrupt()
 
 }
 
+/**
+ * \brief determine whether the interrupts are masked.
+ * \returns true if the interrupts are masked by PRIMASK or BASEPRI. For example, inside the taskENTER_CRITICAL().
+ * \details
+ * The task must not block while the interrupts are masked. The scheduler can't switch the task.
+ */
+static inline bool IsInterruptMasked()
+{
+#if defined ( __CORE_CM0_H_GENERIC ) ||defined ( __CORE_CM0PLUS_H_GENERIC ) || defined ( __CORE_CM1_H_GENERIC )
+    // The ARMv6-M doesn't have BASEPRI. The FreeRTOS uses PRIMASK for the critical section.
+    return __get_PRIMASK() != 0;
+#else
+    return __get_PRIMASK() != 0 || __get_BASEPRI() != 0;
+#endif
+}
+
+// Search the last directory separator.
+constexpr const char* FileBaseNameAfter(const char *path, const char *last)
+                                        {
+    return (*path == '\0') ? last : FileBaseNameAfter(path + 1, (*path == '/' || *path == '\\') ? path + 1 : last);
+}
+
+/**
+ * \brief Remove the directory part from the path.
+ * \param path Path of the file. Usually, __FILE__.
+ * \returns Pointer to the file name part inside the path.
+ * \details
+ * This function is constexpr. So, the file name is obtained at the compile time, if the result
+ * is assigned to the constexpr variable.
+ */
+constexpr const char* FileBaseName(const char *path)
+                                   {
+    return FileBaseNameAfter(path, path);
+}
+
 
 /**
  * @brief Clean and Flush the specific region of the data cache.
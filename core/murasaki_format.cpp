@@ -0,0 +1,540 @@
+/*
+ * murasaki_format.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include "murasaki_format.hpp"
+
+// Longest body of the floating point conversion : 20 digits of the integer part, point and fraction.
+#define FORMAT_MAX_PRECISION 32
+#define FORMAT_BODY_SIZE (20 + 1 + FORMAT_MAX_PRECISION + 8)
+// Digits below the decimal point which are computed. The rest is filled by 0.
+#define FORMAT_FRACTION_DIGITS 9
+
+namespace murasaki {
+
+// Output cursor. Truncate at the end of buffer.
+struct FormatOutput
+{
+    char *buffer;
+    unsigned int size;
+    unsigned int length;
+
+    void Put(char c)
+             {
+        if (length + 1 < size)
+            buffer[length++] = c;
+    }
+
+    void Fill(char c, int count)
+              {
+        while (count-- > 0)
+            Put(c);
+    }
+};
+
+// Parsed conversion specification.
+struct FormatSpec
+{
+    bool left;
+    bool zero;
+    bool plus;
+    bool space;
+    bool alt;
+    int width;
+    int precision;  // -1 if not specified.
+    char conversion;
+};
+
+// Store the digits of value at the end of digits[]. Return the pointer to the first digit.
+static char* ToDigits(uint64_t value, unsigned int base, bool upper, char *end)
+                      {
+    const char *figures = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char *p = end;
+
+    // 64bit division is slow on 32bit CPU. Use it only when needed.
+    while (value > 0xFFFFFFFFu) {
+        *--p = figures[value % base];
+        value /= base;
+    }
+
+    uint32_t value32 = static_cast<uint32_t>(value);
+    while (value32 != 0) {
+        *--p = figures[value32 % base];
+        value32 /= base;
+    }
+
+    return p;
+}
+
+// Output prefix, zeros and body with the padding.
+static void PutField(FormatOutput *out, const FormatSpec &spec, const char *prefix, int zeros, const char *body, int body_len,
+                     bool zero_pad)
+                     {
+    int prefix_len = 0;
+    while (prefix[prefix_len] != '\0')
+        prefix_len++;
+
+    int padding = spec.width - (prefix_len + zeros + body_len);
+
+    if (!spec.left && !zero_pad)
+        out->Fill(' ', padding);
+    for (int i = 0; i < prefix_len; i++)
+        out->Put(prefix[i]);
+    if (!spec.left && zero_pad)
+        out->Fill('0', padding);
+    out->Fill('0', zeros);
+    for (int i = 0; i < body_len; i++)
+        out->Put(body[i]);
+    if (spec.left)
+        out->Fill(' ', padding);
+}
+
+// Integer conversions : d, i, u, o, x, X.
+static void PutInteger(FormatOutput *out, const FormatSpec &spec, const murasaki::FormatArg &arg)
+                       {
+    bool negative = false;
+    uint64_t value;
+
+    switch (arg.type) {
+        case murasaki::FormatArg::kSigned:
+            if (spec.conversion == 'd' || spec.conversion == 'i') {
+                negative = arg.value.s < 0;
+                value = negative ? 0 - static_cast<uint64_t>(arg.value.s) : static_cast<uint64_t>(arg.value.s);
+            }
+            else {
+                // Print the negative value as the unsigned of the same size, as same as printf().
+                value = static_cast<uint64_t>(arg.value.s);
+                if (arg.size < sizeof(uint64_t))
+                    value &= (static_cast<uint64_t>(1) << (arg.size * 8)) - 1;
+            }
+            break;
+        case murasaki::FormatArg::kDouble:
+            negative = arg.value.d < 0;
+            value = static_cast<uint64_t>(negative ? -arg.value.d : arg.value.d);
+            break;
+        case murasaki::FormatArg::kString:
+        case murasaki::FormatArg::kPointer:
+            value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(arg.value.ptr));
+            break;
+        default:
+            value = arg.value.u;
+            break;
+    }
+
+    unsigned int base = 10;
+    if (spec.conversion == 'o')
+        base = 8;
+    else if (spec.conversion == 'x' || spec.conversion == 'X')
+        base = 16;
+
+    char digits[24];
+    char *end = &digits[sizeof(digits)];
+    char *first = ToDigits(value, base, spec.conversion == 'X', end);
+    int num_of_digits = end - first;
+
+    // The precision is the minimum number of digits. "%.0d" of 0 prints nothing.
+    int precision = (spec.precision < 0) ? 1 : spec.precision;
+    int zeros = (precision > num_of_digits) ? precision - num_of_digits : 0;
+
+    const char *prefix = "";
+    if (negative)
+        prefix = "-";
+    else if (spec.conversion == 'd' || spec.conversion == 'i')
+        prefix = spec.plus ? "+" : (spec.space ? " " : "");
+    else if (spec.alt && base == 16 && value != 0)
+        prefix = (spec.conversion == 'X') ? "0X" : "0x";
+    else if (spec.alt && base == 8 && zeros == 0)
+        zeros = 1;
+
+    PutField(out, spec, prefix, zeros, first, num_of_digits, spec.zero && spec.precision < 0);
+}
+
+// Store the fixed point representation of value ( >= 0 ) into body. Return the length.
+static int FixedBody(double value, int precision, bool point, char *body)
+                     {
+    uint64_t scale = 1;
+    int computed = (precision < FORMAT_FRACTION_DIGITS) ? precision : FORMAT_FRACTION_DIGITS;
+    for (int i = 0; i < computed; i++)
+        scale *= 10;
+
+    uint64_t integer = static_cast<uint64_t>(value);
+    uint64_t fraction = static_cast<uint64_t>((value - static_cast<double>(integer)) * scale + 0.5);
+    // Carry by the rounding.
+    if (fraction >= scale) {
+        fraction -= scale;
+        integer++;
+    }
+
+    char digits[24];
+    char *end = &digits[sizeof(digits)];
+    char *first = ToDigits(integer, 10, false, end);
+    int length = 0;
+
+    if (first == end)
+        body[length++] = '0';
+    while (first != end)
+        body[length++] = *first++;
+
+    if (precision > 0 || point)
+        body[length++] = '.';
+
+    // The fraction with the leading zeros.
+    first = ToDigits(fraction, 10, false, end);
+    for (int i = end - first; i < computed; i++)
+        body[length++] = '0';
+    while (first != end)
+        body[length++] = *first++;
+    for (int i = computed; i < precision; i++)
+        body[length++] = '0';
+
+    return length;
+}
+
+// Normalize value ( > 0 ) to [1, 10). Return the exponent.
+static int Normalize(double *value)
+                     {
+    int exponent = 0;
+
+    while (*value >= 1e8) {
+        *value /= 1e8;
+        exponent += 8;
+    }
+    while (*value >= 10) {
+        *value /= 10;
+        exponent++;
+    }
+    while (*value < 1e-8) {
+        *value *= 1e8;
+        exponent -= 8;
+    }
+    while (*value < 1) {
+        *value *= 10;
+        exponent--;
+    }
+
+    return exponent;
+}
+
+// Store the exponential representation of value ( >= 0 ) into body. Return the length.
+static int ExponentialBody(double value, int precision, bool point, bool upper, char *body)
+                           {
+    int exponent = 0;
+
+    if (value != 0)
+        exponent = Normalize(&value);
+
+    int length = FixedBody(value, precision, point, body);
+    // Rounding may make 9.99 to 10.00. Shift one digit.
+    if (length > 1 && body[0] == '1' && body[1] == '0') {
+        value /= 10;
+        exponent++;
+        length = FixedBody(value, precision, point, body);
+    }
+
+    body[length++] = upper ? 'E' : 'e';
+    body[length++] = (exponent < 0) ? '-' : '+';
+    if (exponent < 0)
+        exponent = -exponent;
+
+    char digits[8];
+    char *end = &digits[sizeof(digits)];
+    char *first = ToDigits(exponent, 10, false, end);
+    if (end - first < 2)
+        body[length++] = '0';
+    if (first == end)
+        body[length++] = '0';
+    while (first != end)
+        body[length++] = *first++;
+
+    return length;
+}
+
+// Remove the trailing zeros of the fraction, for %g.
+static int TrimZeros(char *body, int length)
+                     {
+    int point = -1;
+    int exponent = length;
+
+    for (int i = 0; i < length; i++) {
+        if (body[i] == '.')
+            point = i;
+        else if (body[i] == 'e' || body[i] == 'E') {
+            exponent = i;
+            break;
+        }
+    }
+    if (point < 0)
+        return length;
+
+    int last = exponent;
+    while (last > point + 1 && body[last - 1] == '0')
+        last--;
+    if (last == point + 1)
+        last = point;
+
+    // Move the exponent part.
+    int trimmed = last;
+    for (int i = exponent; i < length; i++)
+        body[trimmed++] = body[i];
+
+    return trimmed;
+}
+
+// Floating point conversions : f, F, e, E, g, G.
+static void PutDouble(FormatOutput *out, const FormatSpec &spec, const murasaki::FormatArg &arg)
+                      {
+    double value;
+
+    switch (arg.type) {
+        case murasaki::FormatArg::kDouble:
+            value = arg.value.d;
+            break;
+        case murasaki::FormatArg::kSigned:
+            value = static_cast<double>(arg.value.s);
+            break;
+        case murasaki::FormatArg::kUnsigned:
+            value = static_cast<double>(arg.value.u);
+            break;
+        default:
+            value = 0;
+            break;
+    }
+
+    bool upper = (spec.conversion == 'F' || spec.conversion == 'E' || spec.conversion == 'G');
+    bool negative = __builtin_signbit(value);
+    if (negative)
+        value = -value;
+
+    const char *prefix = negative ? "-" : (spec.plus ? "+" : (spec.space ? " " : ""));
+    char body[FORMAT_BODY_SIZE];
+    int length;
+
+    // nan and inf.
+    if (value != value || value > 1.7976931348623157e308) {
+        const char *text = (value != value) ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf");
+        PutField(out, spec, prefix, 0, text, 3, false);
+        return;
+    }
+
+    int precision = (spec.precision < 0) ? 6 : spec.precision;
+    if (precision > FORMAT_MAX_PRECISION)
+        precision = FORMAT_MAX_PRECISION;
+
+    switch (spec.conversion) {
+        case 'f':
+        case 'F':
+            // The integer part over 64bit can't be computed.
+            if (value < 1.8e19)
+                length = FixedBody(value, precision, spec.alt, body);
+            else
+                length = ExponentialBody(value, precision, spec.alt, upper, body);
+            break;
+        case 'e':
+        case 'E':
+            length = ExponentialBody(value, precision, spec.alt, upper, body);
+            break;
+        default: {
+            // %g : Choose the style by the exponent after the rounding.
+            int significant = (precision == 0) ? 1 : precision;
+            length = ExponentialBody(value, significant - 1, spec.alt, upper, body);
+
+            int exponent = 0;
+            int i = length - 1;
+            int weight = 1;
+            while (body[i] >= '0' && body[i] <= '9') {
+                exponent += (body[i] - '0') * weight;
+                weight *= 10;
+                i--;
+            }
+            if (body[i] == '-')
+                exponent = -exponent;
+
+            if (exponent >= -4 && exponent < significant && value < 1.8e19)
+                length = FixedBody(value, significant - 1 - exponent, spec.alt, body);
+            if (!spec.alt)
+                length = TrimZeros(body, length);
+            break;
+        }
+    }
+
+    PutField(out, spec, prefix, 0, body, length, spec.zero);
+}
+
+// String conversion.
+static void PutString(FormatOutput *out, const FormatSpec &spec, const char *str)
+                      {
+    if (str == nullptr)
+        str = "(null)";
+
+    int length = 0;
+    while (str[length] != '\0' && (spec.precision < 0 || length < spec.precision))
+        length++;
+
+    PutField(out, spec, "", 0, str, length, false);
+}
+
+unsigned int FormatString(char *buffer,
+                          unsigned int size,
+                          const char *format,
+                          const murasaki::FormatArg args[],
+                          unsigned int num_of_args)
+                          {
+    FormatOutput out = { buffer, size, 0 };
+    unsigned int index = 0;
+    const char *p = format;
+
+    if (size == 0)
+        return 0;
+
+    while (*p != '\0') {
+        if (*p != '%') {
+            out.Put(*p++);
+            continue;
+        }
+        p++;
+
+        FormatSpec spec = { false, false, false, false, false, 0, -1, '\0' };
+
+        // Flags.
+        for (;; p++) {
+            if (*p == '-')
+                spec.left = true;
+            else if (*p == '0')
+                spec.zero = true;
+            else if (*p == '+')
+                spec.plus = true;
+            else if (*p == ' ')
+                spec.space = true;
+            else if (*p == '#')
+                spec.alt = true;
+            else
+                break;
+        }
+
+        // Width.
+        if (*p == '*') {
+            p++;
+            if (index < num_of_args)
+                spec.width = static_cast<int>(args[index++].value.s);
+            if (spec.width < 0) {
+                spec.left = true;
+                spec.width = -spec.width;
+            }
+        }
+        else
+            while (*p >= '0' && *p <= '9')
+                spec.width = spec.width * 10 + (*p++ - '0');
+
+        // Precision.
+        if (*p == '.') {
+            p++;
+            spec.precision = 0;
+            if (*p == '*') {
+                p++;
+                if (index < num_of_args)
+                    spec.precision = static_cast<int>(args[index++].value.s);
+                if (spec.precision < 0)
+                    spec.precision = -1;
+            }
+            else
+                while (*p >= '0' && *p <= '9')
+                    spec.precision = spec.precision * 10 + (*p++ - '0');
+        }
+
+        // Length modifiers. The type is known by the argument.
+        while (*p == 'h' || *p == 'l' || *p == 'j' || *p == 'z' || *p == 't' || *p == 'L' || *p == 'q')
+            p++;
+
+        spec.conversion = *p;
+        if (spec.conversion == '\0')
+            break;
+        p++;
+
+        if (spec.conversion == '%') {
+            out.Put('%');
+            continue;
+        }
+
+        // Not enough arguments.
+        if (index >= num_of_args) {
+            out.Put('?');
+            continue;
+        }
+        const murasaki::FormatArg &arg = args[index++];
+
+        // %s for non string argument prints it by its own type.
+        if (spec.conversion == 's' && arg.type != murasaki::FormatArg::kString) {
+            switch (arg.type) {
+                case murasaki::FormatArg::kSigned:
+                    spec.conversion = 'd';
+                    break;
+                case murasaki::FormatArg::kUnsigned:
+                    spec.conversion = 'u';
+                    break;
+                case murasaki::FormatArg::kDouble:
+                    spec.conversion = 'g';
+                    break;
+                default:
+                    spec.conversion = 'p';
+                    break;
+            }
+            spec.precision = -1;
+        }
+
+        switch (spec.conversion) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                PutInteger(&out, spec, arg);
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+                PutDouble(&out, spec, arg);
+                break;
+            case 'c': {
+                char c = static_cast<char>(arg.value.u);
+                spec.precision = -1;
+                PutField(&out, spec, "", 0, &c, 1, false);
+                break;
+            }
+            case 's':
+                PutString(&out, spec, arg.value.str);
+                break;
+            case 'p':
+                // As same as newlib. "0x" and lower case hex.
+                spec.conversion = 'x';
+                spec.alt = false;
+                {
+                    FormatSpec hex = spec;
+                    char digits[24];
+                    char *end = &digits[sizeof(digits)];
+                    char *first = ToDigits(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(arg.value.ptr)), 16, false, end);
+                    if (first == end)
+                        *--first = '0';
+                    hex.precision = -1;
+                    PutField(&out, hex, "0x", 0, first, end - first, false);
+                }
+                break;
+            default:
+                // Unknown conversion. Print as is.
+                out.Put('%');
+                out.Put(spec.conversion);
+                break;
+        }
+    }
+
+    buffer[out.length] = '\0';
+    return out.length;
+}
+
+} /* namespace murasaki */
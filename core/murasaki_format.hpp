@@ -0,0 +1,166 @@
+/**
+ * @file murasaki_format.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Type-safe lightweight formatter.
+ * @details
+ * A printf() compatible formatter by the variadic template. The arguments are converted to the array of
+ * the @ref murasaki::FormatArg at the call site. So, the formatter knows the type of each argument, and
+ * never reads the wrong type from the va_list.
+ *
+ * Compared with the vsnprintf() of newlib, the formatter :
+ * @li doesn't allocate the heap.
+ * @li uses less than 600 bytes of the stack, plus the argument array.
+ * @li supports the floating point without linking the float support of the printf family.
+ *
+ * The supported conversions are d, i, u, o, x, X, c, s, p, f, F, e, E, g, G and %.
+ * The flags "-", "0", "+", " ", "#", the width, the precision and "*" are supported.
+ * The length modifiers ( hh, h, l, ll, j, z, t, L ) are accepted and ignored, because the type is known.
+ * The floating point is printed up to 9 digits below the decimal point. The rest is filled by 0.
+ *
+ * The stack usage was measured by the -fstack-usage of GCC 12 on the x86-64 host. The deepest call chain is
+ * FormatString(), PutDouble(), FixedBody() and ToDigits() for the "%f" conversion. It uses 336 bytes by -Os,
+ * 400 bytes by -O2, and 576 bytes by -O0. The 32bit Cortex-M target uses less, but check the .su file of
+ * the target build when the stack of the task is tight.
+ *
+ * Unlike the snprintf(), the return value is the number of the characters actually stored in the buffer.
+ * The length of the untruncated result is not returned. So, the truncation can't be detected by
+ * comparing the return value with the size of the buffer.
+ */
+
+#ifndef MURASAKI_FORMAT_HPP_
+#define MURASAKI_FORMAT_HPP_
+
+#include <stdint.h>
+#include <type_traits>
+
+namespace murasaki {
+
+/**
+ * @brief An argument of the formatter with its type.
+ * @details
+ * Created implicitly by @ref murasaki::Format() and the Debugger::Printf() template.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+struct FormatArg
+{
+    /**
+     * @brief Type of the argument.
+     */
+    enum Type
+    {
+        kNone = 0,      ///< No argument.
+        kSigned,        ///< Signed integer.
+        kUnsigned,      ///< Unsigned integer.
+        kDouble,        ///< Floating point.
+        kString,        ///< Null terminated string.
+        kPointer        ///< Pointer other than string.
+    };
+
+    /// Type of the argument.
+    Type type;
+    /// Size of the original integer type [byte]. Used to print the negative value by %u or %x.
+    unsigned char size;
+    /// Value of the argument.
+    union
+    {
+        int64_t s;
+        uint64_t u;
+        double d;
+        const char *str;
+        const void *ptr;
+    } value;
+
+    /// No argument. For the terminator.
+    FormatArg()
+            : type(kNone), size(0)
+    {
+        value.u = 0;
+    }
+
+    /// Signed integers, unsigned integers, bool and enums.
+    template<typename T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, int>::type = 0>
+    FormatArg(T arg)
+            : type(std::is_signed<T>::value ? kSigned : kUnsigned), size(sizeof(T))
+    {
+        if (std::is_signed<T>::value)
+            value.s = static_cast<int64_t>(arg);
+        else
+            value.u = static_cast<uint64_t>(arg);
+    }
+
+    /// Floating points.
+    template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    FormatArg(T arg)
+            : type(kDouble), size(sizeof(double))
+    {
+        value.d = arg;
+    }
+
+    /// Strings.
+    FormatArg(const char *arg)
+            : type(kString), size(sizeof(arg))
+    {
+        value.str = arg;
+    }
+
+    /// Null pointer.
+    FormatArg(decltype(nullptr) arg)
+            : type(kPointer), size(sizeof(void*))
+    {
+        value.ptr = arg;
+    }
+
+    /// Pointers other than string.
+    FormatArg(const volatile void *arg)
+            : type(kPointer), size(sizeof(arg))
+    {
+        value.ptr = const_cast<const void*>(arg);
+    }
+};
+
+/**
+ * @brief Format the string by the array of the arguments.
+ * @param buffer Buffer to store the formatted string.
+ * @param size Size of the buffer [byte]. The result is truncated to size - 1 characters, and terminated by null.
+ * @param format printf() compatible format.
+ * @param args Arguments.
+ * @param num_of_args Number of the arguments.
+ * @return Number of the characters stored in the buffer, except the terminating null. Not the untruncated length, unlike snprintf().
+ * @details
+ * Use @ref murasaki::Format() instead of calling this function directly.
+ *
+ * If the format requires more arguments than given, the conversion is printed as "?".
+ * This function is thread safe and re-entrant. Can be called from both task and ISR.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+unsigned int FormatString(char *buffer,
+                          unsigned int size,
+                          const char *format,
+                          const murasaki::FormatArg args[],
+                          unsigned int num_of_args);
+
+/**
+ * @brief Type-safe snprintf().
+ * @param buffer Buffer to store the formatted string.
+ * @param size Size of the buffer [byte]. The result is truncated to size - 1 characters, and terminated by null.
+ * @param format printf() compatible format.
+ * @param args Arguments.
+ * @return Number of the characters stored in the buffer, except the terminating null. Not the untruncated length, unlike snprintf().
+ * @details
+ * See @ref murasaki_format.hpp for the supported format.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+template<typename ... Args>
+inline unsigned int Format(char *buffer, unsigned int size, const char *format, Args ... args)
+                           {
+    // One more element to avoid the zero length array.
+    const murasaki::FormatArg arg_list[sizeof...(Args) + 1] = { murasaki::FormatArg(args)... };
+
+    return murasaki::FormatString(buffer, size, format, arg_list, sizeof...(Args));
+}
+
+} /* namespace murasaki */
+
+#endif /* MURASAKI_FORMAT_HPP_ */
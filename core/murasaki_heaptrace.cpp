@@ -0,0 +1,372 @@
+/*
+ * murasaki_heaptrace.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <string.h>
+
+#include "murasaki_heaptrace.hpp"
+#include "murasaki_defs.hpp"
+#include "murasaki_assert.hpp"
+#include "murasaki_utility.hpp"
+#include "debugger.hpp"
+
+#if MURASAKI_CONFIG_HEAP_TRACE
+
+struct HeapOwnerRecord;
+
+// Header in front of each allocation.
+struct HeapTraceHeader
+{
+    HeapTraceHeader *prev;      // Live list.
+    HeapTraceHeader *next;      // Live list.
+    HeapOwnerRecord *record;    // Owner of this allocation.
+    void *caller;               // Return address of the caller of the operator new.
+    uint32_t size;              // Requested size.
+    uint32_t magic;             // To detect the corruption and the double free.
+};
+
+// The header must keep the alignment of the memory given to the caller.
+static_assert(sizeof(HeapTraceHeader) % portBYTE_ALIGNMENT == 0, "Header must be multiple of portBYTE_ALIGNMENT");
+
+static constexpr uint32_t kHeapTraceMagic = 0x48454150;    // "HEAP"
+static constexpr uint32_t kHeapTraceFreed = 0x46524545;    // "FREE"
+
+// Longest owner name, including the null termination [byte].
+static constexpr unsigned int kHeapOwnerNameSize = 17;
+
+static_assert(PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX < configNUM_THREAD_LOCAL_STORAGE_POINTERS,
+              "PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX must be smaller than configNUM_THREAD_LOCAL_STORAGE_POINTERS");
+
+// Usage of an owner.
+struct HeapOwnerRecord
+{
+    // Copy of the name. The task name in the TCB is freed by the deletion of the task. Empty if not used.
+    char owner[kHeapOwnerNameSize];
+    uint32_t live_bytes;
+    uint32_t peak_bytes;
+    uint32_t allocations;
+};
+
+// The last record is shared by the owners over the table.
+static HeapOwnerRecord owner_records[PLATFORM_CONFIG_HEAP_TRACE_NUM_OF_OWNERS];
+static HeapTraceHeader *live_list = nullptr;
+static murasaki::HeapStatistics heap_statistics;
+
+// Next block to print by ReportHeapBlocks(). Moved to the next by HeapTraceDetach(), if the block is freed.
+static HeapTraceHeader *report_cursor = nullptr;
+static bool reporting = false;
+// Number of the blocks copied in a critical section by ReportHeapBlocks().
+static constexpr unsigned int kHeapReportBatch = 4;
+
+// Owner given by the HeapOwner before the scheduler starts. The owner in a task is kept in its thread local storage.
+static const char *boot_owner = nullptr;
+
+// nullptr before the scheduler starts.
+static TaskHandle_t CurrentTask()
+{
+    if (taskSCHEDULER_NOT_STARTED == ::xTaskGetSchedulerState())
+        return nullptr;
+    return ::xTaskGetCurrentTaskHandle();
+}
+
+// Owner given by the HeapOwner scope of the task. nullptr if out of the scope.
+static const char* ScopeOwner(TaskHandle_t task)
+                              {
+    if (nullptr == task)
+        return boot_owner;
+    else
+        return static_cast<const char*>(::pvTaskGetThreadLocalStoragePointer(task,
+                                                                            PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX));
+}
+
+static void SetScopeOwner(TaskHandle_t task, const char *owner)
+                          {
+    if (nullptr == task)
+        boot_owner = owner;
+    else
+        ::vTaskSetThreadLocalStoragePointer(task, PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX, const_cast<char*>(owner));
+}
+
+static const char* CurrentOwner()
+{
+    if (murasaki::IsInsideInterrupt())
+        return "ISR";
+
+    TaskHandle_t task = CurrentTask();
+    const char *owner = ScopeOwner(task);
+
+    if (nullptr != owner)
+        return owner;
+    else if (nullptr == task)
+        return "boot";
+    else
+        // Kept inside the TCB. Copied to the record.
+        return ::pcTaskGetName(task);
+}
+
+// Must be called inside critical section.
+static HeapOwnerRecord* FindOwnerRecord(const char *owner)
+                                        {
+    const unsigned int last = PLATFORM_CONFIG_HEAP_TRACE_NUM_OF_OWNERS - 1;
+
+    for (unsigned int i = 0; i < last; i++) {
+        if ('\0' == owner_records[i].owner[0]) {
+            ::strncpy(owner_records[i].owner, owner, kHeapOwnerNameSize - 1);
+            return &owner_records[i];
+        }
+        if (0 == ::strncmp(owner_records[i].owner, owner, kHeapOwnerNameSize - 1))
+            return &owner_records[i];
+    }
+    ::strncpy(owner_records[last].owner, "others", kHeapOwnerNameSize - 1);
+    return &owner_records[last];
+}
+
+murasaki::HeapOwner::HeapOwner(const char *owner)
+        : previous_owner_(ScopeOwner(CurrentTask())),
+          task_(CurrentTask())
+{
+    MURASAKI_ASSERT(nullptr != owner)
+    MURASAKI_ASSERT(!murasaki::IsInsideInterrupt());
+
+    SetScopeOwner(task_, owner);
+}
+
+murasaki::HeapOwner::~HeapOwner()
+{
+    // The scope must be closed by the task which opened it.
+    MURASAKI_ASSERT(task_ == CurrentTask())
+
+    SetScopeOwner(task_, previous_owner_);
+}
+
+std::size_t murasaki::HeapTraceHeaderSize()
+{
+    return sizeof(HeapTraceHeader);
+}
+
+void* murasaki::HeapTraceAttach(void *raw, std::size_t size, void *caller)
+                                {
+    const char *owner = CurrentOwner();
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    if (nullptr == raw) {
+        heap_statistics.failures++;
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+        return nullptr;
+    }
+
+    HeapOwnerRecord *record = FindOwnerRecord(owner);
+    HeapTraceHeader *header = static_cast<HeapTraceHeader*>(raw);
+    header->record = record;
+    header->caller = caller;
+    header->size = size;
+    header->magic = kHeapTraceMagic;
+
+    // Link at the top of the live list.
+    header->prev = nullptr;
+    header->next = live_list;
+    if (nullptr != live_list)
+        live_list->prev = header;
+    live_list = header;
+
+    heap_statistics.live_bytes += size;
+    if (heap_statistics.peak_bytes < heap_statistics.live_bytes)
+        heap_statistics.peak_bytes = heap_statistics.live_bytes;
+    heap_statistics.allocations++;
+
+    record->live_bytes += size;
+    if (record->peak_bytes < record->live_bytes)
+        record->peak_bytes = record->live_bytes;
+    record->allocations++;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    return header + 1;
+}
+
+void* murasaki::HeapTraceDetach(void *ptr)
+                                {
+    HeapTraceHeader *header = static_cast<HeapTraceHeader*>(ptr) - 1;
+
+    // Not allocated by the operator new, broken or freed twice.
+    MURASAKI_ASSERT(kHeapTraceMagic == header->magic)
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        if (nullptr != header->prev)
+            header->prev->next = header->next;
+        else
+            live_list = header->next;
+        if (nullptr != header->next)
+            header->next->prev = header->prev;
+        if (report_cursor == header)
+            report_cursor = header->next;
+        header->magic = kHeapTraceFreed;
+
+        heap_statistics.live_bytes -= header->size;
+        heap_statistics.frees++;
+        header->record->live_bytes -= header->size;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    return header;
+}
+
+void murasaki::GetHeapStatistics(murasaki::HeapStatistics *stats)
+                                 {
+    MURASAKI_ASSERT(nullptr != stats)
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    *stats = heap_statistics;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+// Print the live blocks. A few blocks are copied in each critical section, because they may be freed
+// while printing. The cursor is kept valid by HeapTraceDetach(). So, each critical section is short, and
+// the list is walked once. The blocks allocated while printing are not listed.
+static void ReportHeapBlocks()
+{
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        // Only one task can list at a time.
+        MURASAKI_ASSERT(!reporting)
+        reporting = true;
+        report_cursor = live_list;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    murasaki::debugger->Printf("Address    | Size [byte] | Owner            | Caller\n");
+    murasaki::debugger->Printf("-----------+-------------+------------------+-----------\n");
+
+    bool done = false;
+    while (!done) {
+        HeapTraceHeader copies[kHeapReportBatch];
+        char owners[kHeapReportBatch][kHeapOwnerNameSize];
+        void *addresses[kHeapReportBatch];
+        unsigned int num_of_copies = 0;
+
+        saved = taskENTER_CRITICAL_FROM_ISR();
+        {
+            for (; num_of_copies < kHeapReportBatch && nullptr != report_cursor; num_of_copies++) {
+                copies[num_of_copies] = *report_cursor;
+                ::memcpy(owners[num_of_copies], report_cursor->record->owner, kHeapOwnerNameSize);
+                addresses[num_of_copies] = report_cursor + 1;    // The address given to the caller.
+                report_cursor = report_cursor->next;
+            }
+            done = (nullptr == report_cursor);
+            if (done)
+                reporting = false;
+        }
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+
+        for (unsigned int i = 0; i < num_of_copies; i++)
+            murasaki::debugger->Printf("%p | %11u | %-16s | %p\n",
+                                       addresses[i],
+                                       static_cast<unsigned int>(copies[i].size),
+                                       owners[i],
+                                       copies[i].caller);
+    }
+}
+
+#else
+
+murasaki::HeapOwner::HeapOwner(const char *owner)
+        : previous_owner_(nullptr),
+          task_(nullptr)
+{
+}
+
+murasaki::HeapOwner::~HeapOwner()
+{
+}
+
+std::size_t murasaki::HeapTraceHeaderSize()
+{
+    return 0;
+}
+
+void* murasaki::HeapTraceAttach(void *raw, std::size_t size, void *caller)
+                                {
+    return raw;
+}
+
+void* murasaki::HeapTraceDetach(void *ptr)
+                                {
+    return ptr;
+}
+
+void murasaki::GetHeapStatistics(murasaki::HeapStatistics *stats)
+                                 {
+    MURASAKI_ASSERT(nullptr != stats)
+
+    ::memset(stats, 0, sizeof(*stats));
+}
+
+#endif
+
+void murasaki::ReportHeapUsage(bool list_blocks)
+                               {
+    murasaki::debugger->Printf("\n            Heap usage\n");
+
+#if MURASAKI_CONFIG_HEAP_TRACE
+    murasaki::HeapStatistics stats;
+    HeapOwnerRecord records[PLATFORM_CONFIG_HEAP_TRACE_NUM_OF_OWNERS];
+
+    // Take a snapshot.
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        stats = heap_statistics;
+        ::memcpy(records, owner_records, sizeof(records));
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    murasaki::debugger->Printf("Live %u bytes, Peak %u bytes, %u allocations, %u frees, %u failures\n",
+                               static_cast<unsigned int>(stats.live_bytes),
+                               static_cast<unsigned int>(stats.peak_bytes),
+                               static_cast<unsigned int>(stats.allocations),
+                               static_cast<unsigned int>(stats.frees),
+                               static_cast<unsigned int>(stats.failures));
+    murasaki::debugger->Printf("Owner            | Live [byte] | Peak [byte] | Allocations\n");
+    murasaki::debugger->Printf("-----------------+-------------+-------------+------------\n");
+    for (unsigned int i = 0; i < PLATFORM_CONFIG_HEAP_TRACE_NUM_OF_OWNERS; i++)
+        if ('\0' != records[i].owner[0])
+            murasaki::debugger->Printf("%-16s | %11u | %11u | %11u\n",
+                                       records[i].owner,
+                                       static_cast<unsigned int>(records[i].live_bytes),
+                                       static_cast<unsigned int>(records[i].peak_bytes),
+                                       static_cast<unsigned int>(records[i].allocations));
+#else
+    murasaki::debugger->Printf("Heap trace is not enabled. See MURASAKI_CONFIG_HEAP_TRACE\n");
+#endif
+
+#if MURASAKI_CONFIG_STATIC_ALLOCATION
+    // No free in the static arena. So, no fragmentation.
+    murasaki::debugger->Printf("Static arena %u / %u bytes used\n",
+                               murasaki::GetStaticArenaUsage(),
+                               static_cast<unsigned int>(PLATFORM_CONFIG_STATIC_ARENA_SIZE));
+#elif PLATFORM_CONFIG_FREERTOS_HEAP_STATS
+    HeapStats_t heap;
+    ::vPortGetHeapStats(&heap);
+
+    unsigned int fragmentation =
+            (0 == heap.xAvailableHeapSpaceInBytes) ?
+                    0 : 100 - heap.xSizeOfLargestFreeBlockInBytes * 100 / heap.xAvailableHeapSpaceInBytes;
+    murasaki::debugger->Printf("FreeRTOS heap : %u bytes free in %u blocks, largest %u bytes, minimum ever %u bytes\n",
+                               static_cast<unsigned int>(heap.xAvailableHeapSpaceInBytes),
+                               static_cast<unsigned int>(heap.xNumberOfFreeBlocks),
+                               static_cast<unsigned int>(heap.xSizeOfLargestFreeBlockInBytes),
+                               static_cast<unsigned int>(heap.xMinimumEverFreeBytesRemaining));
+    murasaki::debugger->Printf("Fragmentation : %u%%\n", fragmentation);
+#else
+    // No statistics in this FreeRTOS or heap implementation.
+    murasaki::debugger->Printf("FreeRTOS heap : %u bytes free\n",
+                               static_cast<unsigned int>(::xPortGetFreeHeapSize()));
+#endif
+
+#if MURASAKI_CONFIG_HEAP_TRACE
+    if (list_blocks)
+        ReportHeapBlocks();
+#endif
+}
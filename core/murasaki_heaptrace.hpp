@@ -0,0 +1,132 @@
+/**
+ * @file murasaki_heaptrace.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Accounting of the heap usage by the owners.
+ * @details
+ * If the @ref MURASAKI_CONFIG_HEAP_TRACE is true, the operator new adds a small header to each allocation.
+ * The header keeps the size, the return address of the caller and the owner of the memory. The live
+ * allocations are linked through these headers. So, murasaki::ReportHeapUsage() can tell who allocated what.
+ *
+ * The owner is given by the murasaki::HeapOwner in a scope :
+ * @code
+ *     {
+ *         murasaki::HeapOwner owner("Audio");
+ *         murasaki::platform.audio = new murasaki::DuplexAudio(...);   // Including the allocation inside.
+ *     }
+ * @endcode
+ * Out of the scope, the owner is the name of the current task. "boot" is used before the scheduler starts,
+ * and "ISR" is used in the interrupt.
+ */
+
+#ifndef MURASAKI_HEAPTRACE_HPP_
+#define MURASAKI_HEAPTRACE_HPP_
+
+#include <cstddef>
+#include <stdint.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "murasaki_config.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Statistics of the heap usage through the operator new.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+struct HeapStatistics
+{
+    uint32_t live_bytes;        ///< Bytes allocated and not freed yet. Not including the headers.
+    uint32_t peak_bytes;        ///< Maximum of the live_bytes.
+    uint32_t allocations;       ///< Count of the successful allocation.
+    uint32_t frees;             ///< Count of the free.
+    uint32_t failures;          ///< Count of the failed allocation.
+};
+
+/**
+ * @brief Set the owner of the allocations in the scope.
+ * @details
+ * The owner is applied to the allocations by the task which created this object. The allocations by the
+ * other tasks are owned by their own scope or their task name. The scope can be nested in a task.
+ *
+ * The scope is kept in the thread local storage of the task, at @ref PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX.
+ * Create and destroy the object in the same task. Usually, as a local variable.
+ *
+ * The owner string must be kept during the scope. The name is copied to the report up to 16 characters.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+class HeapOwner
+{
+ public:
+    /**
+     * @brief Start the scope.
+     * @param owner Name of the owner.
+     */
+    explicit HeapOwner(const char *owner);
+    /**
+     * @brief End the scope. The previous owner is restored.
+     */
+    ~HeapOwner();
+    HeapOwner(const HeapOwner&) = delete;
+    HeapOwner& operator=(const HeapOwner&) = delete;
+ private:
+    const char *const previous_owner_;
+    const TaskHandle_t task_;
+};
+
+/**
+ * @brief Size of the header added to each allocation.
+ * @return Size [byte]. 0 if the @ref MURASAKI_CONFIG_HEAP_TRACE is false.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+std::size_t HeapTraceHeaderSize();
+
+/**
+ * @brief Fill the header of the allocated memory.
+ * @param raw The memory allocated with the header. nullptr if the allocation failed.
+ * @param size Size requested by the caller [byte]
+ * @param caller Return address of the caller of the operator new.
+ * @return The memory for the caller, after the header. nullptr if raw is nullptr.
+ * @details
+ * Called from the operator new. This function can be called from both task and ISR.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+void* HeapTraceAttach(void *raw, std::size_t size, void *caller);
+
+/**
+ * @brief Remove the header of the memory to free.
+ * @param ptr The memory given to the caller.
+ * @return The memory allocated with the header.
+ * @details
+ * Called from the operator delete. This function can be called from both task and ISR.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+void* HeapTraceDetach(void *ptr);
+
+/**
+ * @brief Get the statistics of the heap usage.
+ * @param stats Pointer to the variable to receive.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+void GetHeapStatistics(murasaki::HeapStatistics *stats);
+
+/**
+ * @brief Print the heap usage through the debugger.
+ * @param list_blocks If true, each live allocation is printed with its size, owner and the caller address.
+ * @details
+ * Print the statistics, the usage of each owner, and the fragmentation of the FreeRTOS heap.
+ * The fragmentation is 100 - ( largest free block ) * 100 / ( total free bytes ) [%].
+ * It is taken from vPortGetHeapStats(). So, the heap_4.c or the heap_5.c is needed. Otherwise, only the free
+ * size is printed. See @ref PLATFORM_CONFIG_FREERTOS_HEAP_STATS.
+ *
+ * Only one task can call this function with the list_blocks true at a time.
+ *
+ * The caller address can be resolved by the addr2line command.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+void ReportHeapUsage(bool list_blocks = false);
+
+} /* namespace murasaki */
+
+#endif /* MURASAKI_HEAPTRACE_HPP_ */
@@ -0,0 +1,191 @@
+/*
+ * murasaki_pool.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <stdint.h>
+#include <FreeRTOS.h>
+
+#include "murasaki_pool.hpp"
+#include "murasaki_atomic.hpp"
+#include "murasaki_assert.hpp"
+#include "debugger.hpp"
+
+#if MURASAKI_CONFIG_POOL_ALLOCATOR
+
+#if __cplusplus < 201402L
+#error "MURASAKI_CONFIG_POOL_ALLOCATOR needs C++14 or later"
+#endif
+
+// Size and number of the blocks of each class.
+static constexpr unsigned int kBlockSizes[] = PLATFORM_CONFIG_POOL_BLOCK_SIZES;
+static constexpr unsigned int kNumOfBlocks[] = PLATFORM_CONFIG_POOL_NUM_OF_BLOCKS;
+static constexpr unsigned int kNumOfClasses = sizeof(kBlockSizes) / sizeof(kBlockSizes[0]);
+
+// Offset of the class in the storage.
+static constexpr std::size_t ClassOffset(unsigned int size_class)
+                                         {
+    std::size_t offset = 0;
+    for (unsigned int i = 0; i < size_class; i++)
+        offset += static_cast<std::size_t>(kBlockSizes[i]) * kNumOfBlocks[i];
+    return offset;
+}
+
+// The block size must keep the alignment of the next block.
+static constexpr bool IsValidClasses()
+{
+    for (unsigned int i = 0; i < kNumOfClasses; i++) {
+        if (kBlockSizes[i] % portBYTE_ALIGNMENT != 0 || 0xFFFF <= kNumOfBlocks[i])
+            return false;
+        if (i > 0 && kBlockSizes[i] <= kBlockSizes[i - 1])
+            return false;
+    }
+    return true;
+}
+
+static_assert(sizeof(kNumOfBlocks) / sizeof(kNumOfBlocks[0]) == kNumOfClasses,
+              "PLATFORM_CONFIG_POOL_BLOCK_SIZES and PLATFORM_CONFIG_POOL_NUM_OF_BLOCKS must have same length");
+static_assert(IsValidClasses(),
+              "Block sizes must be ascending multiples of portBYTE_ALIGNMENT. Number of blocks must be less than 65535");
+
+// All blocks of all classes.
+static uint8_t pool_storage[ClassOffset(kNumOfClasses)] __attribute__((aligned(portBYTE_ALIGNMENT)));
+
+// Head of the free list of each class. The lower 16bits are the index + 1 of the first free block. 0 means empty.
+// The upper 16bits are the tag, incremented by every update. So, the compare and swap fails if the other context
+// pops and pushes back the same block in between.
+//
+// All variables are zero initialized. So, the pool is ready before any constructor of the static objects.
+static volatile uint32_t free_head[kNumOfClasses];
+// Blocks never allocated start from this index. Used when the free list is empty.
+static volatile uint32_t next_unused[kNumOfClasses];
+
+// Statistics.
+static volatile uint32_t in_use[kNumOfClasses];
+static volatile uint32_t peak[kNumOfClasses];
+static volatile uint32_t exhausted[kNumOfClasses];
+static volatile uint32_t too_large;
+
+static inline uint8_t* BlockAddress(unsigned int size_class, uint32_t index)
+                                    {
+    return &pool_storage[ClassOffset(size_class) + static_cast<std::size_t>(index) * kBlockSizes[size_class]];
+}
+
+// The link to the next free block is stored at the top of the free block.
+static inline volatile uint32_t* LinkOf(uint8_t *block)
+                                        {
+    return reinterpret_cast<volatile uint32_t*>(block);
+}
+
+static void UpdateStatistics(unsigned int size_class)
+                             {
+    uint32_t current;
+
+    // Increment and keep the peak.
+    do {
+        current = murasaki::AtomicLoad(&in_use[size_class]);
+    } while (!murasaki::AtomicCompareAndSwap(&in_use[size_class], current, current + 1));
+
+    uint32_t last_peak;
+    do {
+        last_peak = murasaki::AtomicLoad(&peak[size_class]);
+    } while (last_peak < current + 1 && !murasaki::AtomicCompareAndSwap(&peak[size_class], last_peak, current + 1));
+}
+
+void* murasaki::PoolAllocate(std::size_t size)
+                             {
+    // Search the smallest class.
+    unsigned int size_class = 0;
+    while (size_class < kNumOfClasses && kBlockSizes[size_class] < size)
+        size_class++;
+
+    if (size_class == kNumOfClasses) {
+        murasaki::AtomicAdd(&too_large, 1);
+        return nullptr;
+    }
+
+    // Pop from the free list.
+    uint32_t head, link;
+    do {
+        head = murasaki::AtomicLoad(&free_head[size_class]);
+        link = head & 0xFFFF;
+        if (0 == link)
+            break;
+        // The block may be taken by the other context here. Then, the next is garbage, but the CAS fails.
+        uint32_t next = *LinkOf(BlockAddress(size_class, link - 1));
+        if (murasaki::AtomicCompareAndSwap(&free_head[size_class], head, ((head + 0x10000) & 0xFFFF0000) | next))
+            break;
+    } while (true);
+
+    uint32_t index;
+    if (0 != link)
+        index = link - 1;
+    else {
+        // Free list is empty. Take a never used block.
+        do {
+            index = murasaki::AtomicLoad(&next_unused[size_class]);
+            if (index >= kNumOfBlocks[size_class]) {
+                murasaki::AtomicAdd(&exhausted[size_class], 1);
+                return nullptr;
+            }
+        } while (!murasaki::AtomicCompareAndSwap(&next_unused[size_class], index, index + 1));
+    }
+
+    UpdateStatistics(size_class);
+    return BlockAddress(size_class, index);
+}
+
+bool murasaki::PoolFree(void *ptr)
+                        {
+    uint8_t *const block = static_cast<uint8_t*>(ptr);
+
+    if (block < &pool_storage[0] || &pool_storage[sizeof(pool_storage)] <= block)
+        return false;
+
+    // Search the class.
+    std::size_t offset = block - &pool_storage[0];
+    unsigned int size_class = 0;
+    while (ClassOffset(size_class + 1) <= offset)
+        size_class++;
+
+    std::size_t class_offset = offset - ClassOffset(size_class);
+    MURASAKI_ASSERT(0 == class_offset % kBlockSizes[size_class])  // must be the top of the block.
+    uint32_t index = class_offset / kBlockSizes[size_class];
+
+    // Push to the free list.
+    uint32_t head;
+    do {
+        head = murasaki::AtomicLoad(&free_head[size_class]);
+        *LinkOf(block) = head & 0xFFFF;
+    } while (!murasaki::AtomicCompareAndSwap(&free_head[size_class], head, ((head + 0x10000) & 0xFFFF0000) | (index + 1)));
+
+    murasaki::AtomicAdd(&in_use[size_class], static_cast<uint32_t>(-1));
+
+    return true;
+}
+
+void murasaki::ReportPoolAllocator()
+{
+    murasaki::debugger->Printf("\n            Pool allocator\n");
+    murasaki::debugger->Printf("Size [byte] |   Blocks |   In use |     Peak | Exhausted\n");
+    murasaki::debugger->Printf("------------+----------+----------+----------+----------\n");
+    for (unsigned int i = 0; i < kNumOfClasses; i++)
+        murasaki::debugger->Printf("%11u | %8u | %8u | %8u | %9u\n",
+                                   kBlockSizes[i],
+                                   kNumOfBlocks[i],
+                                   static_cast<unsigned int>(in_use[i]),
+                                   static_cast<unsigned int>(peak[i]),
+                                   static_cast<unsigned int>(exhausted[i]));
+    murasaki::debugger->Printf("Larger than the largest class : %u\n", static_cast<unsigned int>(too_large));
+}
+
+#else
+
+void murasaki::ReportPoolAllocator()
+{
+    murasaki::debugger->Printf("Pool allocator is not enabled. See MURASAKI_CONFIG_POOL_ALLOCATOR\n");
+}
+
+#endif
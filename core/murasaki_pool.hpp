@@ -0,0 +1,62 @@
+/**
+ * @file murasaki_pool.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Size-class pool allocator behind the operator new.
+ * @details
+ * The memory is divided into the size classes given by @ref PLATFORM_CONFIG_POOL_BLOCK_SIZES. Each class
+ * is a set of the fixed size blocks. The allocation takes the smallest class which can hold the requested size.
+ *
+ * The free blocks of each class are linked as a lock-free stack. The head of the stack is updated by the
+ * compare and swap, with a tag to avoid the ABA problem. So, both the allocation and the free are O(1), and
+ * can be called from both task and ISR.
+ *
+ * The requests larger than the largest class, or the requests to the exhausted class, fall back to the
+ * FreeRTOS heap ( or the static arena ). These are not allowed in ISR.
+ *
+ * See @ref MURASAKI_CONFIG_POOL_ALLOCATOR.
+ */
+
+#ifndef MURASAKI_POOL_HPP_
+#define MURASAKI_POOL_HPP_
+
+#include <cstddef>
+#include "murasaki_config.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Allocate a block from the pool.
+ * @param size Size of the memory to allocate [byte]
+ * @return Allocated block. nullptr if the size is too large or the class is exhausted.
+ * @details
+ * This function can be called from both task and ISR.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+void* PoolAllocate(std::size_t size);
+
+/**
+ * @brief Return a block to the pool.
+ * @param ptr Pointer to the memory to deallocate.
+ * @return true if the ptr was allocated from the pool. false if the ptr is not in the pool.
+ * @details
+ * This function can be called from both task and ISR.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+bool PoolFree(void *ptr);
+
+/**
+ * @brief Print the statistics of the pool allocator.
+ * @details
+ * For each size class, the number of blocks, the blocks in use, the peak and the count of the exhausted
+ * requests are printed. The count of the fall back to the heap is printed too.
+ *
+ * Use this report to tune the @ref PLATFORM_CONFIG_POOL_NUM_OF_BLOCKS.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+void ReportPoolAllocator();
+
+} /* namespace murasaki */
+
+#endif /* MURASAKI_POOL_HPP_ */
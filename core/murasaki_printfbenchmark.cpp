@@ -0,0 +1,208 @@
+/*
+ * murasaki_printfbenchmark.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <algorithm>
+
+#include "murasaki.hpp"
+
+// Format a typical syslog line.
+#define BENCHMARK_FORMAT(line, count) ::snprintf(line, sizeof(line) - 1,\
+    "%10u, %p, %s, %s: %s, line %4d, %s(): %s %d\n",\
+    count, line, "kfaAudio", "kseWarning", "duplexaudio.cpp", 123, "TransmitAndReceive", "Benchmark", count)
+
+void murasaki::PrintfLatencyBenchmark(unsigned int iterations)
+                                      {
+    char line[PLATFORM_CONFIG_DEBUG_LINE_SIZE];
+    uint8_t drain[PLATFORM_CONFIG_DEBUG_LINE_SIZE];
+    murasaki::FifoStrategy *old_fifo = new murasaki::FifoStrategy(1024);
+    murasaki::LockFreeFifo *new_fifo = new murasaki::LockFreeFifo(1024);
+    unsigned int old_total = 0, old_masked = 0, new_total = 0;
+
+    MURASAKI_ASSERT(nullptr != old_fifo)
+    MURASAKI_ASSERT(nullptr != new_fifo)
+    MURASAKI_ASSERT(0 < iterations)
+
+    for (unsigned int count = 0; count < iterations; count++) {
+        unsigned int start, masked_start, masked_end, end;
+
+        // Old way. Everything is in the critical section.
+        start = murasaki::GetCycleCounter();
+        {
+            UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+            masked_start = murasaki::GetCycleCounter();
+            BENCHMARK_FORMAT(line, count);
+            old_fifo->Put(reinterpret_cast<uint8_t*>(line), ::strlen(line));
+            masked_end = murasaki::GetCycleCounter();
+            taskEXIT_CRITICAL_FROM_ISR(saved);
+        }
+        end = murasaki::GetCycleCounter();
+        old_total = std::max(old_total, end - start);
+        old_masked = std::max(old_masked, masked_end - masked_start);
+
+        // Current way. No critical section. The lock-free FIFO masks the interrupts only during the
+        // compare and swap on Cortex-M0/M0+/M1. On the other CPU, there is no masked region.
+        start = murasaki::GetCycleCounter();
+        {
+            BENCHMARK_FORMAT(line, count);
+            new_fifo->Put(reinterpret_cast<uint8_t*>(line), ::strlen(line));
+        }
+        end = murasaki::GetCycleCounter();
+        new_total = std::max(new_total, end - start);
+
+        // Drain the FIFOs. Not measured.
+        while (old_fifo->Get(drain, sizeof(drain)) != 0)
+            ;
+        while (new_fifo->Get(drain, sizeof(drain)) != 0)
+            ;
+    }
+
+    murasaki::debugger->Printf("\n            Printf interrupt latency benchmark\n");
+    murasaki::debugger->Printf("Worst case of %d iterations\n", iterations);
+    murasaki::debugger->Printf("Path                        | Total [cycle] | Interrupt masked [cycle]\n");
+    murasaki::debugger->Printf("----------------------------+---------------+-------------------------\n");
+    murasaki::debugger->Printf("Format in critical section  | %13d | %24d\n", old_total, old_masked);
+    murasaki::debugger->Printf("Format with interrupts on   | %13d | %24s\n", new_total, "-");
+    // Not measured. The masked region is inside the LockFreeFifo::Put(), and can't be timed from here.
+    murasaki::debugger->Printf("The masked cycles of the lock-free path is not measured. By design, it is 0 on the ARMv7-M or later.\n");
+    murasaki::debugger->Printf("On the Cortex-M0/M0+/M1, each compare and swap of the FIFO masks the interrupts for a few instructions.\n");
+    murasaki::debugger->Printf("murasaki::debugger, emergency line since start up : %d [cycle]\n",
+                               murasaki::debugger->GetMaxMaskedCycles());
+
+    delete old_fifo;
+    delete new_fifo;
+}
+
+// Same path as the Debugger::Printf() without MURASAKI_CONFIG_LIGHT_PRINTF.
+static void BenchmarkVsnprintf(char *line, unsigned int size, const char *fmt, ...)
+                               {
+    va_list argp;
+
+    ::va_start(argp, fmt);
+    ::vsnprintf(line, size, fmt, argp);
+    ::va_end(argp);
+}
+
+// Measure one format by both formatters. Return the average cycles.
+#define BENCHMARK_FORMATTER(result_vsnprintf, result_format, ...)\
+    {\
+        unsigned int start = murasaki::GetCycleCounter();\
+        for (unsigned int count = 0; count < iterations; count++)\
+            BenchmarkVsnprintf(line, sizeof(line) - 1, __VA_ARGS__);\
+        result_vsnprintf = (murasaki::GetCycleCounter() - start) / iterations;\
+        start = murasaki::GetCycleCounter();\
+        for (unsigned int count = 0; count < iterations; count++)\
+            murasaki::Format(line, sizeof(line) - 1, __VA_ARGS__);\
+        result_format = (murasaki::GetCycleCounter() - start) / iterations;\
+    }
+
+void murasaki::FormatBenchmark(unsigned int iterations)
+                               {
+    char line[PLATFORM_CONFIG_DEBUG_LINE_SIZE];
+    unsigned int syslog_vsnprintf, syslog_format, integer_vsnprintf, integer_format;
+
+    MURASAKI_ASSERT(0 < iterations)
+
+    BENCHMARK_FORMATTER(syslog_vsnprintf, syslog_format,
+                        "%10u, %p, %s, %s: %s, line %4d, %s(): %s %d\n",
+                        iterations, line, "kfaAudio", "kseWarning", "duplexaudio.cpp", 123, "TransmitAndReceive",
+                        "Benchmark", iterations)
+    BENCHMARK_FORMATTER(integer_vsnprintf, integer_format,
+                        "%d %u %08x %-6d %X\n",
+                        -12345, 4000000000u, 0xCAFEu, 42, 0xBEEFu)
+
+    murasaki::debugger->Printf("\n            Formatter benchmark\n");
+    murasaki::debugger->Printf("Average of %d iterations\n", iterations);
+    murasaki::debugger->Printf("Format           | vsnprintf() [cycle] | murasaki::Format() [cycle]\n");
+    murasaki::debugger->Printf("-----------------+---------------------+---------------------------\n");
+    murasaki::debugger->Printf("Syslog line      | %19d | %26d\n", syslog_vsnprintf, syslog_format);
+    murasaki::debugger->Printf("Integer and hex  | %19d | %26d\n", integer_vsnprintf, integer_format);
+}
+
+// Expose the packing of the telemetry to measure.
+class BenchmarkTelemetry : public murasaki::Telemetry
+{
+ public:
+    BenchmarkTelemetry()
+            : Telemetry(1000)
+    {
+    }
+    unsigned int Pack(const uint32_t **frame)
+                      {
+        *frame = frame_;
+        return PackData();
+    }
+};
+
+void murasaki::TelemetryBenchmark(unsigned int iterations)
+                                  {
+    char line[PLATFORM_CONFIG_DEBUG_LINE_SIZE];
+    uint8_t drain[PLATFORM_CONFIG_DEBUG_LINE_SIZE];
+    // Typical 4 variables of the audio application.
+    volatile int16_t level = -1234, position = 5678, left = -32000, right = 42;
+    murasaki::LockFreeFifo *fifo = new murasaki::LockFreeFifo(1024);
+    BenchmarkTelemetry *telemetry = new BenchmarkTelemetry();
+    unsigned int text_cycles = 0, text_bytes = 0, telemetry_cycles = 0, telemetry_bytes = 0;
+
+    MURASAKI_ASSERT(nullptr != fifo)
+    MURASAKI_ASSERT(nullptr != telemetry)
+    MURASAKI_ASSERT(0 < iterations)
+
+    // Not started. So, the telemetry task sends nothing.
+    telemetry->Register("level", &level);
+    telemetry->Register("position", &position);
+    telemetry->Register("left", &left);
+    telemetry->Register("right", &right);
+
+    for (unsigned int count = 0; count < iterations; count++) {
+        unsigned int start;
+
+        // Text by the same formatter with the Printf(), with the timestamp as the telemetry.
+        start = murasaki::GetCycleCounter();
+        {
+#if MURASAKI_CONFIG_LIGHT_PRINTF
+            murasaki::Format(line, sizeof(line) - 1, "%u,%d,%d,%d,%d\n",
+                             static_cast<unsigned int>(murasaki::GetTimebaseTicks()), level, position, left, right);
+#else
+            BenchmarkVsnprintf(line, sizeof(line) - 1, "%u,%d,%d,%d,%d\n",
+                               static_cast<unsigned int>(murasaki::GetTimebaseTicks()), level, position, left, right);
+#endif
+            fifo->Put(reinterpret_cast<uint8_t*>(line), ::strlen(line));
+        }
+        text_cycles += murasaki::GetCycleCounter() - start;
+        text_bytes += ::strlen(line);
+        while (fifo->Get(drain, sizeof(drain)) != 0)
+            ;
+
+        // Data frame with the header of the PutDeferredLog().
+        start = murasaki::GetCycleCounter();
+        {
+            const uint32_t *frame;
+            unsigned int num_of_words = telemetry->Pack(&frame);
+            const uint8_t header[2] = { 0, static_cast<uint8_t>(num_of_words) };
+
+            fifo->Put(header, sizeof(header));
+            fifo->Put(reinterpret_cast<const uint8_t*>(frame), num_of_words * sizeof(uint32_t));
+            telemetry_bytes += sizeof(header) + num_of_words * sizeof(uint32_t);
+        }
+        telemetry_cycles += murasaki::GetCycleCounter() - start;
+        while (fifo->Get(drain, sizeof(drain)) != 0)
+            ;
+    }
+
+    murasaki::debugger->Printf("\n            Telemetry benchmark\n");
+    murasaki::debugger->Printf("Average of %d samples of 4 int16_t variables\n", iterations);
+    murasaki::debugger->Printf("Path             | CPU [cycle] | Link [byte]\n");
+    murasaki::debugger->Printf("-----------------+-------------+------------\n");
+    murasaki::debugger->Printf("Text by Printf   | %11u | %11u\n", text_cycles / iterations, text_bytes / iterations);
+    murasaki::debugger->Printf("Telemetry frame  | %11u | %11u\n", telemetry_cycles / iterations,
+                               telemetry_bytes / iterations);
+
+    delete telemetry;
+    delete fifo;
+}
@@ -0,0 +1,138 @@
+/*
+ * murasaki_syncbenchmark.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <algorithm>
+
+#include "murasaki.hpp"
+
+// Shared between the measuring task and the waiting task.
+template<typename T>
+struct SyncBenchmarkContext
+{
+    T *sync;                            // Synchronizer to measure.
+    murasaki::Synchronizer *ack;        // The waiting task is ready again.
+    volatile unsigned int woken_at;     // Cycle counter at the wake up.
+};
+
+// The waiting task. Record the time to wake up.
+template<typename T>
+static void SyncBenchmarkTaskBody(const void *ptr)
+                                  {
+    const SyncBenchmarkContext<T> *context = static_cast<const SyncBenchmarkContext<T>*>(ptr);
+
+    while (true) {
+        context->sync->Wait();
+        const_cast<SyncBenchmarkContext<T>*>(context)->woken_at = murasaki::GetCycleCounter();
+        context->ack->Release();
+    }
+}
+
+// Measure the latency from Release() to the wake up of the higher priority task.
+template<typename T>
+static void MeasureWakeLatency(unsigned int iterations, unsigned int *average, unsigned int *worst)
+                               {
+    SyncBenchmarkContext<T> context;
+    context.sync = new T();
+    context.ack = new murasaki::Synchronizer();
+    context.woken_at = 0;
+
+    murasaki::SimpleTask *task = new murasaki::SimpleTask(
+                                                          "SyncBench",
+                                                          256,
+                                                          murasaki::ktpRealtime,
+                                                          &context,
+                                                          &SyncBenchmarkTaskBody<T>);
+    MURASAKI_ASSERT(nullptr != context.sync)
+    MURASAKI_ASSERT(nullptr != context.ack)
+    MURASAKI_ASSERT(nullptr != task)
+
+    // The task runs immediately, and waits.
+    task->Start();
+
+    unsigned int total = 0;
+    *worst = 0;
+    for (unsigned int count = 0; count < iterations; count++) {
+        unsigned int start = murasaki::GetCycleCounter();
+        // The higher priority task preempts here.
+        context.sync->Release();
+        context.ack->Wait();
+
+        unsigned int latency = context.woken_at - start;
+        total += latency;
+        *worst = std::max(*worst, latency);
+    }
+    *average = total / iterations;
+
+    // The task is waiting. Delete it first.
+    delete task;
+    delete context.ack;
+    delete context.sync;
+}
+
+void murasaki::SynchronizerBenchmark(unsigned int iterations)
+                                     {
+    unsigned int semaphore_average, semaphore_worst, notification_average, notification_worst;
+
+    MURASAKI_ASSERT(0 < iterations)
+    MURASAKI_ASSERT(::uxTaskPriorityGet(nullptr) < static_cast<UBaseType_t>(murasaki::ktpRealtime))
+
+    MeasureWakeLatency<murasaki::Synchronizer>(iterations, &semaphore_average, &semaphore_worst);
+    MeasureWakeLatency<murasaki::NotificationSynchronizer>(iterations, &notification_average, &notification_worst);
+
+    murasaki::debugger->Printf("\n            Synchronizer wake up latency benchmark\n");
+    murasaki::debugger->Printf("%d iterations\n", iterations);
+    murasaki::debugger->Printf("Synchronizer              | Average [cycle] | Worst [cycle]\n");
+    murasaki::debugger->Printf("--------------------------+-----------------+--------------\n");
+    murasaki::debugger->Printf("Synchronizer              | %15d | %13d\n", semaphore_average, semaphore_worst);
+    murasaki::debugger->Printf("NotificationSynchronizer  | %15d | %13d\n", notification_average, notification_worst);
+}
+
+// Measure the cycles of an uncontended pair of Enter() and Leave().
+template<typename T>
+static void MeasureCriticalSection(unsigned int iterations, unsigned int *average, unsigned int *worst)
+                                   {
+    T *section = new T();
+    MURASAKI_ASSERT(nullptr != section)
+
+    unsigned int total = 0;
+    *worst = 0;
+    for (unsigned int count = 0; count < iterations; count++) {
+        unsigned int start = murasaki::GetCycleCounter();
+        section->Enter();
+        section->Leave();
+        unsigned int cycles = murasaki::GetCycleCounter() - start;
+
+        total += cycles;
+        *worst = std::max(*worst, cycles);
+    }
+    *average = total / iterations;
+
+    delete section;
+}
+
+void murasaki::CriticalSectionBenchmark(unsigned int iterations)
+                                        {
+    unsigned int mutex_average, mutex_worst, recursive_average, recursive_worst;
+    unsigned int interrupt_average, interrupt_worst, scheduler_average, scheduler_worst;
+
+    MURASAKI_ASSERT(0 < iterations)
+    MURASAKI_ASSERT(!murasaki::IsInsideInterrupt());
+
+    MeasureCriticalSection<murasaki::CriticalSection>(iterations, &mutex_average, &mutex_worst);
+    MeasureCriticalSection<murasaki::RecursiveCriticalSection>(iterations, &recursive_average, &recursive_worst);
+    MeasureCriticalSection<murasaki::InterruptCriticalSection>(iterations, &interrupt_average, &interrupt_worst);
+    MeasureCriticalSection<murasaki::SchedulerCriticalSection>(iterations, &scheduler_average, &scheduler_worst);
+
+    murasaki::debugger->Printf("\n            Critical section benchmark\n");
+    murasaki::debugger->Printf("%d iterations, Enter() and Leave() without contention\n", iterations);
+    murasaki::debugger->Printf("Critical section          | Average [cycle] | Worst [cycle]\n");
+    murasaki::debugger->Printf("--------------------------+-----------------+--------------\n");
+    murasaki::debugger->Printf("CriticalSection           | %15d | %13d\n", mutex_average, mutex_worst);
+    murasaki::debugger->Printf("RecursiveCriticalSection  | %15d | %13d\n", recursive_average, recursive_worst);
+    murasaki::debugger->Printf("InterruptCriticalSection  | %15d | %13d\n", interrupt_average, interrupt_worst);
+    murasaki::debugger->Printf("SchedulerCriticalSection  | %15d | %13d\n", scheduler_average, scheduler_worst);
+}
@@ -6,12 +6,33 @@
  */
 
 #include "murasaki_syslog.hpp"
+#include "murasaki_assert.hpp"
+#include "murasaki_atomic.hpp"
+#include <algorithm>
+
+#define SYSLOG_NUM_OF_FACILITIES 32
 
 namespace murasaki {
 // mask for the Syslog facility check
 static uint32_t facility_mask = 0xFFFFFFFF;
 // threshold for the Syslog severity check
 static murasaki::SyslogSeverity severity_threashold = murasaki::kseError;
+// threshold of each facility bit. The value is severity + 1. 0 means the severity_threashold is used.
+static uint8_t facility_threshold[SYSLOG_NUM_OF_FACILITIES];
+// rate limit of each facility bit
+static murasaki::SyslogRateLimiter facility_limiter[SYSLOG_NUM_OF_FACILITIES];
+// number of the messages suppressed by the rate limit, since the last report
+static volatile uint32_t facility_suppressed[SYSLOG_NUM_OF_FACILITIES];
+// time of the last report by GetTimebaseTicks()
+static uint64_t last_report = 0;
+
+// name of the facility bits
+static const char *const facility_name[SYSLOG_NUM_OF_FACILITIES] = {
+        "kfaKernel", "kfaSerial", "kfaSpiMaster", "kfaSpiSlave", "kfaI2cMaster", "kfaI2cSlave", "kfaAudio", "kfaI2s",
+        "kfaSai", "kfaLog", "kfaAudioCodec", "kfaEncoder", "kfaAdc", "kfaExti", "kfaPll", "bit 15",
+        "bit 16", "bit 17", "bit 18", "bit 19", "bit 20", "bit 21", "bit 22", "bit 23",
+        "kfaUser0", "kfaUser1", "kfaUser2", "kfaUser3", "kfaUser4", "kfaUser5", "kfaUser6", "kfaUser7"
+};
 
 void SetSyslogSeverityThreshold(murasaki::SyslogSeverity severity) {
     severity_threashold = severity;
@@ -31,23 +52,130 @@ void RemoveSyslogFacilityFromMask(murasaki::SyslogFacility facility) {
     facility_mask &= ~facility;
 }
 
+void SetSyslogFacilitySeverity(uint32_t facility, murasaki::SyslogSeverity severity) {
+    for (unsigned int i = 0; i < SYSLOG_NUM_OF_FACILITIES; i++)
+        if (facility & (1u << i))
+            facility_threshold[i] = severity + 1;
+}
+
+void ResetSyslogFacilitySeverity(uint32_t facility) {
+    for (unsigned int i = 0; i < SYSLOG_NUM_OF_FACILITIES; i++)
+        if (facility & (1u << i))
+            facility_threshold[i] = 0;
+}
+
+void SetSyslogRateLimit(uint32_t facility, unsigned int messages_per_second, unsigned int burst) {
+    for (unsigned int i = 0; i < SYSLOG_NUM_OF_FACILITIES; i++)
+        if (facility & (1u << i))
+            facility_limiter[i].SetRate(messages_per_second, burst);
+}
+
+void ReportSyslogSuppression() {
+    for (unsigned int i = 0; i < SYSLOG_NUM_OF_FACILITIES; i++) {
+        // Read and clear. The other context may add the count in between.
+        uint32_t count;
+        do {
+            count = murasaki::AtomicLoad(&facility_suppressed[i]);
+        } while (count != 0 && !murasaki::AtomicCompareAndSwap(&facility_suppressed[i], count, 0u));
+
+        if (count != 0)
+            murasaki::debugger->Printf("%s: %u messages suppressed by the rate limit\n",
+                                       facility_name[i],
+                                       static_cast<unsigned int>(count));
+    }
+}
+
+void SyslogRateLimiter::SetRate(unsigned int messages_per_second, unsigned int burst) {
+    MURASAKI_ASSERT(0 < burst)
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        messages_per_second_ = messages_per_second;
+        burst_ = burst;
+        arrival_ = 0;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+bool SyslogRateLimiter::Allow() {
+    if (messages_per_second_ == 0)
+        return true;
+
+    // Interval of the tokens.
+    uint64_t interval = murasaki::GetTimebaseFrequency() / messages_per_second_;
+    uint64_t now = murasaki::GetTimebaseTicks();
+    bool allowed;
+
+    // The time of the next arrival can be ahead of now, up to the burst. This is equivalent to
+    // the token bucket, and needs no periodic refill.
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        uint64_t arrival = std::max(arrival_, now);
+        allowed = (arrival - now <= (burst_ - 1) * interval);
+        if (allowed)
+            arrival_ = arrival + interval;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    return allowed;
+}
+
+// Report the suppressed messages if the interval has passed.
+static void ReportIfDue() {
+#if PLATFORM_CONFIG_SYSLOG_REPORT_INTERVAL
+    uint64_t interval = static_cast<uint64_t>(murasaki::GetTimebaseFrequency()) * PLATFORM_CONFIG_SYSLOG_REPORT_INTERVAL / 1000;
+    uint64_t now = murasaki::GetTimebaseTicks();
+    bool due = false;
+
+    // Only one context reports.
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        if (now - last_report >= interval) {
+            last_report = now;
+            due = true;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    if (due)
+        ReportSyslogSuppression();
+#endif
+}
+
 bool AllowedSyslogOut(murasaki::SyslogFacility facility,
-                      murasaki::SyslogSeverity severity) {
+                      murasaki::SyslogSeverity severity,
+                      murasaki::SyslogRateLimiter *site) {
     // if severe than Error, always output
     // note : lower the enum order is the higher severity
-    if (severity <= murasaki::kseError)
+    if (severity <= murasaki::kseError) {
+        ReportIfDue();
         return true;
+    }
+
+    // not allowed by facility mask
+    if (!(facility & facility_mask))
+        return false;
+
+    // the facility threshold overrides the global one.
+    unsigned int index = (facility != 0) ? __builtin_ctz(facility) : 0;
+    murasaki::SyslogSeverity threshold = severity_threashold;
+    if (facility_threshold[index] != 0)
+        threshold = static_cast<murasaki::SyslogSeverity>(facility_threshold[index] - 1);
 
-    // or if severe than the threshold and allowed by facility mask, output
     // note : lower the enum order is the higher severity
-    else if ((severity <= severity_threashold) &&
-            (facility & facility_mask))
-        return true;
+    if (severity > threshold)
+        return false;
 
-    // otherwise, not allowed
-    else
+    // rate limit of the call site, then the facility.
+    // The call site throttled by its own limiter must not take the token of the facility,
+    // to keep it for the other messages of the same facility.
+    if ((site != nullptr && !site->Allow()) || !facility_limiter[index].Allow()) {
+        murasaki::AtomicAdd(&facility_suppressed[index], 1u);
         return false;
-}
+    }
 
+    ReportIfDue();
+    return true;
 }
 
+}
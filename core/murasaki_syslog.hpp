@@ -11,6 +11,8 @@
 #include <debugger.hpp>
 #include "murasaki_config.hpp"
 #include "murasaki_defs.hpp"
+#include "murasaki_deferredlog.hpp"
+#include "murasaki_timebase.hpp"
 #include "string.h"
 
 namespace murasaki {
@@ -49,10 +51,99 @@ void AddSyslogFacilityToMask(murasaki::SyslogFacility facility);
  */
 void RemoveSyslogFacilityFromMask(murasaki::SyslogFacility facility);
 
+/**
+ * @brief Set the syslog severity threshold of the facilities.
+ * @param facility Facility bitmask. The threshold is set to all facilities of "1".
+ * @param severity Threshold of these facilities.
+ * @details
+ * Override the threshold by @ref SetSyslogSeverityThreshold for the given facilities. For example,
+ * the debug message of only one facility can be enabled, while the others are kept at the error level.
+ *
+ * See @ref AllowedSyslogOut to understand when the message is out.
+ */
+void SetSyslogFacilitySeverity(uint32_t facility, murasaki::SyslogSeverity severity);
+
+/**
+ * @brief Remove the syslog severity threshold of the facilities.
+ * @param facility Facility bitmask.
+ * @details
+ * The facilities of "1" follow the threshold by @ref SetSyslogSeverityThreshold again.
+ */
+void ResetSyslogFacilitySeverity(uint32_t facility);
+
+/**
+ * @brief Set the rate limit of the facilities.
+ * @param facility Facility bitmask. The rate limit is set to each facility of "1", individually.
+ * @param messages_per_second Long term rate of the message allowed to out. 0 means no limit.
+ * @param burst Number of the message allowed to out at once. Must be bigger than 0.
+ * @details
+ * The message over the rate is suppressed, and counted. The counts are reported by
+ * @ref ReportSyslogSuppression().
+ *
+ * By default, there is no limit.
+ */
+void SetSyslogRateLimit(uint32_t facility, unsigned int messages_per_second, unsigned int burst);
+
+/**
+ * @brief Output the number of the suppressed messages of each facility.
+ * @details
+ * Print the number of the messages suppressed by the rate limit since the last report, and clear it.
+ * Nothing is printed if no message is suppressed.
+ *
+ * This function is called automatically before the syslog message,
+ * every @ref PLATFORM_CONFIG_SYSLOG_REPORT_INTERVAL mS. Can be called from both task and ISR.
+ */
+void ReportSyslogSuppression();
+
+/**
+ * @brief Token bucket rate limiter of the syslog.
+ * @details
+ * Allow the message up to the burst at once, and then at the given rate. This class is
+ * used for each facility inside the syslog, and for each call site by @ref MURASAKI_SYSLOG_RATE_LIMITED.
+ *
+ * The constructor is constexpr. So, the static instance is initialized without the run time code.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+class SyslogRateLimiter
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param messages_per_second Long term rate of the message allowed to out. 0 means no limit.
+     * @param burst Number of the message allowed to out at once. Must be bigger than 0.
+     */
+    constexpr SyslogRateLimiter(unsigned int messages_per_second = 0, unsigned int burst = 1)
+            : messages_per_second_(messages_per_second), burst_(burst), arrival_(0)
+    {
+    }
+
+    /**
+     * @brief Change the rate.
+     * @param messages_per_second Long term rate of the message allowed to out. 0 means no limit.
+     * @param burst Number of the message allowed to out at once. Must be bigger than 0.
+     */
+    void SetRate(unsigned int messages_per_second, unsigned int burst);
+
+    /**
+     * @brief Take a token.
+     * @return true if the message is allowed to out. false if it must be suppressed.
+     * @details
+     * Can be called from both task and ISR.
+     */
+    bool Allow();
+
+ private:
+    unsigned int messages_per_second_;
+    unsigned int burst_;
+    // Theoretical arrival time of the next message, by GetTimebaseTicks().
+    uint64_t arrival_;
+};
+
 /**
  * @brief Check if given facility and severity message is allowed to output
  * @param facility Message facility
  * @param severity Message severity
+ * @param site Rate limiter of the call site. nullptr if the call site is not limited.
  * @return True if the message is allowed to out. False if not allowed.
  * @details
  * By comparing internal severity threshold and facility mask, decide
@@ -61,17 +152,49 @@ void RemoveSyslogFacilityFromMask(murasaki::SyslogFacility facility);
  * If the severity is higher than or equal to kseError, the message is allowed to out.
  *
  * If the severity is lower than kseError, the message is allowed to out only when :
- * @li The severity is higher than or equal to the internal threshold
+ * @li The severity is higher than or equal to the threshold of the facility by @ref SetSyslogFacilitySeverity,
+ * or the internal threshold if the facility has no threshold.
  * @li The facility is "1" in the corresponding bit of the internal facility mask.
+ * @li The rate limit of the call site allows.
+ * @li The rate limit of the facility by @ref SetSyslogRateLimit allows. The token of the facility is
+ * taken only when the call site allows.
+ *
+ * The message suppressed by the rate limit is counted and reported by @ref ReportSyslogSuppression().
  */
 bool AllowedSyslogOut(murasaki::SyslogFacility facility,
-                      murasaki::SyslogSeverity severity);
+                      murasaki::SyslogSeverity severity,
+                      murasaki::SyslogRateLimiter *site = nullptr);
+
+/**
+ * @brief Check if given facility and severity message is compiled in.
+ * @param facility Message facility
+ * @param severity Message severity
+ * @return True if the message is compiled in. False if it is removed at the compile time.
+ * @details
+ * The compile time version of the @ref AllowedSyslogOut. The threshold and mask are given by
+ * @ref MURASAKI_CONFIG_SYSLOG_MIN_SEVERITY and @ref MURASAKI_CONFIG_SYSLOG_FACILITY_MASK.
+ */
+constexpr bool SyslogCompiledIn(murasaki::SyslogFacility facility,
+                                murasaki::SyslogSeverity severity)
+                                {
+    // note : lower the enum order is the higher severity
+    return (severity <= murasaki::kseError) ||
+            ((severity <= MURASAKI_CONFIG_SYSLOG_MIN_SEVERITY) && ((facility & MURASAKI_CONFIG_SYSLOG_FACILITY_MASK) != 0));
+}
 
 }
 
+// Remove the message filtered out at compile time. With C++17, the message is not compiled at all.
+// Otherwise, the constant condition let the optimizer remove the message.
+#if __cplusplus >= 201703L
+#define MURASAKI_SYSLOG_IF_COMPILED_IN( FACILITY, SEVERITY ) if constexpr ( murasaki::SyslogCompiledIn(FACILITY, SEVERITY) )
+#else
+#define MURASAKI_SYSLOG_IF_COMPILED_IN( FACILITY, SEVERITY ) if ( murasaki::SyslogCompiledIn(FACILITY, SEVERITY) )
+#endif
+
 // Remove directory path from __FILE__
 #ifndef __MURASAKI__FILE__
-#define __MURASAKI__FILE__  (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
+#define __MURASAKI__FILE__  (murasaki::FileBaseName(__FILE__))
 #endif
 /**
  * \def MURASAKI_SYSLOG
@@ -85,7 +208,12 @@ bool AllowedSyslogOut(murasaki::SyslogFacility facility,
  *
  * The output message is filtered by the internal threshold set by murasaki::SetSyslogSererityThreshold,
  * murasaki::SetSyslogFacilityMask and murasaki::AddSyslogFacilityToMask. See these function's document
- * to understand how filter works.
+ * to understand how filter works. Then, it is limited by the rate limit of the facility set by
+ * murasaki::SetSyslogRateLimit().
+ *
+ * Before the run time filter, the message is filtered at the compile time by @ref MURASAKI_CONFIG_SYSLOG_MIN_SEVERITY
+ * and @ref MURASAKI_CONFIG_SYSLOG_FACILITY_MASK. The filtered out message costs nothing, including the
+ * evaluation of the arguments. To use this filter, the FACILITY and SEVERITY must be constants.
  *
  * There is recommendation in the SEVERITY parameter :
  * @li murasaki::kseDebug for Development/Debug message for tracing normal operation.
@@ -94,7 +222,7 @@ bool AllowedSyslogOut(murasaki::SyslogFacility facility,
  * @li murasaki::kseEmergency for software logic error like assert fail
  *
  * The output format is as following :
- * @li Clock cycles by @ref GetCycleCounter()
+ * @li Time since start up in second, by @ref murasaki::GetTimebaseTicks(). The resolution is 1uS.
  * @li Object address
  * @li Facility
  * @li Severity
@@ -103,15 +231,61 @@ bool AllowedSyslogOut(murasaki::SyslogFacility facility,
  * @li Function name
  * @li Other programmer specified information
  *
+ * If the @ref MURASAKI_CONFIG_DEFERRED_SYSLOG is true, the message is not formatted on the target.
+ * Instead, it is stored by @ref MURASAKI_DEFERRED_LOG, and formatted by the host side decoder.
+ * The full path of the source file is printed in this case.
+ *
  * \ingroup MURASAKI_GROUP
  */
 #if MURASAKI_CONFIG_NOSYSLOG
 #define MURASAKI_SYSLOG( OBJPTR, FACILITY, SEVERITY, FORMAT, ... )
 #else
 #define MURASAKI_SYSLOG( OBJPTR, FACILITY, SEVERITY, FORMAT, ... )\
+    MURASAKI_SYSLOG_IF_COMPILED_IN(FACILITY, SEVERITY)\
     if ( murasaki::AllowedSyslogOut(FACILITY, SEVERITY) )\
+        MURASAKI_SYSLOG_OUT(OBJPTR, FACILITY, SEVERITY, FORMAT, ##__VA_ARGS__)
+#endif
+
+/**
+ * \def MURASAKI_SYSLOG_RATE_LIMITED
+ * @param OBJPTR the pointer to the object. Usually, path the "this" pointer here.
+ * \param FACILITY Specify which facility makes this log. Choose from @ref murasaki::SyslogFacility
+ * \param SEVERITY Specify how message is severe. Choose from @ref murasaki::SyslogSeverity
+ * \param RATE Long term rate of this message [message/S]. Must be a constant.
+ * \param BURST Number of this message allowed to out at once. Must be a constant.
+ * \param FORMAT Message format as printf style.
+ * \brief output The debug message with the rate limit of the call site.
+ * \details
+ * Same with the @ref MURASAKI_SYSLOG, except this call site has its own rate limit, in addition to
+ * the limit of the facility. Use this macro for the message in the periodic path like the audio
+ * block processing. The suppressed messages are counted as the suppression of the FACILITY.
+ *
+ * \ingroup MURASAKI_GROUP
+ */
+#if MURASAKI_CONFIG_NOSYSLOG
+#define MURASAKI_SYSLOG_RATE_LIMITED( OBJPTR, FACILITY, SEVERITY, RATE, BURST, FORMAT, ... )
+#else
+#define MURASAKI_SYSLOG_RATE_LIMITED( OBJPTR, FACILITY, SEVERITY, RATE, BURST, FORMAT, ... )\
+    MURASAKI_SYSLOG_IF_COMPILED_IN(FACILITY, SEVERITY)\
+    {\
+        static murasaki::SyslogRateLimiter murasaki_syslog_limiter(RATE, BURST);\
+        if ( murasaki::AllowedSyslogOut(FACILITY, SEVERITY, &murasaki_syslog_limiter) )\
+            MURASAKI_SYSLOG_OUT(OBJPTR, FACILITY, SEVERITY, FORMAT, ##__VA_ARGS__)\
+    }
+#endif
+
+// Output the message already filtered.
+#if MURASAKI_CONFIG_DEFERRED_SYSLOG
+#define MURASAKI_SYSLOG_OUT( OBJPTR, FACILITY, SEVERITY, FORMAT, ... )\
+    {\
+        MURASAKI_DEFERRED_LOG("%p, " #FACILITY ", " #SEVERITY ": " __FILE__ ", line " MURASAKI_DEFERRED_STRINGIFY(__LINE__) ", %s(): " FORMAT "\n", static_cast<const void*>(OBJPTR), __func__, ##__VA_ARGS__)\
+    }
+#else
+#define MURASAKI_SYSLOG_OUT( OBJPTR, FACILITY, SEVERITY, FORMAT, ... )\
     {\
-        murasaki::debugger->Printf("%10u, %p, %s, %s: %s, line %4d, %s(): " FORMAT "\n", murasaki::GetCycleCounter(), OBJPTR, #FACILITY, #SEVERITY, __MURASAKI__FILE__, __LINE__, __func__, ##__VA_ARGS__);\
+        constexpr const char *murasaki_syslog_file = __MURASAKI__FILE__;\
+        const uint64_t murasaki_syslog_us = murasaki::TimebaseToMicroseconds(murasaki::GetTimebaseTicks());\
+        murasaki::debugger->Printf("%6u.%06u, %p, %s, %s: %s, line %4d, %s(): " FORMAT "\n", static_cast<unsigned int>(murasaki_syslog_us / 1000000), static_cast<unsigned int>(murasaki_syslog_us % 1000000), OBJPTR, #FACILITY, #SEVERITY, murasaki_syslog_file, __LINE__, __func__, ##__VA_ARGS__);\
     }
 #endif
 
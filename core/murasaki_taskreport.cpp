@@ -0,0 +1,33 @@
+/*
+ * murasaki_taskreport.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include "murasaki.hpp"
+
+void murasaki::ReportTaskStacks()
+{
+    murasaki::debugger->Printf("\n            Task stack usage\n");
+    murasaki::debugger->Printf("Task             |    Depth | Min headroom | Used [%%]\n");
+    murasaki::debugger->Printf("-----------------+----------+--------------+---------\n");
+
+    for (murasaki::TaskStrategy *task = murasaki::TaskStrategy::GetFirstTask();
+            task != nullptr;
+            task = task->GetNextTask()) {
+        unsigned int depth = task->getStackDepth();
+
+        // The headroom of the task not started is not known.
+        int headroom = (nullptr != task->GetTaskHandle()) ? task->getStackMinHeadroom() : -1;
+
+        if (headroom < 0)
+            murasaki::debugger->Printf("%-16s | %8u |            - |        -\n", task->GetName(), depth);
+        else
+            murasaki::debugger->Printf("%-16s | %8u | %12d | %8u\n",
+                                       task->GetName(),
+                                       depth,
+                                       headroom,
+                                       (depth - headroom) * 100 / depth);
+    }
+}
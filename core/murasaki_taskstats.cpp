@@ -0,0 +1,270 @@
+/*
+ * murasaki_taskstats.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <string.h>
+
+#include "murasaki_taskstats.hpp"
+#include "murasaki_tracehook.h"
+#include "murasaki_defs.hpp"
+#include "murasaki_assert.hpp"
+#include "murasaki_timebase.hpp"
+#include "debugger.hpp"
+
+#if MURASAKI_CONFIG_TASK_STATISTICS
+
+// Measurement of a task.
+struct TaskStatisticsEntry
+{
+    void *task;                         // nullptr if the entry is free.
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t switched_in_at;            // Timebase counter at the last switch in.
+    uint64_t window_run_time;           // run_time at the start of the window.
+    uint32_t window_switches;           // context_switches at the start of the window.
+    murasaki::TaskStatistics stats;
+};
+
+static_assert(PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX < configNUM_THREAD_LOCAL_STORAGE_POINTERS,
+              "PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX must be smaller than configNUM_THREAD_LOCAL_STORAGE_POINTERS");
+static_assert(!MURASAKI_CONFIG_HEAP_TRACE || PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX != PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX,
+              "PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX must be different from PLATFORM_CONFIG_HEAP_TRACE_TLS_INDEX");
+
+static TaskStatisticsEntry task_entries[PLATFORM_CONFIG_TASK_STATISTICS_NUM_OF_TASKS];
+// Entry of the running task. nullptr if the task is not measured.
+static TaskStatisticsEntry *current_entry = nullptr;
+// Timebase at the start of the window.
+static uint64_t window_start = 0;
+// The measurement starts at the first UpdateTaskStatistics().
+static bool started = false;
+
+// Must be called inside critical section.
+static TaskStatisticsEntry* FindEntry(void *task)
+                                      {
+    for (unsigned int i = 0; i < PLATFORM_CONFIG_TASK_STATISTICS_NUM_OF_TASKS; i++)
+        if (task_entries[i].task == task)
+            return &task_entries[i];
+    return nullptr;
+}
+
+// Entry of the task, kept in the thread local storage. O(1), to be called at every task switch.
+static TaskStatisticsEntry* GetEntry(void *task)
+                                     {
+    TaskStatisticsEntry *entry = static_cast<TaskStatisticsEntry*>(
+            ::pvTaskGetThreadLocalStoragePointer(static_cast<TaskHandle_t>(task),
+                                                 PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX));
+
+    // Guard against the pointer set by the other software.
+    if (nullptr != entry && entry->task != task)
+        return nullptr;
+    return entry;
+}
+
+void murasaki::TaskStatisticsCreate(void *task, const char *name)
+                                    {
+    // Called inside the critical section of the FreeRTOS. The TCB is initialized already.
+    TaskStatisticsEntry *entry = FindEntry(nullptr);
+
+    // If the table is full, the task is not measured.
+    ::vTaskSetThreadLocalStoragePointer(static_cast<TaskHandle_t>(task), PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX, entry);
+    if (nullptr == entry)
+        return;
+
+    ::memset(entry, 0, sizeof(*entry));
+    entry->task = task;
+    ::strncpy(entry->name, name, sizeof(entry->name) - 1);
+}
+
+void murasaki::TaskStatisticsDelete(void *task)
+                                    {
+    // Called inside the critical section of the FreeRTOS. The TCB may be re-used by the next task.
+    TaskStatisticsEntry *entry = GetEntry(task);
+
+    if (nullptr == entry)
+        return;
+
+    ::vTaskSetThreadLocalStoragePointer(static_cast<TaskHandle_t>(task), PLATFORM_CONFIG_TASK_STATISTICS_TLS_INDEX, nullptr);
+    entry->task = nullptr;
+    if (current_entry == entry)
+        current_entry = nullptr;
+}
+
+void murasaki::TaskStatisticsSwitchedIn(void *task)
+                                        {
+    current_entry = GetEntry(task);
+    if (nullptr != current_entry)
+        current_entry->switched_in_at = murasaki::GetTimebaseCounter();
+}
+
+void murasaki::TaskStatisticsSwitchedOut(void *task)
+                                         {
+    if (!started || nullptr == current_entry || current_entry->task != task)
+        return;
+
+    // Wrap around safe.
+    uint32_t slice = murasaki::GetTimebaseCounter() - current_entry->switched_in_at;
+    murasaki::TaskStatistics &stats = current_entry->stats;
+
+    stats.run_time += slice;
+    stats.context_switches++;
+    if (stats.max_time_slice < slice)
+        stats.max_time_slice = slice;
+}
+
+void murasaki::UpdateTaskStatistics()
+{
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        uint64_t now = murasaki::GetTimebaseTicks();
+        uint64_t elapsed = now - window_start;
+
+        // The slice of the running task is not closed yet. Count it to this window.
+        if (started && nullptr != current_entry) {
+            uint32_t counter = static_cast<uint32_t>(now);
+
+            current_entry->stats.run_time += counter - current_entry->switched_in_at;
+            current_entry->switched_in_at = counter;
+        }
+
+        for (unsigned int i = 0; i < PLATFORM_CONFIG_TASK_STATISTICS_NUM_OF_TASKS; i++) {
+            TaskStatisticsEntry &entry = task_entries[i];
+
+            if (nullptr == entry.task)
+                continue;
+
+            if (started && 0 != elapsed) {
+                entry.stats.cpu_usage = static_cast<float>(entry.stats.run_time - entry.window_run_time) * 100.0f
+                        / static_cast<float>(elapsed);
+                entry.stats.recent_switches = entry.stats.context_switches - entry.window_switches;
+            }
+            entry.window_run_time = entry.stats.run_time;
+            entry.window_switches = entry.stats.context_switches;
+        }
+
+        // The first call starts the measurement from the running task.
+        if (!started && nullptr != current_entry)
+            current_entry->switched_in_at = static_cast<uint32_t>(now);
+
+        window_start = now;
+        started = true;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+bool murasaki::GetTaskStatistics(TaskHandle_t task, murasaki::TaskStatistics *stats)
+                                 {
+    MURASAKI_ASSERT(nullptr != stats)
+
+    bool found = false;
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        TaskStatisticsEntry *entry = (nullptr == task) ? nullptr : FindEntry(task);
+
+        if (nullptr != entry) {
+            *stats = entry->stats;
+            found = true;
+        }
+        else
+            ::memset(stats, 0, sizeof(*stats));
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    return found;
+}
+
+void murasaki::ReportTaskStatistics()
+{
+    TaskStatisticsEntry entries[PLATFORM_CONFIG_TASK_STATISTICS_NUM_OF_TASKS];
+    unsigned int order[PLATFORM_CONFIG_TASK_STATISTICS_NUM_OF_TASKS];
+    unsigned int num_of_tasks = 0;
+
+    // Take a snapshot.
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    ::memcpy(entries, task_entries, sizeof(entries));
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    // Sort by the CPU usage, in descending order.
+    for (unsigned int i = 0; i < PLATFORM_CONFIG_TASK_STATISTICS_NUM_OF_TASKS; i++) {
+        if (nullptr == entries[i].task)
+            continue;
+
+        unsigned int j = num_of_tasks++;
+        for (; j > 0 && entries[order[j - 1]].stats.cpu_usage < entries[i].stats.cpu_usage; j--)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+
+    murasaki::debugger->Printf("\n            Task statistics\n");
+    murasaki::debugger->Printf("Task             | CPU [%%] | Switches | Max slice [uS] |  Total switches\n");
+    murasaki::debugger->Printf("-----------------+---------+----------+----------------+----------------\n");
+    for (unsigned int i = 0; i < num_of_tasks; i++) {
+        const TaskStatisticsEntry &entry = entries[order[i]];
+        // Printf may not support the float. Print in 0.1% unit.
+        unsigned int usage = static_cast<unsigned int>(entry.stats.cpu_usage * 10.0f + 0.5f);
+
+        murasaki::debugger->Printf("%-16s | %5u.%1u | %8u | %14u | %15u\n",
+                                   entry.name,
+                                   usage / 10,
+                                   usage % 10,
+                                   static_cast<unsigned int>(entry.stats.recent_switches),
+                                   static_cast<unsigned int>(murasaki::TimebaseToMicroseconds(entry.stats.max_time_slice)),
+                                   static_cast<unsigned int>(entry.stats.context_switches));
+    }
+}
+
+#else
+
+void murasaki::TaskStatisticsCreate(void *task, const char *name)
+                                    {
+}
+
+void murasaki::TaskStatisticsDelete(void *task)
+                                    {
+}
+
+void murasaki::TaskStatisticsSwitchedIn(void *task)
+                                        {
+}
+
+void murasaki::TaskStatisticsSwitchedOut(void *task)
+                                         {
+}
+
+void murasaki::UpdateTaskStatistics()
+{
+}
+
+bool murasaki::GetTaskStatistics(TaskHandle_t task, murasaki::TaskStatistics *stats)
+                                 {
+    MURASAKI_ASSERT(nullptr != stats)
+
+    ::memset(stats, 0, sizeof(*stats));
+    return false;
+}
+
+void murasaki::ReportTaskStatistics()
+{
+    murasaki::debugger->Printf("Task statistics is not enabled. See MURASAKI_CONFIG_TASK_STATISTICS\n");
+}
+
+#endif
+
+#if configGENERATE_RUN_TIME_STATS
+/* ----------------- Run time counter for the FreeRTOS ----------------- */
+
+// Override the weak functions generated by the CubeMX.
+void configureTimerForRunTimeStats(void)
+{
+    // Called at the start of the scheduler.
+    murasaki::InitCycleCounter();
+}
+
+unsigned long getRunTimeCounterValue(void)
+{
+    return murasaki::GetTimebaseCounter();
+}
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file murasaki_taskstats.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief CPU usage, context switches and time slice of each task.
+ * @details
+ * If the @ref MURASAKI_CONFIG_TASK_STATISTICS is true, the task switch hooks in murasaki_tracehook.h read the
+ * murasaki::GetTimebaseCounter() at every task switch. The time between the switch in and the switch out is
+ * a time slice. The time slices are added to the run time of the task.
+ *
+ * The CPU usage is the ratio of the run time in the window between two murasaki::UpdateTaskStatistics() calls.
+ * Usually, murasaki::TaskMonitor calls it periodically, and prints the report :
+ * @code
+ *     murasaki::platform.monitor = new murasaki::TaskMonitor(1000);    // Every second.
+ *     murasaki::platform.monitor->Start();
+ * @endcode
+ *
+ * The time in the interrupt is counted as the time of the interrupted task.
+ *
+ * The same counter is given to the FreeRTOS as the run time counter, if the configGENERATE_RUN_TIME_STATS
+ * is 1. Then, vTaskGetRunTimeStats() and the IDE views of the FreeRTOS show the cycle accurate run time.
+ * The run time counter of the FreeRTOS is 32bit. So, it wraps around in several seconds at the high clock.
+ * The statistics of this file are 64bit, and not affected.
+ */
+
+#ifndef MURASAKI_TASKSTATS_HPP_
+#define MURASAKI_TASKSTATS_HPP_
+
+#include <stdint.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "murasaki_config.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Statistics of a task.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+struct TaskStatistics
+{
+    float cpu_usage;                ///< CPU usage in the last window [%].
+    uint32_t context_switches;      ///< Count of the switch out since the creation.
+    uint32_t recent_switches;       ///< Count of the switch out in the last window.
+    uint32_t max_time_slice;        ///< Longest time slice since the creation [timebase tick].
+    uint64_t run_time;              ///< Total run time since the creation [timebase tick].
+};
+
+/**
+ * @brief Register a task to measure.
+ * @param task TCB of the task.
+ * @param name Name of the task.
+ * @details
+ * Called from the task creation hook. Do not call from the application.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+void TaskStatisticsCreate(void *task, const char *name);
+
+/**
+ * @brief Unregister a task.
+ * @param task TCB of the task.
+ * @details
+ * Called from the task deletion hook. Do not call from the application.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+void TaskStatisticsDelete(void *task);
+
+/**
+ * @brief Start a time slice.
+ * @param task TCB of the task switched in.
+ * @details
+ * Called from the task switch hook. Do not call from the application.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+void TaskStatisticsSwitchedIn(void *task);
+
+/**
+ * @brief End a time slice.
+ * @param task TCB of the task switched out.
+ * @details
+ * Called from the task switch hook. Do not call from the application.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+void TaskStatisticsSwitchedOut(void *task);
+
+/**
+ * @brief Close the current window, and start a new one.
+ * @details
+ * The CPU usage and the recent switches are calculated from the window closed by this call.
+ * Call periodically from a task. The period must be shorter than the half of the wrap around time
+ * of the murasaki::GetTimebaseCounter().
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+void UpdateTaskStatistics();
+
+/**
+ * @brief Get the statistics of a task.
+ * @param task Task handle.
+ * @param stats Pointer to the variable to receive. Filled by 0 if the task is not measured.
+ * @return true if the task is measured. false if the task is not registered or
+ * the @ref MURASAKI_CONFIG_TASK_STATISTICS is false.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+bool GetTaskStatistics(TaskHandle_t task, murasaki::TaskStatistics *stats);
+
+/**
+ * @brief Print the statistics of the tasks through the debugger.
+ * @details
+ * Print a table sorted by the CPU usage in the last window, like the top command.
+ * The context switches are counted in the last window. The max time slice is the longest since the creation.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ */
+void ReportTaskStatistics();
+
+} /* namespace murasaki */
+
+#endif /* MURASAKI_TASKSTATS_HPP_ */
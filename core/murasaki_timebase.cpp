@@ -0,0 +1,105 @@
+/*
+ * murasaki_timebase.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include "murasaki_timebase.hpp"
+
+#if defined(__linux__)
+// Host implementation for the simulation and the unit test on PC.
+#include <time.h>
+
+__attribute__((weak)) unsigned int murasaki::GetTimebaseCounter()
+{
+    return static_cast<unsigned int>(murasaki::GetTimebaseTicks());
+}
+
+__attribute__((weak)) uint32_t murasaki::GetTimebaseFrequency()
+{
+    return 1000000000;
+}
+
+uint64_t murasaki::GetTimebaseTicks()
+{
+    struct timespec now;
+
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+// No extension is needed on the host.
+extern "C" void MurasakiTimebaseTick(void)
+{
+}
+
+#else
+
+#include "murasaki_defs.hpp"
+#include "murasaki_atomic.hpp"
+
+// Upper 31bit of the 63bit timebase, and the MSB of the counter at the last observation.
+// bit 31 - 1 : upper part of the timebase.
+// bit 0      : MSB of the counter.
+static volatile uint32_t timebase_state = 0;
+
+__attribute__((weak)) unsigned int murasaki::GetTimebaseCounter()
+{
+    return murasaki::GetCycleCounter();
+}
+
+__attribute__((weak)) uint32_t murasaki::GetTimebaseFrequency()
+{
+    return SystemCoreClock;
+}
+
+uint64_t murasaki::GetTimebaseTicks()
+{
+    uint32_t state;
+    uint32_t counter;
+
+    // Read the state before the counter. Then, the counter is newer than the state.
+    // If the other context updated the state in between, the pair is not consistent. Retry like a seqlock.
+    do {
+        state = murasaki::AtomicLoad(&timebase_state);
+        counter = murasaki::GetTimebaseCounter();
+    } while (state != murasaki::AtomicLoad(&timebase_state));
+
+    uint32_t upper = state >> 1;
+    uint32_t msb = counter >> 31;
+
+    // The MSB changed since the last observation.
+    if (msb != (state & 1)) {
+        // 1 -> 0 is the wrap around.
+        if (msb == 0)
+            upper++;
+        // If the other context updated in between, it has the same value. Ignore the failure.
+        murasaki::AtomicCompareAndSwap(&timebase_state, state, (upper << 1) | msb);
+    }
+
+    return (static_cast<uint64_t>(upper) << 32) | counter;
+}
+
+// Called from the tick interrupt by murasaki_tracehook.h. The tick is much shorter than the half period.
+extern "C" void MurasakiTimebaseTick(void)
+{
+    murasaki::GetTimebaseTicks();
+}
+
+#endif
+
+uint64_t murasaki::TimebaseToNanoseconds(uint64_t ticks)
+                                         {
+    const uint64_t frequency = murasaki::GetTimebaseFrequency();
+
+    // Split to avoid the overflow of the multiplication.
+    return (ticks / frequency) * 1000000000 + (ticks % frequency) * 1000000000 / frequency;
+}
+
+uint64_t murasaki::TimebaseToMicroseconds(uint64_t ticks)
+                                          {
+    const uint64_t frequency = murasaki::GetTimebaseFrequency();
+
+    return (ticks / frequency) * 1000000 + (ticks % frequency) * 1000000 / frequency;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file murasaki_timebase.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief 64bit monotonic high resolution timebase.
+ * @details
+ * The 32bit cycle counter wraps around in a few seconds on the fast CPU. This timebase extends
+ * the counter by @ref murasaki::GetTimebaseCounter() to 64bit. The extension is lock-free, and
+ * can be done from both task and ISR.
+ *
+ * The extension detects the wrap around by watching the MSB of the counter. So,
+ * @ref murasaki::GetTimebaseTicks() must be called at least once in each half period of the counter.
+ * For example, every 4.4 seconds at 480MHz. Include murasaki_tracehook.h at the end of the FreeRTOSConfig.h,
+ * to call it at every tick interrupt :
+ * @code
+ * // USER CODE BEGIN Defines
+ * #include "murasaki_tracehook.h"
+ * // USER CODE END Defines
+ * @endcode
+ * Otherwise, the application must call it periodically from a context which always runs. The murasaki::Debugger
+ * task calls it too, but it may not run for long time at the low priority.
+ *
+ * On the host ( Linux ), the timebase is the clock_gettime(CLOCK_MONOTONIC) in nano second.
+ */
+
+#ifndef MURASAKI_TIMEBASE_HPP_
+#define MURASAKI_TIMEBASE_HPP_
+
+#include <stdint.h>
+
+namespace murasaki {
+
+/**
+ * @brief Obtain the raw 32bit counter of the timebase.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @return The free running 32bit counter.
+ * @details
+ * By default, this returns @ref murasaki::GetCycleCounter(). On the Cortex-M0/M0+, there is no
+ * cycle counter. Then, the programmer can override this function by a 32bit free running hardware timer.
+ * In this case, override the @ref murasaki::GetTimebaseFrequency() too.
+ *
+ * The counter must count all 32bit, and wrap around from 0xFFFFFFFF to 0.
+ *
+ * Programmer can override default function because this funciton is weakly bound.
+ */
+unsigned int GetTimebaseCounter();
+
+/**
+ * @brief Frequency of the timebase counter.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @return Frequency [Hz].
+ * @details
+ * By default, this returns the SystemCoreClock. On the host, 1000000000.
+ *
+ * Programmer can override default function because this funciton is weakly bound.
+ */
+uint32_t GetTimebaseFrequency();
+
+/**
+ * @brief Obtain the 64bit timebase.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @return The count of the timebase since start up. Never wraps around.
+ * @details
+ * Can be called from both task and ISR. Lock-free.
+ */
+uint64_t GetTimebaseTicks();
+
+/**
+ * @brief Convert the timebase ticks to nano seconds.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param ticks The value by GetTimebaseTicks() or the difference of them.
+ * @return Time [nS].
+ */
+uint64_t TimebaseToNanoseconds(uint64_t ticks);
+
+/**
+ * @brief Convert the timebase ticks to micro seconds.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param ticks The value by GetTimebaseTicks() or the difference of them.
+ * @return Time [uS].
+ */
+uint64_t TimebaseToMicroseconds(uint64_t ticks);
+
+} /* namespace murasaki */
+
+#endif /* MURASAKI_TIMEBASE_HPP_ */
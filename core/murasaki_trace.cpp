@@ -0,0 +1,206 @@
+/*
+ * murasaki_trace.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include "murasaki.hpp"
+#include "murasaki_trace.hpp"
+#include "murasaki_tracehook.h"
+#include "murasaki_atomic.hpp"
+#include "murasaki_taskstats.hpp"
+#include <string.h>
+
+#if MURASAKI_CONFIG_TRACE
+
+static_assert((PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS & (PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS - 1)) == 0,
+              "PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS must be power of 2");
+
+// The timestamp is stored in the lower 48bit, and the event in the upper 16bit.
+#define TRACE_EVENT_SHIFT 48
+#define TRACE_TICKS_MASK ((static_cast<uint64_t>(1) << TRACE_EVENT_SHIFT) - 1)
+
+// Room to wait before each line of the dump [byte]. Longer than a task line and a deferred frame.
+#define TRACE_DUMP_ROOM (32 + configMAX_TASK_NAME_LEN)
+
+// A record of the trace ring.
+struct TraceEntry
+{
+    uint64_t stamp;
+    uint32_t object;
+    uint32_t arg;
+};
+
+// A name of the task.
+struct TraceTaskName
+{
+    void *task;
+    char name[configMAX_TASK_NAME_LEN];
+};
+
+static TraceEntry trace_records[PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS];
+// Count of the records since the start. The records wrap around in the ring.
+static volatile uint32_t trace_head = 0;
+static volatile uint32_t trace_enabled = 0;
+
+static TraceTaskName trace_tasks[PLATFORM_CONFIG_TRACE_NUM_OF_TASKS];
+static unsigned int trace_num_of_tasks = 0;
+
+#endif
+
+void murasaki::TraceRecord(murasaki::TraceEvent event, uint32_t object, uint32_t arg)
+                           {
+#if MURASAKI_CONFIG_TRACE
+    if (!murasaki::AtomicLoad(&trace_enabled))
+        return;
+
+    // Claim a record. The other context may claim the next one before this record is filled.
+    uint32_t index;
+    do {
+        index = murasaki::AtomicLoad(&trace_head);
+    } while (!murasaki::AtomicCompareAndSwap(&trace_head, index, index + 1));
+
+    TraceEntry &entry = trace_records[index & (PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS - 1)];
+    entry.stamp = (murasaki::GetTimebaseTicks() & TRACE_TICKS_MASK) | (static_cast<uint64_t>(event) << TRACE_EVENT_SHIFT);
+    entry.object = object;
+    entry.arg = arg;
+#endif
+}
+
+void murasaki::TraceStart()
+{
+#if MURASAKI_CONFIG_TRACE
+    murasaki::AtomicStore(&trace_enabled, 0);
+    murasaki::AtomicStore(&trace_head, 0);
+    murasaki::AtomicStore(&trace_enabled, 1);
+#endif
+}
+
+void murasaki::TraceStop()
+{
+#if MURASAKI_CONFIG_TRACE
+    murasaki::AtomicStore(&trace_enabled, 0);
+#endif
+}
+
+void murasaki::TraceDump()
+{
+#if MURASAKI_CONFIG_TRACE
+    MURASAKI_ASSERT(!murasaki::IsInsideInterrupt());
+    MURASAKI_ASSERT(nullptr != murasaki::debugger);
+
+    murasaki::TraceStop();
+
+    uint32_t head = murasaki::AtomicLoad(&trace_head);
+    uint32_t count = (head < PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS) ? head : PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS;
+
+    murasaki::debugger->Printf("[trace] start, %u, %u\n",
+                               static_cast<unsigned int>(murasaki::GetTimebaseFrequency()),
+                               static_cast<unsigned int>(count));
+
+    // The names are in RAM. So, they are printed as text.
+    for (unsigned int i = 0; i < trace_num_of_tasks; i++) {
+        murasaki::debugger->WaitRoom(TRACE_DUMP_ROOM);
+        murasaki::debugger->Printf("[trace] task, %p, %s\n", trace_tasks[i].task, trace_tasks[i].name);
+    }
+
+    // From the oldest.
+    for (uint32_t index = head - count; index != head; index++) {
+        // Pace by the output, instead of dropping the records. The other producers keep their own policy.
+        murasaki::debugger->WaitRoom(TRACE_DUMP_ROOM);
+
+        const TraceEntry &entry = trace_records[index & (PLATFORM_CONFIG_TRACE_NUM_OF_RECORDS - 1)];
+        uint32_t high = static_cast<uint32_t>((entry.stamp & TRACE_TICKS_MASK) >> 32);
+        uint32_t low = static_cast<uint32_t>(entry.stamp);
+
+        switch (static_cast<murasaki::TraceEvent>(entry.stamp >> TRACE_EVENT_SHIFT)) {
+            case murasaki::kteTaskSwitchedIn:
+                MURASAKI_DEFERRED_LOG("[trace] %u, %u, switch-in, %p, %u\n", high, low, entry.object, entry.arg)
+                break;
+            case murasaki::kteTaskSwitchedOut:
+                MURASAKI_DEFERRED_LOG("[trace] %u, %u, switch-out, %p, %u\n", high, low, entry.object, entry.arg)
+                break;
+            case murasaki::ktePriorityChange:
+                MURASAKI_DEFERRED_LOG("[trace] %u, %u, priority, %p, %u\n", high, low, entry.object, entry.arg)
+                break;
+            case murasaki::kteCallbackEnter:
+                // The argument is the address of the function name in ROM. The decoder reads it from the ELF.
+                MURASAKI_DEFERRED_LOG("[trace] %u, %u, isr-enter, %p, %s\n", high, low, entry.object, entry.arg)
+                break;
+            case murasaki::kteCallbackExit:
+                MURASAKI_DEFERRED_LOG("[trace] %u, %u, isr-exit, %p, %s\n", high, low, entry.object, entry.arg)
+                break;
+            case murasaki::kteWaitBegin:
+                MURASAKI_DEFERRED_LOG("[trace] %u, %u, wait-begin, %p, %u\n", high, low, entry.object, entry.arg)
+                break;
+            case murasaki::kteWaitEnd:
+                MURASAKI_DEFERRED_LOG("[trace] %u, %u, wait-end, %p, %u\n", high, low, entry.object, entry.arg)
+                break;
+            case murasaki::kteRelease:
+                MURASAKI_DEFERRED_LOG("[trace] %u, %u, release, %p, %u\n", high, low, entry.object, entry.arg)
+                break;
+            default:
+                break;
+        }
+    }
+
+    murasaki::debugger->WaitRoom(TRACE_DUMP_ROOM);
+    murasaki::debugger->Printf("[trace] end\n");
+#endif
+}
+
+/* ------------------------ Hooks from FreeRTOS ------------------------ */
+
+void MurasakiTraceTaskSwitchedIn(void *task, unsigned int priority)
+                                 {
+    MURASAKI_TRACE(murasaki::kteTaskSwitchedIn, task, priority);
+#if MURASAKI_CONFIG_TASK_STATISTICS
+    murasaki::TaskStatisticsSwitchedIn(task);
+#endif
+}
+
+void MurasakiTraceTaskSwitchedOut(void *task)
+                                  {
+#if MURASAKI_CONFIG_TASK_STATISTICS
+    murasaki::TaskStatisticsSwitchedOut(task);
+#endif
+    MURASAKI_TRACE(murasaki::kteTaskSwitchedOut, task, 0);
+}
+
+void MurasakiTraceTaskCreate(void *task, const char *name)
+                             {
+#if MURASAKI_CONFIG_TASK_STATISTICS
+    murasaki::TaskStatisticsCreate(task, name);
+#endif
+#if MURASAKI_CONFIG_TRACE
+    // Called inside the critical section of the FreeRTOS.
+    // The TCB may be re-used after the deletion of the other task. Then, overwrite the name.
+    unsigned int i;
+    for (i = 0; i < trace_num_of_tasks; i++)
+        if (trace_tasks[i].task == task)
+            break;
+
+    if (i == trace_num_of_tasks) {
+        if (trace_num_of_tasks == PLATFORM_CONFIG_TRACE_NUM_OF_TASKS)
+            return;
+        trace_num_of_tasks++;
+    }
+
+    trace_tasks[i].task = task;
+    ::strncpy(trace_tasks[i].name, name, sizeof(trace_tasks[i].name) - 1);
+    trace_tasks[i].name[sizeof(trace_tasks[i].name) - 1] = '\0';
+#endif
+}
+
+void MurasakiTracePriorityChange(void *task, unsigned int priority)
+                                 {
+    MURASAKI_TRACE(murasaki::ktePriorityChange, task, priority);
+}
+
+void MurasakiTraceTaskDelete(void *task)
+                             {
+#if MURASAKI_CONFIG_TASK_STATISTICS
+    murasaki::TaskStatisticsDelete(task);
+#endif
+}
@@ -0,0 +1,115 @@
+/**
+ * @file murasaki_trace.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Task and ISR event trace recorder.
+ * @details
+ * The trace recorder stores the events into the RAM ring in the binary form. Each record is 16 bytes :
+ * the timestamp by @ref murasaki::GetTimebaseTicks() ( 48bit ), the kind of the event ( 16bit ),
+ * the object and the argument. The recording is lock-free. So, it can be done from any task and ISR.
+ *
+ * The following events are recorded :
+ * @li Task switch and priority inheritance, by the FreeRTOS trace macros in murasaki_tracehook.h.
+ * @li Wait and release of the murasaki::Synchronizer.
+ * @li Entry and exit of the HAL callbacks in murasaki_callback.cpp.
+ *
+ * The ring is dumped by @ref murasaki::TraceDump() through the debugger as deferred log frames. Then,
+ * it is converted to the Chrome trace JSON on the host :
+ * @code
+ * python3 tools/murasaki_logdecode.py build/app.elf capture.bin | python3 tools/murasaki_trace2chrome.py > trace.json
+ * @endcode
+ * The trace.json can be opened by the chrome://tracing or the Perfetto UI.
+ *
+ * The recorder is compiled only when the @ref MURASAKI_CONFIG_TRACE is true.
+ */
+
+#ifndef MURASAKI_TRACE_HPP_
+#define MURASAKI_TRACE_HPP_
+
+#include <stdint.h>
+#include "murasaki_config.hpp"
+#include "murasaki_defs.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Store an event into the trace ring.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param event Kind of the event.
+ * @param object Address of the object related to the event.
+ * @param arg Argument of the event.
+ * @details
+ * Use @ref MURASAKI_TRACE instead of calling this function directly.
+ * Can be called from both task and ISR. Nothing is recorded while the recorder is stopped.
+ */
+void TraceRecord(murasaki::TraceEvent event, uint32_t object, uint32_t arg);
+
+/**
+ * @brief Clear the trace ring and start recording.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @details
+ * Once the ring is full, the oldest record is overwritten.
+ */
+void TraceStart();
+
+/**
+ * @brief Stop recording.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @details
+ * Can be called from both task and ISR. For example, call it when the problem is detected, to keep the
+ * records before it.
+ */
+void TraceStop();
+
+/**
+ * @brief Output the trace ring through the murasaki::debugger.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @details
+ * Stop recording, and output the task names and all records from the oldest. The records are
+ * output as deferred log frames. See @ref MURASAKI_DEFERRED_LOG.
+ *
+ * To avoid to lose the records, each record waits for the room of the debugger by
+ * murasaki::Debugger::WaitRoom(). The overflow policy of the other producers is not changed.
+ * Don't call in the critical section. Then, the records may be dropped by the overflow policy.
+ *
+ * Call from task.
+ */
+void TraceDump();
+
+} /* namespace murasaki */
+
+#if MURASAKI_CONFIG_TRACE
+/**
+ * \def MURASAKI_TRACE
+ * \param EVENT Kind of the event. murasaki::TraceEvent.
+ * \param OBJECT Pointer or integer to identify the object.
+ * \param ARG Argument of the event. Pointer or integer.
+ * \brief Record an event by the trace recorder.
+ * \details
+ * Can be called from both task and ISR. If the @ref MURASAKI_CONFIG_TRACE is false, this macro is empty.
+ * \ingroup MURASAKI_GROUP
+ */
+#define MURASAKI_TRACE( EVENT, OBJECT, ARG )\
+    murasaki::TraceRecord(EVENT, (uint32_t)(uintptr_t)(OBJECT), (uint32_t)(uintptr_t)(ARG))
+#else
+#define MURASAKI_TRACE( EVENT, OBJECT, ARG )
+#endif
+
+/**
+ * \def MURASAKI_TRACE_CALLBACK_ENTER
+ * \param HANDLE Handle of the peripheral.
+ * \brief Record the entry of the callback. The function name is recorded as the name of callback.
+ * \ingroup MURASAKI_GROUP
+ */
+#define MURASAKI_TRACE_CALLBACK_ENTER( HANDLE ) MURASAKI_TRACE(murasaki::kteCallbackEnter, HANDLE, __func__)
+
+/**
+ * \def MURASAKI_TRACE_CALLBACK_EXIT
+ * \param HANDLE Handle of the peripheral.
+ * \brief Record the exit of the callback.
+ * \ingroup MURASAKI_GROUP
+ */
+#define MURASAKI_TRACE_CALLBACK_EXIT( HANDLE ) MURASAKI_TRACE(murasaki::kteCallbackExit, HANDLE, __func__)
+
+#endif /* MURASAKI_TRACE_HPP_ */
@@ -0,0 +1,75 @@
+/**
+ * @file murasaki_tracehook.h
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief FreeRTOS trace macros for the murasaki trace recorder and the task statistics.
+ * @details
+ * Include this file at the end of the FreeRTOSConfig.h, to record the task switches and the
+ * priority inheritance by the trace recorder, and to measure the tasks by the task statistics :
+ * @code
+ * // USER CODE BEGIN Defines
+ * #include "murasaki_tracehook.h"
+ * // USER CODE END Defines
+ * @endcode
+ *
+ * This file is read by both C and C++. The macros are expanded inside the tasks.c of the FreeRTOS.
+ * So, they can refer the internal of the TCB.
+ *
+ * The hook functions are defined in murasaki_trace.cpp. They do nothing if both the @ref MURASAKI_CONFIG_TRACE and
+ * the @ref MURASAKI_CONFIG_TASK_STATISTICS are false.
+ *
+ * The tick hook keeps the 64bit extension of the murasaki::GetTimebaseTicks() up to date. It is defined in
+ * murasaki_timebase.cpp, and called at every tick interrupt, even while the scheduler is suspended.
+ *
+ * If the configGENERATE_RUN_TIME_STATS is 1, the run time counter of the FreeRTOS is given by the
+ * murasaki::GetTimebaseCounter(). The functions are defined in murasaki_taskstats.cpp. They override the weak
+ * functions generated by the CubeMX.
+ */
+
+#ifndef MURASAKI_TRACEHOOK_H_
+#define MURASAKI_TRACEHOOK_H_
+
+/* Ensure the declarations are only used by C/C++ compilers, as same as the SystemCoreClock. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void MurasakiTraceTaskSwitchedIn(void *task, unsigned int priority);
+void MurasakiTraceTaskSwitchedOut(void *task);
+void MurasakiTraceTaskCreate(void *task, const char *name);
+void MurasakiTracePriorityChange(void *task, unsigned int priority);
+void MurasakiTraceTaskDelete(void *task);
+void MurasakiTimebaseTick(void);
+
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
+
+#define traceTASK_SWITCHED_IN() MurasakiTraceTaskSwitchedIn( pxCurrentTCB, pxCurrentTCB->uxPriority )
+#define traceTASK_SWITCHED_OUT() MurasakiTraceTaskSwitchedOut( pxCurrentTCB )
+#define traceTASK_CREATE( pxNewTCB ) MurasakiTraceTaskCreate( pxNewTCB, pxNewTCB->pcTaskName )
+#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority ) MurasakiTracePriorityChange( pxTCBOfMutexHolder, uxInheritedPriority )
+#define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority ) MurasakiTracePriorityChange( pxTCBOfMutexHolder, uxOriginalPriority )
+#define traceTASK_DELETE( pxTaskToDelete ) MurasakiTraceTaskDelete( pxTaskToDelete )
+/* Some trace tools use this macro. In this case, call MurasakiTimebaseTick() from there. */
+#ifndef traceTASK_INCREMENT_TICK
+#define traceTASK_INCREMENT_TICK( xTickCount ) MurasakiTimebaseTick()
+#endif
+
+/* The CubeMX may define these macros already. */
+#if defined(configGENERATE_RUN_TIME_STATS) && configGENERATE_RUN_TIME_STATS
+#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() configureTimerForRunTimeStats()
+#endif
+#ifndef portGET_RUN_TIME_COUNTER_VALUE
+#define portGET_RUN_TIME_COUNTER_VALUE() getRunTimeCounterValue()
+#endif
+#endif
+
+#endif /* MURASAKI_TRACEHOOK_H_ */
@@ -23,6 +23,131 @@ namespace murasaki {
  */
 void I2cSearch(murasaki::I2cMasterStrategy *master);
 
+/**
+ * @brief Benchmark of the audio DMA data conversion.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param num_of_channels Number of the audio channels.
+ * @param channel_len Number of the samples per channel in a DMA block.
+ * @param iterations Number of the repetition to average.
+ * @details
+ * Measure the CPU cycles of the conversion between the float channels and the DMA data,
+ * for the 32bit word and the packed 24bit word. The result is printed through the
+ * murasaki::debugger with the DMA buffer size of each format.
+ *
+ * The cycles are measured by murasaki::GetCycleCounter(). So, the result is 0 on the
+ * Cortex-M0/M0+.
+ */
+void AudioConversionBenchmark(
+                              unsigned int num_of_channels = 16,
+                              unsigned int channel_len = 48,
+                              unsigned int iterations = 100);
+
+/**
+ * @brief Benchmark of the interrupt masked time by the debug printf.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param iterations Number of the repetition to find the worst case.
+ * @details
+ * Format a typical syslog line, and put it into a FIFO, by two ways :
+ * @li Old way. Format and put with interrupts disabled, into the byte copy FIFO.
+ * @li Current way. Format with interrupts enabled, and put into the lock-free FIFO.
+ *
+ * The worst case of the total cycles and the interrupt masked cycles are printed. The masked cycles
+ * is the additional worst-case interrupt latency by the debug printf. For the current way, the worst
+ * masked cycles observed in murasaki::debugger since the start up is printed too.
+ *
+ * The masked cycles of the current way is not measured, because the masked region is inside the
+ * lock-free FIFO. It is printed as "-", with the modeled value : 0 on the ARMv7-M or later, and the
+ * compare and swap only on the Cortex-M0/M0+/M1.
+ *
+ * The cycles are measured by murasaki::GetCycleCounter(). So, the result is 0 on the
+ * Cortex-M0/M0+.
+ */
+void PrintfLatencyBenchmark(unsigned int iterations = 100);
+
+/**
+ * @brief Benchmark of the formatter.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param iterations Number of the repetition to average.
+ * @details
+ * Format a typical syslog line and an integer / hex line by vsnprintf() and murasaki::Format().
+ * The average cycles per call are printed. See @ref MURASAKI_CONFIG_LIGHT_PRINTF.
+ *
+ * The cycles are measured by murasaki::GetCycleCounter(). So, the result is 0 on the
+ * Cortex-M0/M0+.
+ */
+void FormatBenchmark(unsigned int iterations = 100);
+
+/**
+ * @brief Benchmark of the telemetry against the text.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param iterations Number of the repetition to average.
+ * @details
+ * Sample 4 int16_t variables, and store them into a FIFO as same as the murasaki::Debugger. By the text with the
+ * formatter of the Printf(), and by the data frame of the murasaki::Telemetry. The average CPU cycles and
+ * the bytes on the link per sample are printed. The throughput on the link is inversely proportional to the bytes.
+ *
+ * The cycles are measured by murasaki::GetCycleCounter(). So, the result is 0 on the
+ * Cortex-M0/M0+.
+ */
+void TelemetryBenchmark(unsigned int iterations = 100);
+
+/**
+ * @brief Benchmark of the wake up latency of the synchronizers.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param iterations Number of the repetition.
+ * @details
+ * Release a task waiting with the higher priority, and measure the cycles until the task wakes up.
+ * The murasaki::Synchronizer ( binary semaphore ) and the murasaki::NotificationSynchronizer ( task
+ * notification ) are compared. The average and the worst case are printed.
+ *
+ * The release is done from the task context, to measure without the hardware trigger. The release from the
+ * ISR has the same difference between the two, except the context switch is done by the PendSV.
+ *
+ * Call from the task with the lower priority than murasaki::ktpRealtime.
+ *
+ * The cycles are measured by murasaki::GetCycleCounter(). So, the result is 0 on the
+ * Cortex-M0/M0+.
+ */
+void SynchronizerBenchmark(unsigned int iterations = 100);
+
+/**
+ * @brief Used size of the static arena.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @return Bytes allocated by the operator new from the static arena. 0 if the arena is not used.
+ * @details
+ * Call after the initialization, to tune the @ref PLATFORM_CONFIG_STATIC_ARENA_SIZE.
+ * See @ref MURASAKI_CONFIG_STATIC_ALLOCATION.
+ */
+unsigned int GetStaticArenaUsage();
+
+/**
+ * @brief Print the stack usage of the tasks.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @details
+ * For each murasaki::TaskStrategy object, print the depth of the stack, the minimum headroom by
+ * murasaki::TaskStrategy::getStackMinHeadroom() and the used ratio. Use this report to trim the stack depth.
+ * The headroom is shown as "-" if the task is not started or the stack check is not available.
+ *
+ * The task objects must not be destructed during the report.
+ */
+void ReportTaskStacks();
+
+/**
+ * @brief Benchmark of the uncontended critical sections.
+ * @ingroup MURASAKI_FUNCTION_GROUP
+ * @param iterations Number of the repetition.
+ * @details
+ * Measure the cycles of a pair of Enter() and Leave() without contention, for the murasaki::CriticalSection,
+ * murasaki::RecursiveCriticalSection, murasaki::InterruptCriticalSection and murasaki::SchedulerCriticalSection.
+ * The average and the worst case are printed.
+ *
+ * Call from the task context.
+ *
+ * The cycles are measured by murasaki::GetCycleCounter(). So, the result is 0 on the
+ * Cortex-M0/M0+.
+ */
+void CriticalSectionBenchmark(unsigned int iterations = 100);
+
 }
 
 #endif /* MURASAKI_UTILITY_HPP_ */
@@ -0,0 +1,138 @@
+/*
+ * notificationsynchronizer.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <notificationsynchronizer.hpp>
+#include "waitset.hpp"
+#include "murasaki_assert.hpp"
+#include "murasaki_trace.hpp"
+
+// Use the dedicated index of the notification array, if available ( FreeRTOS V10.4.0 or later ).
+#if defined(configTASK_NOTIFICATION_ARRAY_ENTRIES) && (configTASK_NOTIFICATION_ARRAY_ENTRIES > 1)
+static_assert(PLATFORM_CONFIG_NOTIFICATION_SYNCHRONIZER_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+              "PLATFORM_CONFIG_NOTIFICATION_SYNCHRONIZER_INDEX is out of the notification array");
+#define SYNC_NOTIFY_TAKE(CLEAR, TICKS)\
+    ::ulTaskNotifyTakeIndexed(PLATFORM_CONFIG_NOTIFICATION_SYNCHRONIZER_INDEX, CLEAR, TICKS)
+#define SYNC_NOTIFY_GIVE(TASK)\
+    ::xTaskNotifyGiveIndexed(TASK, PLATFORM_CONFIG_NOTIFICATION_SYNCHRONIZER_INDEX)
+#define SYNC_NOTIFY_GIVE_FROM_ISR(TASK, WOKEN)\
+    ::vTaskNotifyGiveIndexedFromISR(TASK, PLATFORM_CONFIG_NOTIFICATION_SYNCHRONIZER_INDEX, WOKEN)
+#else
+// The index 0 is shared with the stream buffer, the message buffer and the other libraries.
+// The peripheral classes are used by any task. So, they can't share it safely.
+#if MURASAKI_CONFIG_NOTIFICATION_SYNCHRONIZER
+#error "MURASAKI_CONFIG_NOTIFICATION_SYNCHRONIZER needs configTASK_NOTIFICATION_ARRAY_ENTRIES bigger than 1"
+#endif
+#define SYNC_NOTIFY_TAKE(CLEAR, TICKS) ::ulTaskNotifyTake(CLEAR, TICKS)
+#define SYNC_NOTIFY_GIVE(TASK) ::xTaskNotifyGive(TASK)
+#define SYNC_NOTIFY_GIVE_FROM_ISR(TASK, WOKEN) ::vTaskNotifyGiveFromISR(TASK, WOKEN)
+#endif
+
+namespace murasaki {
+
+NotificationSynchronizer::NotificationSynchronizer()
+        :
+          task_(nullptr),
+          pending_(false),
+          wait_set_(nullptr),
+          wait_set_bits_(0)
+{
+}
+
+NotificationSynchronizer::~NotificationSynchronizer()
+{
+}
+
+bool NotificationSynchronizer::Wait(unsigned int timeout_ms)
+                                    {
+    MURASAKI_ASSERT(! murasaki::IsInsideInterrupt());
+    MURASAKI_ASSERT(nullptr == task_);  // Only one task can wait.
+
+    bool released;
+
+    MURASAKI_TRACE(murasaki::kteWaitBegin, this, timeout_ms);
+
+    // Take the release before the wait. Or, register this task as the target of the notification.
+    taskENTER_CRITICAL();
+    {
+        released = pending_;
+        pending_ = false;
+        if (!released)
+            task_ = ::xTaskGetCurrentTaskHandle();
+    }
+    taskEXIT_CRITICAL();
+
+    if (!released) {
+        // If the timeout_ms is the kmsIndefinitely, pass portMAX_DELAY to wait indefinitely.
+        // If not, pass the timeout_ms after converting to tick to wait desired duration.
+        if (murasaki::kwmsIndefinitely == timeout_ms)
+            released = (0 != SYNC_NOTIFY_TAKE(pdTRUE, portMAX_DELAY));
+        else
+            released = (0 != SYNC_NOTIFY_TAKE(pdTRUE, timeout_ms / portTICK_PERIOD_MS));
+
+        // No more notification to this task after here.
+        taskENTER_CRITICAL();
+        {
+            task_ = nullptr;
+        }
+        taskEXIT_CRITICAL();
+
+        // The notification between the timeout and above must not be left to the next Wait() of the other object.
+        if (!released)
+            released = (0 != SYNC_NOTIFY_TAKE(pdTRUE, 0));
+    }
+
+    MURASAKI_TRACE(murasaki::kteWaitEnd, this, released);
+
+    return released;
+}
+
+void NotificationSynchronizer::Release()
+{
+    MURASAKI_TRACE(murasaki::kteRelease, this, murasaki::IsInsideInterrupt());
+
+    // The notification is done inside the critical section. So, Wait() never leaves the task_ which is
+    // being notified.
+    if (! murasaki::IsInsideInterrupt()) {
+        taskENTER_CRITICAL();
+        {
+            if (nullptr != task_)
+                SYNC_NOTIFY_GIVE(task_);
+            else
+                pending_ = true;
+        }
+        taskEXIT_CRITICAL();
+    }
+    else {
+        BaseType_t woken = pdFALSE;
+
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if (nullptr != task_)
+                SYNC_NOTIFY_GIVE_FROM_ISR(task_, &woken);
+            else
+                pending_ = true;
+        }
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+
+        // Request the context switch only when the higher priority task is woken.
+        portYIELD_FROM_ISR(woken);
+    }
+
+    // Signal after the release. So, the task woken by the WaitSet can take this object.
+    if (nullptr != wait_set_)
+        wait_set_->Signal(wait_set_bits_);
+}
+
+void NotificationSynchronizer::AttachWaitSet(WaitSet *wait_set, uint32_t bits)
+                                             {
+    MURASAKI_ASSERT(! murasaki::IsInsideInterrupt());
+
+    wait_set_bits_ = bits;
+    wait_set_ = wait_set;
+}
+
+} /* namespace murasaki */
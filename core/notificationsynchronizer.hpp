@@ -0,0 +1,113 @@
+/**
+ * \file notificationsynchronizer.hpp
+ *
+ * \date 2026/10/18
+ * \author Seiichi "Suikan" Horie
+ * \brief Synchronization between a Task and interrupt by the task notification.
+ */
+
+#ifndef NOTIFICATIONSYNCHRONIZER_HPP_
+#define NOTIFICATIONSYNCHRONIZER_HPP_
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <murasaki_defs.hpp>
+#include "murasaki_config.hpp"
+#include "synchronizer.hpp"
+
+namespace murasaki {
+
+/**
+ * \brief Synchronization class between a task and interrupt, by the direct to task notification.
+ * \details
+ * Same interface with the murasaki::Synchronizer. Instead of the binary semaphore, this class
+ * notifies the waiting task directly. The notification doesn't need the queue operation. So, the
+ * release from the ISR and the wake up of the task are faster, and no kernel object is allocated.
+ *
+ * The release before the wait is kept, as same as the binary semaphore.
+ *
+ * Only one task can wait for an object at a time. This is the case of the peripheral classes, because
+ * the access to the peripheral is serialized by their critical section.
+ *
+ * If the configTASK_NOTIFICATION_ARRAY_ENTRIES is bigger than 1, the notification index
+ * @ref PLATFORM_CONFIG_NOTIFICATION_SYNCHRONIZER_INDEX is used. Otherwise, the index 0 is used.
+ * In this case, the waiting task must not use the task notification for the other purpose. Note that
+ * the stream buffer, the message buffer and some libraries use the index 0 of the task, too. A pending
+ * notification of them releases Wait() spuriously, and Release() may wake them spuriously.
+ *
+ * So, the @ref MURASAKI_CONFIG_NOTIFICATION_SYNCHRONIZER requires the configTASK_NOTIFICATION_ARRAY_ENTRIES
+ * bigger than 1. Otherwise, it is a compile error.
+ *
+ * To use this class in the peripheral classes, see @ref MURASAKI_CONFIG_NOTIFICATION_SYNCHRONIZER.
+ * \ingroup MURASAKI_SYNC_GROUP
+ *
+ */
+class NotificationSynchronizer
+{
+ public:
+    /**
+     * \brief Constructor.
+     */
+    NotificationSynchronizer();
+    /**
+     * \brief Destructor.
+     */
+    virtual ~NotificationSynchronizer();
+    /**
+     * \brief Let the task wait for an interrupt.
+     * \param timeout_ms Timeout by millisecond. The default value let the task wait for interrupt forever.
+     * \return True if interrupt came before timeout. False if timeout happen.
+     * \details
+     * This member function have to be called from the task context. Otherwise, the behavior is
+     * not predictable.
+     */
+    bool Wait(unsigned int timeout_ms = kwmsIndefinitely);
+    /**
+     * \brief Release the task.
+     * \details
+     * Release the task waiting. This member function can be called from both task and the interrupt context.
+     */
+    void Release();
+    /**
+     * \brief Signal a murasaki::WaitSet at every Release().
+     * \param wait_set The WaitSet to signal. nullptr to detach.
+     * \param bits Bits to signal.
+     * \details
+     * The WaitSet is signaled after this object is released. So, the task woken by the WaitSet can
+     * take this object by Wait(0).
+     */
+    void AttachWaitSet(WaitSet *wait_set, uint32_t bits);
+ protected:
+    /**
+     * \brief The task in Wait(). nullptr if no task is waiting.
+     */
+    TaskHandle_t volatile task_;
+    /**
+     * \brief Released while no task is waiting.
+     */
+    volatile bool pending_;
+    /**
+     * \brief WaitSet to signal at Release(). nullptr if not attached.
+     */
+    WaitSet *wait_set_;
+    /**
+     * \brief Bits to signal to the wait_set_.
+     */
+    uint32_t wait_set_bits_;
+};
+
+/**
+ * \brief Synchronizer used by the peripheral classes.
+ * \details
+ * Chosen by the @ref MURASAKI_CONFIG_NOTIFICATION_SYNCHRONIZER.
+ * \ingroup MURASAKI_SYNC_GROUP
+ */
+#if MURASAKI_CONFIG_NOTIFICATION_SYNCHRONIZER
+typedef murasaki::NotificationSynchronizer PeripheralSynchronizer;
+#else
+typedef murasaki::Synchronizer PeripheralSynchronizer;
+#endif
+
+} /* namespace murasaki */
+
+#endif /* NOTIFICATIONSYNCHRONIZER_HPP_ */
@@ -0,0 +1,234 @@
+/*
+ * rttlogger.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "rttlogger.hpp"
+#include "debuggerfifo.hpp"
+#include "murasaki_assert.hpp"
+
+// Ring buffer descriptor. Same layout with the SEGGER_RTT_BUFFER_UP / DOWN.
+struct RttBuffer
+{
+    const char *name;
+    char *buffer;
+    unsigned int size;
+    volatile unsigned int write_offset;
+    volatile unsigned int read_offset;
+    volatile unsigned int flags;
+};
+
+// Control block. Same layout with the SEGGER_RTT_CB. The host searches the id.
+struct RttControlBlock
+{
+    char id[16];
+    int max_num_of_up_buffers;
+    int max_num_of_down_buffers;
+    RttBuffer up[1];
+    RttBuffer down[1];
+};
+
+// The host tools search this symbol name in the ELF.
+// Aligned to the cache line, not to clean or invalidate the other variables.
+extern "C" {
+RttControlBlock _SEGGER_RTT __attribute__((aligned(32))) PLATFORM_CONFIG_RTT_SECTION;
+}
+
+static char rtt_up_buffer[PLATFORM_CONFIG_RTT_UP_BUFFER_SIZE] __attribute__((aligned(32))) PLATFORM_CONFIG_RTT_SECTION;
+static char rtt_down_buffer[PLATFORM_CONFIG_RTT_DOWN_BUFFER_SIZE] __attribute__((aligned(32))) PLATFORM_CONFIG_RTT_SECTION;
+
+// Mode bits of the flags. The host may set the other bits.
+#define RTT_MODE_MASK 3
+
+// The probe accesses the memory, not the D-cache. Write back what the CPU wrote.
+static inline void CleanForHost(const volatile void *address, unsigned int size)
+                                {
+    murasaki::CleanDataCacheByAddress(const_cast<void*>(address), size);
+}
+
+// Discard the cached copy, to read what the probe wrote.
+static inline void RefreshFromHost(const volatile void *address, unsigned int size)
+                                   {
+    murasaki::CleanAndInvalidateDataCacheByAddress(const_cast<void*>(address), size);
+}
+
+namespace murasaki {
+
+RttLogger::RttLogger(murasaki::RttMode mode)
+{
+    RttControlBlock *const cb = &_SEGGER_RTT;
+
+    cb->max_num_of_up_buffers = 1;
+    cb->max_num_of_down_buffers = 1;
+
+    cb->up[0].name = "Terminal";
+    cb->up[0].buffer = rtt_up_buffer;
+    cb->up[0].size = sizeof(rtt_up_buffer);
+    cb->up[0].write_offset = 0;
+    cb->up[0].read_offset = 0;
+    cb->up[0].flags = mode;
+
+    cb->down[0].name = "Terminal";
+    cb->down[0].buffer = rtt_down_buffer;
+    cb->down[0].size = sizeof(rtt_down_buffer);
+    cb->down[0].write_offset = 0;
+    cb->down[0].read_offset = 0;
+    cb->down[0].flags = murasaki::krmSkip;
+
+    // Make the id at run time, to avoid the host finding the id in the initializer data.
+    // And store it at last, to avoid the host reading the incomplete control block.
+    // Each step is written back to keep the order seen by the probe.
+    __sync_synchronize();
+    CleanForHost(cb, sizeof(*cb));
+    ::strcpy(&cb->id[7], "RTT");
+    __sync_synchronize();
+    CleanForHost(cb->id, sizeof(cb->id));
+    ::strcpy(&cb->id[0], "SEGGER");
+    __sync_synchronize();
+    CleanForHost(cb->id, sizeof(cb->id));
+    cb->id[6] = ' ';
+    __sync_synchronize();
+    CleanForHost(cb->id, sizeof(cb->id));
+}
+
+void RttLogger::SetMode(murasaki::RttMode mode)
+                        {
+    _SEGGER_RTT.up[0].flags = (_SEGGER_RTT.up[0].flags & ~RTT_MODE_MASK) | mode;
+    CleanForHost(&_SEGGER_RTT.up[0].flags, sizeof(_SEGGER_RTT.up[0].flags));
+}
+
+void RttLogger::Write(const char message[], unsigned int size, bool can_sleep)
+                      {
+    RttBuffer &up = _SEGGER_RTT.up[0];
+    unsigned int written = 0;
+
+    while (written < size) {
+        // The read offset and the flags are updated by the host at any time.
+        RefreshFromHost(&up, sizeof(up));
+
+        unsigned int mode = up.flags & RTT_MODE_MASK;
+        unsigned int read_offset = up.read_offset;
+        unsigned int write_offset = up.write_offset;
+        unsigned int room =
+                (read_offset > write_offset) ?
+                        read_offset - write_offset - 1 : up.size - (write_offset - read_offset) - 1;
+
+        // The message longer than the ring never fits. Store as possible, instead of dropping it.
+        if (mode == murasaki::krmSkip && size > up.size - 1)
+            mode = murasaki::krmTrim;
+
+        // Entire message or nothing.
+        if (mode == murasaki::krmSkip && written == 0 && room < size)
+            return;
+
+        if (room == 0) {
+            if (mode != murasaki::krmBlock)
+                return;
+            // Wait for the host to drain.
+            if (can_sleep)
+                ::vTaskDelay(1);
+            continue;
+        }
+
+        // Copy the continuous part.
+        unsigned int chunk = std::min(std::min(size - written, room), up.size - write_offset);
+        ::memcpy(&up.buffer[write_offset], &message[written], chunk);
+        CleanForHost(&up.buffer[write_offset], chunk);
+        written += chunk;
+        write_offset += chunk;
+        if (write_offset == up.size)
+            write_offset = 0;
+
+        // Data must be visible before the offset.
+        // The read offset is in the same cache line. Refresh just before the write back, to keep the
+        // window to undo the host update short. See PLATFORM_CONFIG_RTT_SECTION.
+        __sync_synchronize();
+        RefreshFromHost(&up, sizeof(up));
+        up.write_offset = write_offset;
+        CleanForHost(&up.write_offset, sizeof(up.write_offset));
+    }
+}
+
+char RttLogger::Read(bool can_sleep)
+                     {
+    RttBuffer &down = _SEGGER_RTT.down[0];
+
+    // Wait for the input from the host.
+    while (true) {
+        RefreshFromHost(&down, sizeof(down));
+        if (down.read_offset != down.write_offset)
+            break;
+        if (can_sleep)
+            ::vTaskDelay(1);
+    }
+
+    __sync_synchronize();
+    unsigned int read_offset = down.read_offset;
+    RefreshFromHost(&down.buffer[read_offset], 1);
+    char c = down.buffer[read_offset];
+
+    read_offset++;
+    if (read_offset == down.size)
+        read_offset = 0;
+    // The data must be read before the host overwrites it.
+    __sync_synchronize();
+    down.read_offset = read_offset;
+    CleanForHost(&down.read_offset, sizeof(down.read_offset));
+
+    return c;
+}
+
+void RttLogger::putMessage(char message[], unsigned int size)
+                           {
+    MURASAKI_ASSERT(nullptr != message)
+    MURASAKI_ASSERT(!murasaki::IsInsideInterrupt());
+
+    Write(message, size, true);
+}
+
+char RttLogger::getCharacter()
+{
+    MURASAKI_ASSERT(!murasaki::IsInsideInterrupt());
+
+    return Read(true);
+}
+
+void RttLogger::DoPostMortem(void *debugger_fifo)
+                             {
+    // Set the FIFO.
+    DebuggerFifo *const fifo = reinterpret_cast<DebuggerFifo*>(debugger_fifo);
+
+    // Set FIFO mode to post mortem. Now, FIFO is not synchronizing.
+    fifo->SetPostMortem();
+
+    // Never lose the data in post mortem.
+    SetMode(murasaki::krmBlock);
+
+    do {
+        unsigned int transfered_num;
+
+        do {
+            const uint8_t *span;
+
+            // retrieve data from FIFO, without copy.
+            transfered_num = fifo->Peek(&span);
+
+            // The scheduler may not work. Busy wait.
+            Write(reinterpret_cast<const char*>(span), transfered_num, false);
+            fifo->Consume(transfered_num);
+        } while (transfered_num != 0);
+
+        Read(false);  // wait any type in from the host
+
+        fifo->ReWind();  // then, rewind the FIFO.
+    } while (true);
+}
+
+} /* namespace murasaki */
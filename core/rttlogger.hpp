@@ -0,0 +1,109 @@
+/**
+ * \file rttlogger.hpp
+ *
+ * \date 2026/10/18
+ * \author: Seiichi "Suikan" Horie
+ * \brief Logging to the RAM ring by the SEGGER RTT protocol.
+ */
+
+#ifndef RTTLOGGER_HPP_
+#define RTTLOGGER_HPP_
+
+#include <loggerstrategy.hpp>
+#include "murasaki_config.hpp"
+#include "murasaki_defs.hpp"
+
+namespace murasaki {
+/**
+ * \brief Logging to the RAM ring, drained by the debug probe.
+ * \details
+ * The message is stored into the ring in RAM. The ring is described by the control block "_SEGGER_RTT",
+ * which has the same layout with the SEGGER RTT. So, the J-Link RTT Viewer, OpenOCD "rtt" command,
+ * pyOCD and probe-rs can read the message through the SWD, without stopping the CPU. The output is not
+ * limited by the baud rate of the UART.
+ *
+ * The instance of this class can be passed to the murasaki::Debugger constructor, instead of the
+ * murasaki::UartLogger :
+ * @code
+ *     murasaki::platform.logger = new murasaki::RttLogger(murasaki::krmSkip);
+ *     murasaki::debugger = new murasaki::Debugger(murasaki::platform.logger);
+ * @endcode
+ *
+ * The host finds the control block by the ID string "SEGGER RTT" in RAM, or by the address of the symbol
+ * "_SEGGER_RTT" in the ELF. The up buffer 0 is the log output and the down buffer 0 is the key input.
+ * Don't link the SEGGER RTT library together, because the control block is defined by this class.
+ *
+ * The control block is a singleton. Only one instance of this class can be created.
+ *
+ * The probe reads the memory, not the data cache. So, the written data and the offsets are cleaned from
+ * the D-cache, and the offsets written by the host are invalidated before reading, if the D-cache is enabled.
+ * The non-cacheable region is still recommended. See @ref PLATFORM_CONFIG_RTT_SECTION.
+ *
+ * The size of the rings are given by @ref PLATFORM_CONFIG_RTT_UP_BUFFER_SIZE and
+ * @ref PLATFORM_CONFIG_RTT_DOWN_BUFFER_SIZE.
+ *
+ * \ingroup MURASAKI_GROUP
+ */
+class RttLogger : public LoggerStrategy
+{
+ public:
+    /**
+     * \brief Constructor
+     * \param mode Behavior when the ring is full.
+     * \details
+     * Initialize the control block.
+     */
+    RttLogger(murasaki::RttMode mode = murasaki::krmSkip);
+    /**
+     * \brief Message output member function.
+     * \param message Non null terminated character array. This data is stored to the ring.
+     * @param size Size of the message[bytes].
+     * \details
+     * Store the message by the mode. In the krmBlock mode, wait for the room by polling every tick.
+     * If no host is attached, the krmBlock mode blocks the caller forever.
+     *
+     * In the krmSkip mode, a message longer than the ring is stored as the krmTrim mode, because it never fits.
+     */
+    virtual void putMessage(char message[], unsigned int size);
+    /**
+     * \brief Character input member function.
+     * \return A character from the down buffer 0.
+     * \details
+     * Wait for the input from the host, by polling every tick.
+     */
+    virtual char getCharacter();
+    /**
+     * \brief Start post mortem process
+     * \param debugger_fifo Pointer to the DebuggerFifo class object. The data inside this FIFO will be stored to the ring.
+     * \details
+     * Store all data in the FIFO to the ring with busy waiting. Then, wait for a character from
+     * the host, and rewind the FIFO to output again.
+     */
+    virtual void DoPostMortem(void *debugger_fifo);
+
+    /**
+     * \brief Change the behavior when the ring is full.
+     * \param mode New mode.
+     * \details
+     * The host tool may change the mode too.
+     */
+    void SetMode(murasaki::RttMode mode);
+
+ protected:
+    /**
+     * \brief Store the message to the ring.
+     * \param message Message.
+     * \param size Size of the message[bytes].
+     * \param can_sleep true if the wait in the krmBlock mode can sleep. false for busy waiting.
+     */
+    void Write(const char message[], unsigned int size, bool can_sleep);
+    /**
+     * \brief Read a character from the ring.
+     * \param can_sleep true if the wait can sleep. false for busy waiting.
+     */
+    char Read(bool can_sleep);
+};
+
+} /* namespace murasaki */
+
+#endif /* RTTLOGGER_HPP_ */
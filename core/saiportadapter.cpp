@@ -122,35 +122,34 @@ bool SaiPortAdapter::HandleError(void *ptr) {
 // Is this interrupt for this peripheral?
     if (this->Match(ptr)) {
         SAIAUDIO_SYSLOG("Pointer matched")
-        uint32_t error_code = rx_peripheral_->ErrorCode;
+        uint32_t error_code = reinterpret_cast<SAI_HandleTypeDef*>(ptr)->ErrorCode;
         // Check error and display it.
-        if (HAL_SAI_ERROR_OVR | error_code) {
+        if (HAL_SAI_ERROR_OVR & error_code) {
             MURASAKI_SYSLOG(this, kfaSai, kseError, "HAL_SAI_ERROR_OVR")
         }
-        if (HAL_SAI_ERROR_UDR | error_code) {
+        if (HAL_SAI_ERROR_UDR & error_code) {
             MURASAKI_SYSLOG(this, kfaSai, kseError, "HAL_SAI_ERROR_UDR")
         }
-        if (HAL_SAI_ERROR_AFSDET | error_code) {
+        if (HAL_SAI_ERROR_AFSDET & error_code) {
             MURASAKI_SYSLOG(this, kfaSai, kseError, "HAL_SAI_ERROR_AFSDET")
         }
-        if (HAL_SAI_ERROR_LFSDET | error_code) {
+        if (HAL_SAI_ERROR_LFSDET & error_code) {
             MURASAKI_SYSLOG(this, kfaSai, kseError, "HAL_SAI_ERROR_LFSDET")
         }
-        if (HAL_SAI_ERROR_CNREADY | error_code) {
+        if (HAL_SAI_ERROR_CNREADY & error_code) {
             MURASAKI_SYSLOG(this, kfaSai, kseError, "HAL_SAI_ERROR_CNREADY")
         }
-        if (HAL_SAI_ERROR_WCKCFG | error_code) {
+        if (HAL_SAI_ERROR_WCKCFG & error_code) {
             MURASAKI_SYSLOG(this, kfaSai, kseError, "HAL_SAI_ERROR_WCKCFG")
         }
-        if (HAL_SAI_ERROR_TIMEOUT | error_code) {
+        if (HAL_SAI_ERROR_TIMEOUT & error_code) {
             MURASAKI_SYSLOG(this, kfaSai, kseError, "HAL_SAI_ERROR_TIMEOUT")
         }
-        if (HAL_SAI_ERROR_DMA | error_code) {
+        if (HAL_SAI_ERROR_DMA & error_code) {
             MURASAKI_SYSLOG(this, kfaSai, kseError, "HAL_SAI_ERROR_DMA")
         }
-        // This is fatal condition.
+        // The recovery is done by the DuplexAudio. Just report the match.
         SAIAUDIO_SYSLOG("Device matched.")
-        MURASAKI_ASSERT(false)
         return true;
     }
     else {
@@ -204,6 +203,30 @@ void SaiPortAdapter::StartTransferRx(
     SAIAUDIO_SYSLOG("Return")
 }
 
+void SaiPortAdapter::StopTransferTx()
+{
+    SAIAUDIO_SYSLOG("Enter.")
+
+    MURASAKI_ASSERT(nullptr != tx_peripheral_)
+
+    // Stop both DMA and SAI. The error flags are cleared by the next start.
+    HAL_SAI_DMAStop(tx_peripheral_);
+
+    SAIAUDIO_SYSLOG("Return")
+}
+
+void SaiPortAdapter::StopTransferRx()
+{
+    SAIAUDIO_SYSLOG("Enter.")
+
+    MURASAKI_ASSERT(nullptr != rx_peripheral_)
+
+    // Stop both DMA and SAI. The error flags are cleared by the next start.
+    HAL_SAI_DMAStop(rx_peripheral_);
+
+    SAIAUDIO_SYSLOG("Return")
+}
+
 unsigned int SaiPortAdapter::GetNumberOfChannelsRx()
 {
     SAIAUDIO_SYSLOG("Enter.")
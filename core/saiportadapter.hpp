@@ -109,6 +109,20 @@ class SaiPortAdapter : public AudioPortAdapterStrategy {
                                  uint8_t *rx_buffer,
                                  unsigned int channel_len
                                  );
+
+    /**
+     * @brief Stop the TX DMA transfer.
+     * @details
+     * Stop the SAI peripheral and its DMA. Called by the DuplexAudio to recover from the error.
+     */
+    virtual void StopTransferTx();
+
+    /**
+     * @brief Stop the RX DMA transfer.
+     * @details
+     * Stop the SAI peripheral and its DMA. Called by the DuplexAudio to recover from the error.
+     */
+    virtual void StopTransferRx();
     /**
      * @brief Return how many DMA phase is implemented
      * @return Always return 2 for STM32 SAI, becuase the cyclic DMA has halfway and complete interrupt.
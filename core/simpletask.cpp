@@ -13,13 +13,15 @@ murasaki::SimpleTask::SimpleTask(
                                  unsigned short stack_depth,
                                  murasaki::TaskPriority task_priority,
                                  const void* task_parameter,
-                                 void (*task_body_func)(const void*))
+                                 void (*task_body_func)(const void*),
+                                 StackType_t* task_stack)
         :
           murasaki::TaskStrategy(
                                  task_name,
                                  stack_depth,
                                  task_priority,
-                                 task_parameter),
+                                 task_parameter,
+                                 task_stack),
           task_body_func_(task_body_func)
 {
 }
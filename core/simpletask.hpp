@@ -46,6 +46,7 @@ class SimpleTask : public murasaki::TaskStrategy {
      * @param task_priority The task priority. Max priority is defined by configMAX_PRIOIRTIES in FreeRTOSConfig.h
      * @param task_parameter A pointer to the parameter passed to task.
      * @param task_body_func A pointer to the task body function.
+     * @param task_stack Optional stack of the task. Array of the stack_depth elements. See murasaki::TaskStrategy.
      * @details
      * Create an task object. Given parameters are stored internally. And then passed to the
      * FreeRTOS API when task is started by Start() member function.
@@ -59,7 +60,8 @@ class SimpleTask : public murasaki::TaskStrategy {
                unsigned short stack_depth,
                murasaki::TaskPriority task_priority,
                const void * task_parameter,
-               void (*task_body_func)(const void *));
+               void (*task_body_func)(const void *),
+               StackType_t * task_stack = nullptr);
 
  protected:
     /**
@@ -21,8 +21,8 @@ namespace murasaki {
 SpiSlave::SpiSlave(SPI_HandleTypeDef *spi_handle)
         :
         peripheral_(spi_handle),
-        sync_(new murasaki::Synchronizer),
-        critical_section_(new murasaki::CriticalSection),
+        sync_(new murasaki::PeripheralSynchronizer),
+        critical_section_(new murasaki::PeripheralCriticalSection),
         interrupt_status_(kspisUnknown)
 {
     // Setup internal variable with given uart structure.
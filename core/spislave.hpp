@@ -10,7 +10,7 @@
 #define SPISLAVE_HPP_
 
 #include <spislavestrategy.hpp>
-#include <synchronizer.hpp>
+#include <notificationsynchronizer.hpp>
 #include "criticalsection.hpp"
 
 // Check if CubeIDE genrated SPI module
@@ -160,8 +160,8 @@ class SpiSlave : public SpiSlaveStrategy
     virtual void* GetPeripheralHandle();
      protected:
     SPI_HandleTypeDef *const peripheral_;        // SPI peripheral handler.
-    Synchronizer *const sync_;          // sync between task and interrupt
-    CriticalSection *const critical_section_;    // protect memberfunction
+    PeripheralSynchronizer *const sync_;          // sync between task and interrupt
+    PeripheralCriticalSection *const critical_section_;    // protect memberfunction
  private:
     SpiStatus interrupt_status_;
 };
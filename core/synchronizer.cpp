@@ -6,7 +6,9 @@
  */
 
 #include <synchronizer.hpp>
+#include "waitset.hpp"
 #include "murasaki_assert.hpp"
+#include "murasaki_trace.hpp"
 
 namespace murasaki {
 
@@ -14,7 +16,13 @@ Synchronizer::Synchronizer()
         :
           // Create a semaphore as "empty" state.
           // Because it is empty, task is blocked if a task take that semaphore.
-          semaphore_(xSemaphoreCreateBinary())
+#if MURASAKI_CONFIG_STATIC_ALLOCATION
+          semaphore_(xSemaphoreCreateBinaryStatic(&semaphore_buffer_)),
+#else
+          semaphore_(xSemaphoreCreateBinary()),
+#endif
+          wait_set_(nullptr),
+          wait_set_bits_(0)
 {
     MURASAKI_ASSERT(semaphore_ != nullptr)
 }
@@ -29,29 +37,52 @@ bool Synchronizer::Wait(unsigned int timeout_ms)
                         {
     MURASAKI_ASSERT(! murasaki::IsInsideInterrupt());
 
+    bool released;
+
+    MURASAKI_TRACE(murasaki::kteWaitBegin, this, timeout_ms);
+
     // If the timeout_ms is the kmsIndefinitely, pass portMAX_DELAY to wait indefinitely.
     // If not, pass the timeout_ms after converting to tick to wait desired duration.
     if (murasaki::kwmsIndefinitely == timeout_ms)
-        return (pdTRUE == xSemaphoreTake(semaphore_, portMAX_DELAY));
+        released = (pdTRUE == xSemaphoreTake(semaphore_, portMAX_DELAY));
     else
-        return (pdTRUE == xSemaphoreTake(semaphore_, timeout_ms / portTICK_PERIOD_MS));
+        released = (pdTRUE == xSemaphoreTake(semaphore_, timeout_ms / portTICK_PERIOD_MS));
+
+    MURASAKI_TRACE(murasaki::kteWaitEnd, this, released);
 
+    return released;
 }
 
 void Synchronizer::Release()
 {
+    MURASAKI_TRACE(murasaki::kteRelease, this, murasaki::IsInsideInterrupt());
+
     // The FreeRTOS API is context dependent.
     // To work correctly, we have to refer the context informaiton.
     if (! murasaki::IsInsideInterrupt())
         ::xSemaphoreGive(semaphore_ );
     else {
-        ::xSemaphoreGiveFromISR(semaphore_, nullptr);
+        BaseType_t woken = pdFALSE;
+
+        ::xSemaphoreGiveFromISR(semaphore_, &woken);
         // This is essential part to trigger the context switch right after returning from ISR.
         // Without calling this macro, context switch happens only at the next context switch request in task.
         // This is very confusing design of FreeRTOS.
-        portYIELD_FROM_ISR(true);
+        // Request the switch only when the higher priority task is woken. Otherwise, it is wasted.
+        portYIELD_FROM_ISR(woken);
     }
 
+    // Signal after the release. So, the task woken by the WaitSet can take this object.
+    if (nullptr != wait_set_)
+        wait_set_->Signal(wait_set_bits_);
+}
+
+void Synchronizer::AttachWaitSet(WaitSet *wait_set, uint32_t bits)
+                                 {
+    MURASAKI_ASSERT(! murasaki::IsInsideInterrupt());
+
+    wait_set_bits_ = bits;
+    wait_set_ = wait_set;
 }
 
 } /* namespace murasaki */
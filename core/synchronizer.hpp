@@ -11,10 +11,14 @@
 
 #include <FreeRTOS.h>
 #include <semphr.h>
+#include <stdint.h>
 #include <murasaki_defs.hpp>
+#include "murasaki_config.hpp"
 
 namespace murasaki {
 
+class WaitSet;
+
 /**
  * \brief Synchronization class between a task and interrupt.
  * This class provide the synchronization between a task and interrupt.
@@ -52,8 +56,31 @@ class Synchronizer
      * Release the task waiting. This member function can be called from both task and the interrupt context.
      */
     void Release();
+    /**
+     * \brief Signal a murasaki::WaitSet at every Release().
+     * \param wait_set The WaitSet to signal. nullptr to detach.
+     * \param bits Bits to signal.
+     * \details
+     * The WaitSet is signaled after this object is released. So, the task woken by the WaitSet can
+     * take this object by Wait(0).
+     */
+    void AttachWaitSet(WaitSet *wait_set, uint32_t bits);
      protected:
+#if MURASAKI_CONFIG_STATIC_ALLOCATION
+    /**
+     * \brief Storage of the semaphore. See @ref MURASAKI_CONFIG_STATIC_ALLOCATION.
+     */
+    StaticSemaphore_t semaphore_buffer_;
+#endif
     SemaphoreHandle_t const semaphore_;
+    /**
+     * \brief WaitSet to signal at Release(). nullptr if not attached.
+     */
+    WaitSet *wait_set_;
+    /**
+     * \brief Bits to signal to the wait_set_.
+     */
+    uint32_t wait_set_bits_;
 };
 
 } /* namespace murasaki */
@@ -0,0 +1,82 @@
+/*
+ * taskmonitor.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include "taskmonitor.hpp"
+#include "murasaki_taskstats.hpp"
+#include "murasaki_assert.hpp"
+
+// Report periodically.
+static void TaskMonitorTaskBody(const void *ptr);
+
+namespace murasaki {
+
+TaskMonitor::TaskMonitor(unsigned int period_ms)
+        :
+          period_ms_(period_ms),
+          running_(false),
+          task_(
+                new murasaki::SimpleTask(
+                                         "TaskMonitor",
+                                         PLATFORM_CONFIG_TASK_MONITOR_TASK_STACK_SIZE,
+                                         PLATFORM_CONFIG_TASK_MONITOR_TASK_PRIORITY,
+                                         this,
+                                         &TaskMonitorTaskBody))
+{
+    MURASAKI_ASSERT(0 < period_ms)
+    MURASAKI_ASSERT(nullptr != task_)
+
+    task_->Start();
+}
+
+TaskMonitor::~TaskMonitor()
+{
+    if (task_ != nullptr)
+        delete task_;
+}
+
+void TaskMonitor::Start()
+{
+    // Drop the window before the start.
+    murasaki::UpdateTaskStatistics();
+    running_ = true;
+}
+
+void TaskMonitor::Stop()
+{
+    running_ = false;
+}
+
+unsigned int TaskMonitor::GetPeriod()
+{
+    return period_ms_;
+}
+
+void TaskMonitor::Report()
+{
+    if (!running_)
+        return;
+
+    murasaki::UpdateTaskStatistics();
+    murasaki::ReportTaskStatistics();
+}
+
+} /* namespace murasaki */
+
+static void TaskMonitorTaskBody(const void *ptr)
+                                {
+    MURASAKI_ASSERT(ptr != nullptr);
+
+    // ptr is regarded as pointer to the TaskMonitor.
+    murasaki::TaskMonitor *const monitor = static_cast<murasaki::TaskMonitor*>(const_cast<void*>(ptr));
+    TickType_t wake = ::xTaskGetTickCount();
+
+    while (true) {
+        // Keep the period regardless of the time to print.
+        ::vTaskDelayUntil(&wake, pdMS_TO_TICKS(monitor->GetPeriod()));
+        monitor->Report();
+    }
+}
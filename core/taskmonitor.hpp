@@ -0,0 +1,97 @@
+/**
+ * @file taskmonitor.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Periodic report of the task statistics.
+ */
+
+#ifndef TASKMONITOR_HPP_
+#define TASKMONITOR_HPP_
+
+#include "murasaki_config.hpp"
+#include "murasaki_defs.hpp"
+#include "simpletask.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Periodic reporter of the CPU usage of the tasks.
+ * @details
+ * The internal task calls murasaki::UpdateTaskStatistics() every period, and prints the table by
+ * murasaki::ReportTaskStatistics() through the murasaki::debugger :
+ * @code
+ *     murasaki::platform.monitor = new murasaki::TaskMonitor(1000);    // Every second.
+ *     murasaki::platform.monitor->Start();
+ * @endcode
+ *
+ * The table looks like :
+ * @code
+ *             Task statistics
+ * Task             | CPU [%] | Switches | Max slice [uS] |  Total switches
+ * -----------------+---------+----------+----------------+----------------
+ * IDLE             |    71.3 |      998 |           1002 |           51230
+ * Audio            |    24.9 |     1000 |            250 |           51000
+ * DebugTask        |     3.6 |       12 |            850 |             512
+ * @endcode
+ * The @ref MURASAKI_CONFIG_TASK_STATISTICS have to be true, and the murasaki_tracehook.h have to be included
+ * at the end of the FreeRTOSConfig.h.
+ *
+ * The report takes the bandwidth of the debugger. Use the long period, like a second.
+ * The CPU usage of the each task can be obtained by murasaki::TaskStrategy::GetCpuUsage() too.
+ * @ingroup MURASAKI_GROUP
+ */
+class TaskMonitor
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param period_ms Report period [mS].
+     * @details
+     * The internal task starts to run. But nothing is printed until Start() is called.
+     */
+    TaskMonitor(unsigned int period_ms);
+    /**
+     * @brief Destructor.
+     */
+    virtual ~TaskMonitor();
+
+    /**
+     * @brief Start the report.
+     * @details
+     * The first window starts here.
+     */
+    void Start();
+
+    /**
+     * @brief Stop the report.
+     * @details
+     * The measurement continues. So, murasaki::TaskStrategy::GetCpuUsage() shows the last window.
+     */
+    void Stop();
+
+    /**
+     * @brief Close the window and print the report.
+     * @details
+     * Called by the internal task every period. Do not call from the other context.
+     */
+    void Report();
+
+    /**
+     * @brief Report period.
+     * @return Period [mS].
+     */
+    unsigned int GetPeriod();
+
+ protected:
+    const unsigned int period_ms_;
+    volatile bool running_;
+    /**
+     * @brief Reporting task.
+     */
+    murasaki::SimpleTask *const task_;
+};
+
+} /* namespace murasaki */
+
+#endif /* TASKMONITOR_HPP_ */
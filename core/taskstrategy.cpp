@@ -7,26 +7,60 @@
 
 #include <taskstrategy.hpp>
 #include "murasaki_assert.hpp"
+#include "murasaki_taskstats.hpp"
+#include "murasaki_timebase.hpp"
 
 namespace murasaki {
 
 TaskStrategy::TaskStrategy(const char * task_name, unsigned short stack_depth, murasaki::TaskPriority priority,
-                           const void * parameter)
+                           const void * parameter, StackType_t * task_stack)
         : name_(task_name),
           stack_depth_(stack_depth),
           parameter_(parameter),
-          priority_(priority)
+          priority_(priority),
+#if MURASAKI_CONFIG_STATIC_ALLOCATION
+          // Allocate from the static arena, if not given.
+          stack_((nullptr != task_stack) ? task_stack : new StackType_t[stack_depth]),
+#else
+          stack_(task_stack),
+#endif
+          own_stack_(task_stack != stack_),
+          // Only the static task needs the TCB. Not to waste the RAM of the task on the heap.
+          tcb_((nullptr != stack_) ? new StaticTask_t : nullptr)
 {
+    MURASAKI_ASSERT(nullptr != stack_ || ! MURASAKI_CONFIG_STATIC_ALLOCATION);
+    MURASAKI_ASSERT(nullptr == stack_ || configSUPPORT_STATIC_ALLOCATION);  // static task needs the static API.
+    MURASAKI_ASSERT(nullptr != stack_ || configSUPPORT_DYNAMIC_ALLOCATION);  // heap task needs the dynamic API.
     MURASAKI_ASSERT(nullptr != task_name);
     MURASAKI_ASSERT(0 != stack_depth);  // reject only very explict fault.
     MURASAKI_ASSERT(configMAX_PRIORITIES > priority);  // priority is allowed till ( configMAX_PRIORITIES - 1 )
     MURASAKI_ASSERT(0 < priority);  // priority 0 is idle task
     task_ = 0;
+
+    // Register to the top of the list. The constructor may be called before the scheduler starts.
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    next_task_ = first_task_;
+    first_task_ = this;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
 }
 
 TaskStrategy::~TaskStrategy()
 {
-    vTaskDelete(task_);
+    // Remove from the list.
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    for (TaskStrategy **link = &first_task_; *link != nullptr; link = &(*link)->next_task_)
+        if (*link == this) {
+            *link = next_task_;
+            break;
+        }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    // vTaskDelete(nullptr) deletes the calling task. Delete only if started.
+    if (nullptr != task_)
+        vTaskDelete(task_);
+    if (own_stack_)
+        delete[] stack_;
+    delete tcb_;
 }
 
 void TaskStrategy::Start()
@@ -38,6 +72,22 @@ void TaskStrategy::Start()
     // So FreeRTOS API can start the as task.
     // The passed static function calls TaskBody() member funciton, which is
     // defined by user.
+#if configSUPPORT_STATIC_ALLOCATION
+    // The stack is given. Create the task without heap.
+    if (nullptr != stack_) {
+        task_ = ::xTaskCreateStatic(TaskStrategy::Launch,  // task entity;
+                name_,  // name of task
+                stack_depth_,  // stack depth, as same as xTaskCreate()
+                this,  // See AbstractTask::Launch for the details.
+                priority_,  // Execution priority of task
+                stack_,  // stack of task
+                tcb_  // task control block
+                );
+        MURASAKI_ASSERT(nullptr != task_);
+        return;
+    }
+#endif
+#if configSUPPORT_DYNAMIC_ALLOCATION
     BaseType_t task_result = ::xTaskCreate(TaskStrategy::Launch,  // task entity;
             name_,  // name of task
             stack_depth_,  // stack depth [byte]
@@ -46,6 +96,10 @@ void TaskStrategy::Start()
             &task_  // receive the task handle if success.
             );
     MURASAKI_ASSERT(task_result != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY);
+#else
+    // No stack is given, and no heap to create a task.
+    MURASAKI_ASSERT(false);
+#endif
 
 }
 
@@ -77,6 +131,47 @@ int TaskStrategy::getStackMinHeadroom()
 #endif
 }
 
+float TaskStrategy::GetCpuUsage()
+{
+    murasaki::TaskStatistics stats;
+
+    murasaki::GetTaskStatistics(task_, &stats);
+    return stats.cpu_usage;
+}
+
+unsigned int TaskStrategy::GetContextSwitches()
+{
+    murasaki::TaskStatistics stats;
+
+    murasaki::GetTaskStatistics(task_, &stats);
+    return stats.context_switches;
+}
+
+unsigned int TaskStrategy::GetMaxTimeSlice()
+{
+    murasaki::TaskStatistics stats;
+
+    murasaki::GetTaskStatistics(task_, &stats);
+    return murasaki::TimebaseToMicroseconds(stats.max_time_slice);
+}
+
+TaskHandle_t TaskStrategy::GetTaskHandle()
+{
+    return task_;
+}
+
+TaskStrategy* TaskStrategy::GetFirstTask()
+{
+    return first_task_;
+}
+
+TaskStrategy* TaskStrategy::GetNextTask()
+{
+    return next_task_;
+}
+
+TaskStrategy *TaskStrategy::first_task_ = nullptr;
+
 // This is a static member function
 void TaskStrategy::Launch(void * ptr)
                           {
@@ -12,6 +12,7 @@
 #include <FreeRTOS.h>
 #include <task.h>
 #include <murasaki_defs.hpp>
+#include "murasaki_config.hpp"
 
 namespace murasaki {
 
@@ -40,9 +41,16 @@ class TaskStrategy
      * @param stack_depth [Byte]
      * @param task_priority Priority of the task. from 1 to up to configMAX_PRIORITIES -1. The high number is the high priority.
      * @param task_parameter Optional parameter to the task.
+     * @param task_stack Optional stack of the task. Array of the stack_depth elements. nullptr to allocate internally.
+     * @details
+     * If the task_stack is given, the task is created by xTaskCreateStatic(). The configSUPPORT_STATIC_ALLOCATION
+     * must be 1. The task_stack must be kept until the destruction of this object.
+     *
+     * If the task_stack is nullptr and the @ref MURASAKI_CONFIG_STATIC_ALLOCATION is true, the stack is allocated
+     * from the static arena.
      */
     TaskStrategy(const char *task_name, unsigned short stack_depth, murasaki::TaskPriority task_priority,
-                 const void *task_parameter);
+                 const void *task_parameter, StackType_t *task_stack = nullptr);
     /**
      * @brief Destructor
      */
@@ -92,12 +100,73 @@ class TaskStrategy
      */
     int getStackMinHeadroom();
 
+    /**
+     * @brief Obtain the CPU usage of the task.
+     * @return CPU usage in the last window [%]. 0 if the task is not measured.
+     * @details
+     * The window is the period between the last two murasaki::UpdateTaskStatistics() calls. Usually, they are
+     * called by the murasaki::TaskMonitor.
+     *
+     * The @ref MURASAKI_CONFIG_TASK_STATISTICS have to be true. Otherwise, this function returns 0.
+     */
+    float GetCpuUsage();
+
+    /**
+     * @brief Obtain the count of the context switches.
+     * @return Count of the switch out since the creation. 0 if the task is not measured.
+     * @details
+     * The @ref MURASAKI_CONFIG_TASK_STATISTICS have to be true. Otherwise, this function returns 0.
+     */
+    unsigned int GetContextSwitches();
+
+    /**
+     * @brief Obtain the longest time slice.
+     * @return Longest time from the switch in to the switch out, since the creation [uS].
+     * 0 if the task is not measured.
+     * @details
+     * The @ref MURASAKI_CONFIG_TASK_STATISTICS have to be true. Otherwise, this function returns 0.
+     */
+    unsigned int GetMaxTimeSlice();
+
+    /**
+     * @brief Obtain the FreeRTOS task handle.
+     * @return The task handle. nullptr if the task is not started.
+     */
+    TaskHandle_t GetTaskHandle();
+
+    /**
+     * @brief Obtain the first task object in the registry.
+     * @return The first task object. nullptr if no task object exists.
+     * @details
+     * All the task objects are registered at the construction, and removed at the destruction.
+     * Use with GetNextTask() to walk through the tasks :
+     * @code
+     *     for (murasaki::TaskStrategy *task = murasaki::TaskStrategy::GetFirstTask();
+     *          task != nullptr;
+     *          task = task->GetNextTask())
+     *         murasaki::debugger->Printf("%s\n", task->GetName());
+     * @endcode
+     * The task objects must not be destructed during the walk.
+     */
+    static TaskStrategy* GetFirstTask();
+
+    /**
+     * @brief Obtain the next task object in the registry.
+     * @return The next task object. nullptr if this is the last one.
+     */
+    TaskStrategy* GetNextTask();
+
  protected:
     TaskHandle_t task_;                 // Task handle of FreeRTOS
     const char *const name_;           // Name of task in FreeRTOS
     const unsigned short stack_depth_;  // Stack depth specification.
     const void *const parameter_;            // Optional parameter to pass the @ref TaskBody().
     const murasaki::TaskPriority priority_;        //
+    StackType_t *const stack_;           // Stack given by constructor or allocated internally. nullptr if not static.
+    const bool own_stack_;              // true if stack_ is allocated internally.
+    StaticTask_t *const tcb_;           // Task control block for xTaskCreateStatic(). nullptr if not static.
+    TaskStrategy *next_task_;           // Registry of the task objects.
+    static TaskStrategy *first_task_;   // Registry of the task objects.
 
     /**
      * @brief Internal use only. Create a task from TaskBody()
@@ -0,0 +1,199 @@
+/*
+ * telemetry.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "telemetry.hpp"
+#include "debugger.hpp"
+#include "murasaki_assert.hpp"
+#include "murasaki_timebase.hpp"
+
+// "MLTD" and "MLTS" in little endian. Never be an address of the deferred log format.
+#define TELEMETRY_ID_DESCRIPTOR 0x44544C4Du
+#define TELEMETRY_ID_DATA 0x53544C4Du
+
+// Longest name in the descriptor, including the null termination [byte].
+#define TELEMETRY_NAME_SIZE 32
+
+// Interval of the descriptor frames [mS].
+#define TELEMETRY_DESCRIPTOR_INTERVAL 1000
+
+static_assert(PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS <= 32,
+              "PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS must be up to 32");
+
+// Sample periodically.
+static void TelemetryTaskBody(const void *ptr);
+
+namespace murasaki {
+
+Telemetry::Telemetry(unsigned int period_ms)
+        :
+          num_of_channels_(0),
+          period_ms_(period_ms),
+          count_(0),
+          running_(false),
+          task_(
+                new murasaki::SimpleTask(
+                                         "Telemetry",
+                                         PLATFORM_CONFIG_TELEMETRY_TASK_STACK_SIZE,
+                                         PLATFORM_CONFIG_TELEMETRY_TASK_PRIORITY,
+                                         this,
+                                         &TelemetryTaskBody))
+{
+    MURASAKI_ASSERT(0 < period_ms)
+    MURASAKI_ASSERT(nullptr != task_)
+
+    task_->Start();
+}
+
+Telemetry::~Telemetry()
+{
+    if (task_ != nullptr)
+        delete task_;
+}
+
+void Telemetry::RegisterChannel(const char *name, const volatile void *address, murasaki::TelemetryType type,
+                                unsigned int divider)
+                                {
+    MURASAKI_ASSERT(nullptr != name)
+    MURASAKI_ASSERT(nullptr != address)
+    MURASAKI_ASSERT(0 < divider)
+    MURASAKI_ASSERT(!running_)
+    MURASAKI_ASSERT(num_of_channels_ < PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS)
+
+    if (num_of_channels_ < PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS) {
+        Channel &channel = channels_[num_of_channels_];
+        channel.name = name;
+        channel.address = address;
+        channel.type = type;
+        channel.divider = divider;
+        num_of_channels_++;
+    }
+}
+
+void Telemetry::Start()
+{
+    count_ = 0;
+    running_ = true;
+}
+
+void Telemetry::Stop()
+{
+    running_ = false;
+}
+
+unsigned int Telemetry::GetPeriod()
+{
+    return period_ms_;
+}
+
+void Telemetry::SendDescriptors()
+{
+    for (unsigned int i = 0; i < num_of_channels_; i++) {
+        const Channel &channel = channels_[i];
+        unsigned int name_len = std::min(static_cast<unsigned int>(::strlen(channel.name)), TELEMETRY_NAME_SIZE - 1u);
+        // Header and name with the null termination, padded to the word.
+        uint32_t frame[5 + TELEMETRY_NAME_SIZE / sizeof(uint32_t)];
+        unsigned int num_of_words = 5 + (name_len + sizeof(uint32_t)) / sizeof(uint32_t);
+
+        ::memset(frame, 0, sizeof(frame));
+        frame[0] = TELEMETRY_ID_DESCRIPTOR;
+        frame[1] = static_cast<uint32_t>(murasaki::GetTimebaseTicks());
+        frame[2] = i | (channel.type << 8) | (num_of_channels_ << 16);
+        frame[3] = period_ms_ * channel.divider * 1000;     // Sampling interval [uS].
+        frame[4] = murasaki::GetTimebaseFrequency();
+        ::memcpy(&frame[5], channel.name, name_len);
+
+        murasaki::debugger->PutDeferredLog(frame, num_of_words);
+    }
+}
+
+void Telemetry::Sample()
+{
+    if (!running_)
+        return;
+
+    // Let the host join at any time.
+    if (count_ % std::max(1u, TELEMETRY_DESCRIPTOR_INTERVAL / period_ms_) == 0)
+        SendDescriptors();
+
+    unsigned int num_of_words = PackData();
+    count_++;
+
+    if (num_of_words != 0)
+        murasaki::debugger->PutDeferredLog(frame_, num_of_words);
+}
+
+unsigned int Telemetry::PackData()
+{
+    uint8_t *const values = reinterpret_cast<uint8_t*>(&frame_[3]);
+    unsigned int size = 0;
+    uint32_t mask = 0;
+
+    for (unsigned int i = 0; i < num_of_channels_; i++) {
+        const Channel &channel = channels_[i];
+
+        if (count_ % channel.divider != 0)
+            continue;
+
+        mask |= 1u << i;
+        // Read once by the size of the variable, then pack by its size.
+        switch (channel.type) {
+            case murasaki::ktlInt8:
+            case murasaki::ktlUint8: {
+                uint8_t value = *static_cast<const volatile uint8_t*>(channel.address);
+                ::memcpy(&values[size], &value, sizeof(value));
+                size += sizeof(value);
+                break;
+            }
+            case murasaki::ktlInt16:
+            case murasaki::ktlUint16: {
+                uint16_t value = *static_cast<const volatile uint16_t*>(channel.address);
+                ::memcpy(&values[size], &value, sizeof(value));
+                size += sizeof(value);
+                break;
+            }
+            default: {
+                uint32_t value = *static_cast<const volatile uint32_t*>(channel.address);
+                ::memcpy(&values[size], &value, sizeof(value));
+                size += sizeof(value);
+                break;
+            }
+        }
+    }
+
+    if (mask == 0)
+        return 0;
+
+    // Pad the last word.
+    while (size % sizeof(uint32_t) != 0)
+        values[size++] = 0;
+
+    frame_[0] = TELEMETRY_ID_DATA;
+    frame_[1] = static_cast<uint32_t>(murasaki::GetTimebaseTicks());
+    frame_[2] = mask;
+
+    return 3 + size / sizeof(uint32_t);
+}
+
+} /* namespace murasaki */
+
+static void TelemetryTaskBody(const void *ptr)
+                              {
+    MURASAKI_ASSERT(ptr != nullptr);
+
+    // ptr is regarded as pointer to the Telemetry.
+    murasaki::Telemetry *const telemetry = static_cast<murasaki::Telemetry*>(const_cast<void*>(ptr));
+    TickType_t wake = ::xTaskGetTickCount();
+
+    while (true) {
+        // Keep the period regardless of the time to sample.
+        ::vTaskDelayUntil(&wake, pdMS_TO_TICKS(telemetry->GetPeriod()));
+        telemetry->Sample();
+    }
+}
@@ -0,0 +1,182 @@
+/**
+ * @file telemetry.hpp
+ *
+ * @date 2026/10/18
+ * @author Seiichi "Suikan" Horie
+ * @brief Binary telemetry channel on the debug console.
+ */
+
+#ifndef TELEMETRY_HPP_
+#define TELEMETRY_HPP_
+
+#include <stdint.h>
+#include <type_traits>
+
+#include "murasaki_config.hpp"
+#include "murasaki_defs.hpp"
+#include "simpletask.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Type of the telemetry variable.
+ * @return The murasaki::TelemetryType of T.
+ * @details
+ * Integers up to 32bit and float are supported.
+ * @ingroup MURASAKI_HELPER_GROUP
+ */
+template<typename T>
+constexpr murasaki::TelemetryType TelemetryTypeOf()
+{
+    return std::is_floating_point<T>::value ? murasaki::ktlFloat :
+           sizeof(T) == 1 ? (std::is_signed<T>::value ? murasaki::ktlInt8 : murasaki::ktlUint8) :
+           sizeof(T) == 2 ? (std::is_signed<T>::value ? murasaki::ktlInt16 : murasaki::ktlUint16) :
+                            (std::is_signed<T>::value ? murasaki::ktlInt32 : murasaki::ktlUint32);
+}
+
+/**
+ * @brief Sampler of the variables to the binary telemetry frames.
+ * @details
+ * The telemetry streams the variables to the PC plotter, through the murasaki::debugger. The frames share
+ * the link with the text by murasaki::Debugger::Printf() and the @ref MURASAKI_DEFERRED_LOG.
+ *
+ * Register the variables, and start the sampling :
+ * @code
+ *     murasaki::platform.telemetry = new murasaki::Telemetry(10);    // 10mS period.
+ *     murasaki::platform.telemetry->Register("level", &audio_level);
+ *     murasaki::platform.telemetry->Register("position", &encoder_position, 10);   // Every 100mS.
+ *     murasaki::platform.telemetry->Start();
+ * @endcode
+ *
+ * Each variable is sampled every period x divider. The sampled values in a period are packed into one
+ * data frame by their own size. For example, 4 int16_t values take 22 bytes including the frame header.
+ * The same values take 30 - 40 bytes by the Printf() in decimal, and the CPU time of the vsnprintf().
+ * See murasaki::TelemetryBenchmark() to measure both on the target.
+ *
+ * The frames are same format with the deferred log frame. The text never contains 0x00 :
+ * @li 0x00 : start of frame.
+ * @li N : number of the payload words. 1 byte.
+ * @li ID : "MLTD" for the descriptor frame, "MLTS" for the data frame.
+ * @li Timestamp : lower 32bit of the murasaki::GetTimebaseTicks().
+ *
+ * The descriptor frame is sent for each variable at the start, and every second. So, the host can join
+ * the stream at any time. It contains the index, type, sampling interval, timebase frequency and the name.
+ *
+ * The data frame contains the bit mask of the sampled variables, and their values packed by the
+ * size of their type, in the order of the index. The last word is padded by 0.
+ *
+ * The stream is decoded by the host side tool :
+ * @code
+ * python3 tools/murasaki_telemetry.py capture.bin > telemetry.csv
+ * @endcode
+ *
+ * @ingroup MURASAKI_GROUP
+ */
+class Telemetry
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param period_ms Sampling period [mS].
+     * @details
+     * The internal task starts to run. But no frame is sent until Start() is called.
+     */
+    Telemetry(unsigned int period_ms);
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Telemetry();
+
+    /**
+     * @brief Register a variable.
+     * @tparam T Type of the variable. Integers up to 32bit and float.
+     * @param name Name of the variable. Must be a constant. Up to 31 characters are sent.
+     * @param variable Address of the variable.
+     * @param divider The variable is sampled every period x divider.
+     * @details
+     * Up to @ref PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS variables. Call before Start().
+     *
+     * The variable is read by the telemetry task without lock. So, the value wider than the CPU word
+     * may be torn.
+     */
+    template<typename T>
+    void Register(const char *name, const volatile T *variable, unsigned int divider = 1)
+                  {
+        static_assert((std::is_integral<T>::value && sizeof(T) <= sizeof(uint32_t)) || std::is_same<T, float>::value,
+                      "Telemetry supports the integers up to 32bit and float");
+        RegisterChannel(name, variable, murasaki::TelemetryTypeOf<T>(), divider);
+    }
+
+    /**
+     * @brief Start to send the frames.
+     * @details
+     * The descriptor frames are sent first.
+     */
+    void Start();
+
+    /**
+     * @brief Stop to send the frames.
+     */
+    void Stop();
+
+    /**
+     * @brief Sample the variables and send a data frame.
+     * @details
+     * Called by the internal task every period. Do not call from the other context.
+     */
+    void Sample();
+
+    /**
+     * @brief Sampling period.
+     * @return Period [mS].
+     */
+    unsigned int GetPeriod();
+
+ protected:
+    /**
+     * @brief Registered variable.
+     */
+    struct Channel
+    {
+        const char *name;
+        const volatile void *address;
+        murasaki::TelemetryType type;
+        unsigned int divider;
+    };
+
+    /**
+     * @brief Add a variable to the channel table.
+     */
+    void RegisterChannel(const char *name, const volatile void *address, murasaki::TelemetryType type,
+                         unsigned int divider);
+    /**
+     * @brief Send the descriptor frames of all variables.
+     */
+    void SendDescriptors();
+    /**
+     * @brief Sample the variables due in this period, and pack them into the frame_.
+     * @return Number of the words of the data frame. 0 if no variable is due.
+     */
+    unsigned int PackData();
+
+    Channel channels_[PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS];
+    unsigned int num_of_channels_;
+    const unsigned int period_ms_;
+    /**
+     * @brief Number of the periods since Start().
+     */
+    unsigned int count_;
+    volatile bool running_;
+    /**
+     * @brief Frame buffer. ID, timestamp, mask and 4 bytes per variable at most.
+     */
+    uint32_t frame_[3 + PLATFORM_CONFIG_TELEMETRY_NUM_OF_CHANNELS];
+    /**
+     * @brief Sampling task.
+     */
+    murasaki::SimpleTask *const task_;
+};
+
+} /* namespace murasaki */
+
+#endif /* TELEMETRY_HPP_ */
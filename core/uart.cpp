@@ -21,10 +21,10 @@ namespace murasaki {
 Uart::Uart(UART_HandleTypeDef *const uart)
         :
         peripheral_(uart),
-        tx_sync_(new murasaki::Synchronizer),
-        rx_sync_(new murasaki::Synchronizer),
-        tx_critical_section_(new murasaki::CriticalSection),
-        rx_critical_section_(new murasaki::CriticalSection),
+        tx_sync_(new murasaki::PeripheralSynchronizer),
+        rx_sync_(new murasaki::PeripheralSynchronizer),
+        tx_critical_section_(new murasaki::PeripheralCriticalSection),
+        rx_critical_section_(new murasaki::PeripheralCriticalSection),
         tx_interrupt_status_(kursUnknown),
         rx_interrupt_status_(kursUnknown)
 {
@@ -116,44 +116,66 @@ murasaki::UartStatus Uart::Transmit(
                                     {
     UART_SYSLOG("Enter");
 
+    TransmitStart(data, size);
+
+    UART_SYSLOG("Leave");
+    return TransmitWait(timeout_ms);
+}
+
+murasaki::UartStatus Uart::TransmitStart(
+                                         const uint8_t *data,
+                                         unsigned int size)
+                                         {
+    UART_SYSLOG("Enter");
+
     MURASAKI_ASSERT(nullptr != data)
     MURASAKI_ASSERT(65536 >= size);
 
     // make this method re-entrant in task context.
+    // Leave at the TransmitWait().
     tx_critical_section_->Enter();
+
+    UART_SYSLOG("Start transmitting")
+    // The value will be filled by interrupt.
+    tx_interrupt_status_ = murasaki::kursTimeOut;
+    // Keep coherence between the L2 and cache before DMA
+    // No need to invalidate
+    murasaki::CleanDataCacheByAddress(
+                                      const_cast<uint8_t*>(data),
+                                      size);
+
+    HAL_StatusTypeDef status = HAL_UART_Transmit_DMA(peripheral_, const_cast<uint8_t*>(data), size);
+    MURASAKI_ASSERT(HAL_OK == status);
+
+    UART_SYSLOG("Leave");
+    return murasaki::kursOK;
+}
+
+murasaki::UartStatus Uart::TransmitWait(unsigned int timeout_ms)
+                                        {
+    UART_SYSLOG("Enter");
+
+    tx_sync_->Wait(timeout_ms);
+    UART_SYSLOG("Sync released");
+
+    // check result
+    switch (tx_interrupt_status_)
     {
-        UART_SYSLOG("Start transmitting")
-        // The value will be filled by interrupt.
-        tx_interrupt_status_ = murasaki::kursTimeOut;
-        // Keep coherence between the L2 and cache before DMA
-        // No need to invalidate
-        murasaki::CleanDataCacheByAddress(
-                                          const_cast<uint8_t*>(data),
-                                          size);
-
-        HAL_StatusTypeDef status = HAL_UART_Transmit_DMA(peripheral_, const_cast<uint8_t*>(data), size);
-        MURASAKI_ASSERT(HAL_OK == status);
-
-        tx_sync_->Wait(timeout_ms);
-        UART_SYSLOG("Sync released");
-
-        // check result
-        switch (tx_interrupt_status_)
-        {
-            case murasaki::kursOK:
-                UART_SYSLOG("Transmission complete successfully")
-                break;
-            case murasaki::kursTimeOut:
-                MURASAKI_SYSLOG(this, kfaSerial, kseWarning, "Transmission timeout")
-                // TODO: probably, we should think how to know the number of transmission.
-                break;
-            default:
-                MURASAKI_SYSLOG(this, kfaSerial, kseEmergency, "Error is not handled")
-                // Re-initializing device
-                HAL_UART_DeInit(peripheral_);
-                HAL_UART_Init(peripheral_);
-        }
+        case murasaki::kursOK:
+            UART_SYSLOG("Transmission complete successfully")
+            break;
+        case murasaki::kursTimeOut:
+            MURASAKI_SYSLOG(this, kfaSerial, kseWarning, "Transmission timeout")
+            // TODO: probably, we should think how to know the number of transmission.
+            break;
+        default:
+            MURASAKI_SYSLOG(this, kfaSerial, kseEmergency, "Error is not handled")
+            // Re-initializing device
+            HAL_UART_DeInit(peripheral_);
+            HAL_UART_Init(peripheral_);
     }
+
+    // Entered at the TransmitStart().
     tx_critical_section_->Leave();
 
     UART_SYSLOG("Leave");
@@ -192,64 +214,96 @@ murasaki::UartStatus Uart::Receive(
                                    {
     UART_SYSLOG("Enter");
 
+    ReceiveStart(data, size);
+
+    UART_SYSLOG("Leave");
+    return ReceiveWait(timeout_ms);
+}
+
+murasaki::UartStatus Uart::ReceiveStart(
+                                        uint8_t *data,
+                                        unsigned int size)
+                                        {
+    UART_SYSLOG("Enter");
+
     MURASAKI_ASSERT(nullptr != data);
     MURASAKI_ASSERT(65536 > size);
 
     // make this method re-entrant in task context.
+    // Leave at the ReceiveWait().
     rx_critical_section_->Enter();
+
+    UART_SYSLOG("Start receiving")
+
+    rx_interrupt_status_ = murasaki::kursTimeOut;
+    // Keep coherence between the L2 and cache before DMA
+    // Need to invalidate
+    murasaki::CleanAndInvalidateDataCacheByAddress(data, size);
+
+    HAL_StatusTypeDef status = HAL_UART_Receive_DMA(peripheral_, data, size);
+    MURASAKI_ASSERT(HAL_OK == status);
+
+    UART_SYSLOG("Leave");
+    return murasaki::kursOK;
+}
+
+murasaki::UartStatus Uart::ReceiveWait(unsigned int timeout_ms)
+                                       {
+    UART_SYSLOG("Enter");
+
+    rx_sync_->Wait(timeout_ms);
+    UART_SYSLOG("Sync released")
+
+    // check result
+    switch (rx_interrupt_status_)
     {
-        UART_SYSLOG("Start receiving")
-
-        rx_interrupt_status_ = murasaki::kursTimeOut;
-        // Keep coherence between the L2 and cache before DMA
-        // Need to invalidate
-        murasaki::CleanAndInvalidateDataCacheByAddress(data, size);
-
-        HAL_StatusTypeDef status = HAL_UART_Receive_DMA(peripheral_, data, size);
-        MURASAKI_ASSERT(HAL_OK == status);
-
-        rx_sync_->Wait(timeout_ms);
-        UART_SYSLOG("Sync released")
-
-        // check result
-        switch (rx_interrupt_status_)
-        {
-            case murasaki::kursOK:
-                UART_SYSLOG("Receiving complete successfully")
-                break;
-            case murasaki::kursTimeOut:
-                MURASAKI_SYSLOG(this, kfaSerial, kseWarning, "Receiving timeout")
-                // return without resetting device.
-                break;
-            case murasaki::kursFrame:
-                case murasaki::kursParity:
-                case murasaki::kursNoise:
-                MURASAKI_SYSLOG(this, kfaSerial, kseWarning, "Receiving error by frame, parity or noise error")
-                // return without resetting device.
-                break;
-            case murasaki::kursOverrun:
-                MURASAKI_SYSLOG(this, kfaSerial, kseError, "Overrun error on transmission. ")
-                break;
-            case murasaki::kursDMA:
-                MURASAKI_SYSLOG(this, kfaSerial, kseError, "Un-recoverable DMA error. Peripheral re-initialized")
-                // Re-initializing device
-                HAL_UART_DeInit(peripheral_);
-                HAL_UART_Init(peripheral_);
-                break;
-            default:
-                MURASAKI_SYSLOG(this, kfaSerial, kseEmergency, "Error is not handled. Peripheral re-initialized.")
-                // Re-initializing device
-                HAL_UART_DeInit(peripheral_);
-                HAL_UART_Init(peripheral_);
-                break;
-        }
+        case murasaki::kursOK:
+            UART_SYSLOG("Receiving complete successfully")
+            break;
+        case murasaki::kursTimeOut:
+            MURASAKI_SYSLOG(this, kfaSerial, kseWarning, "Receiving timeout")
+            // return without resetting device.
+            break;
+        case murasaki::kursFrame:
+            case murasaki::kursParity:
+            case murasaki::kursNoise:
+            MURASAKI_SYSLOG(this, kfaSerial, kseWarning, "Receiving error by frame, parity or noise error")
+            // return without resetting device.
+            break;
+        case murasaki::kursOverrun:
+            MURASAKI_SYSLOG(this, kfaSerial, kseError, "Overrun error on transmission. ")
+            break;
+        case murasaki::kursDMA:
+            MURASAKI_SYSLOG(this, kfaSerial, kseError, "Un-recoverable DMA error. Peripheral re-initialized")
+            // Re-initializing device
+            HAL_UART_DeInit(peripheral_);
+            HAL_UART_Init(peripheral_);
+            break;
+        default:
+            MURASAKI_SYSLOG(this, kfaSerial, kseEmergency, "Error is not handled. Peripheral re-initialized.")
+            // Re-initializing device
+            HAL_UART_DeInit(peripheral_);
+            HAL_UART_Init(peripheral_);
+            break;
     }
+
+    // Entered at the ReceiveStart().
     rx_critical_section_->Leave();
 
     UART_SYSLOG("Leave");
     return rx_interrupt_status_;
 }
 
+void Uart::AttachWaitSet(murasaki::WaitSet *wait_set, uint32_t tx_bits, uint32_t rx_bits)
+                         {
+    UART_SYSLOG("Enter");
+
+    tx_sync_->AttachWaitSet(wait_set, tx_bits);
+    rx_sync_->AttachWaitSet(wait_set, rx_bits);
+
+    UART_SYSLOG("Leave");
+}
+
 void Uart::SetSpeed(unsigned int baud_rate)
                     {
     UART_SYSLOG("Enter");
@@ -9,9 +9,10 @@
 #ifndef UART_HPP_
 #define UART_HPP_
 
-#include <synchronizer.hpp>
+#include <notificationsynchronizer.hpp>
 #include <uartstrategy.hpp>
 #include "criticalsection.hpp"
+#include "waitset.hpp"
 
 // Check if CubeIDE generates UART module
 #ifdef HAL_UART_MODULE_ENABLED
@@ -131,6 +132,29 @@ class Uart : public UartStrategy
                                           const uint8_t *data,
                                           unsigned int size,
                                           unsigned int timeout_ms);
+    /**
+     * \brief Start to transmit raw data through an UART by DMA.
+     * \param data Data buffer to be transmitted. Must be kept until TransmitWait() returns.
+     * \param size The count of the data ( byte ) to be transfered. Must be smaller than 65536
+     * \return Always murasaki::kursOK.
+     * \details
+     * Start the DMA and return immediately. The calling task must call TransmitWait() to finish the transmission.
+     * The mutex is kept locked from this member function until the TransmitWait(). So, the other tasks
+     * can't interrupt the transmission.
+     *
+     * This function is forbiddedn to call from ISR.
+     */
+    virtual murasaki::UartStatus TransmitStart(
+                                               const uint8_t *data,
+                                               unsigned int size);
+    /**
+     * \brief Wait for the end of the transmission started by TransmitStart().
+     * \param timeout_ms Time out limit by milliseconds.
+     * \return Status of the transmission.
+     * \details
+     * This function is forbiddedn to call from ISR.
+     */
+    virtual murasaki::UartStatus TransmitWait(unsigned int timeout_ms);
     /**
      * \brief Receive raw data through an UART by synchronous mode.
      * \param data Data buffer to place the received data..
@@ -163,6 +187,41 @@ class Uart : public UartStrategy
                                          unsigned int *transfered_count,
                                          UartTimeout uart_timeout,
                                          unsigned int timeout_ms);
+    /**
+     * \brief Start to receive raw data through an UART by DMA.
+     * \param data Data buffer to place the received data. Must be kept until ReceiveWait() returns.
+     * \param size The count of the data ( byte ) to be transfered. Must be smaller than 65536
+     * \return Always murasaki::kursOK.
+     * \details
+     * Start the DMA and return immediately. The calling task must call ReceiveWait() to finish the receiving.
+     * The mutex is kept locked from this member function until the ReceiveWait(). So, the other tasks
+     * can't interrupt the receiving.
+     *
+     * This function is forbiddedn to call from ISR.
+     */
+    virtual murasaki::UartStatus ReceiveStart(
+                                              uint8_t *data,
+                                              unsigned int size);
+    /**
+     * \brief Wait for the end of the receiving started by ReceiveStart().
+     * \param timeout_ms Time out limit by milliseconds.
+     * \return Status of the receiving. Same with the Receive().
+     * \details
+     * This function is forbiddedn to call from ISR.
+     */
+    virtual murasaki::UartStatus ReceiveWait(unsigned int timeout_ms);
+    /**
+     * \brief Signal a murasaki::WaitSet at the end of the transmission and receiving.
+     * \param wait_set The WaitSet to signal. nullptr to detach.
+     * \param tx_bits Bits to signal at the end of the transmission. 0 not to signal.
+     * \param rx_bits Bits to signal at the end of the receiving. 0 not to signal.
+     * \details
+     * Start the transfer by TransmitStart() or ReceiveStart(), and wait for the WaitSet. Then, the signaled
+     * transfer can be finished by TransmitWait(0) or ReceiveWait(0) without blocking.
+     *
+     * This function is forbiddedn to call from ISR.
+     */
+    virtual void AttachWaitSet(murasaki::WaitSet *wait_set, uint32_t tx_bits, uint32_t rx_bits);
     /**
      * \brief Call back for entire block transfer completion.
      * \param ptr Pointer to UART_HandleTypeDef struct.
@@ -243,11 +302,11 @@ class Uart : public UartStrategy
  protected:
     UART_HandleTypeDef *const peripheral_;
 
-    Synchronizer *const tx_sync_;
-    Synchronizer *const rx_sync_;
+    PeripheralSynchronizer *const tx_sync_;
+    PeripheralSynchronizer *const rx_sync_;
 
-    CriticalSection *const tx_critical_section_;
-    CriticalSection *const rx_critical_section_;
+    PeripheralCriticalSection *const tx_critical_section_;
+    PeripheralCriticalSection *const rx_critical_section_;
 
  private:
     murasaki::UartStatus tx_interrupt_status_, rx_interrupt_status_;
@@ -5,6 +5,8 @@
  *      Author: Seiichi "Suikan" Horie
  */
 
+#include <algorithm>
+
 #include "uartlogger.hpp"
 #include "murasaki_config.hpp"
 #include "murasaki_assert.hpp"
@@ -34,6 +36,22 @@ void UartLogger::putMessage(char message[], unsigned int size)
 
 }
 
+void UartLogger::StartMessage(char message[], unsigned int size)
+                              {
+    MURASAKI_ASSERT(nullptr != message)
+    MURASAKI_ASSERT(65536 > size);
+    MURASAKI_ASSERT(! murasaki::IsInsideInterrupt());
+    uart_->TransmitStart(reinterpret_cast<uint8_t *>(message),  // Message to send
+            size  // length of message by byte.
+            );
+}
+
+void UartLogger::WaitMessage()
+{
+    MURASAKI_ASSERT(! murasaki::IsInsideInterrupt());
+    uart_->TransmitWait(PLATFORM_CONFIG_DEBUG_SERIAL_TIMEOUT);
+}
+
 char UartLogger::getCharacter()
 {
     char buf;
@@ -62,16 +80,19 @@ void UartLogger::DoPostMortem(void* debugger_fifo) {
 
     do {
         uint16_t transfered_num;
-        uint8_t data[10];  // data transfer buffer.
+        uint8_t data;  // receive buffer.
 
         do {
-            // retrieve data from FIFO.
-            transfered_num = fifo->Get(data, sizeof(data));
+            const uint8_t *span;
+
+            // retrieve data from FIFO, without copy.
+            transfered_num = std::min(fifo->Peek(&span), 65535u);
 
-            HAL_UART_Transmit(huart, data, transfered_num, HAL_MAX_DELAY);  // no time out.
+            HAL_UART_Transmit(huart, const_cast<uint8_t*>(span), transfered_num, HAL_MAX_DELAY);  // no time out.
+            fifo->Consume(transfered_num);
         } while (transfered_num != 0);
 
-        HAL_UART_Receive(huart, data, 1, HAL_MAX_DELAY);  // wait any type in from UART
+        HAL_UART_Receive(huart, &data, 1, HAL_MAX_DELAY);  // wait any type in from UART
 
         fifo->ReWind();  // then, rewind the FIFO.
     } while (true);
@@ -41,6 +41,18 @@ class UartLogger : public LoggerStrategy
      * @param size Size of the message[bytes].  Must be smaller than 65536
      */
     virtual void putMessage(char message[], unsigned int size);
+    /**
+     * \brief Start the message output by the UART DMA.
+     * \param message Non null terminated character array. Must be kept until WaitMessage() returns.
+     * @param size Size of the message[bytes].  Must be smaller than 65536
+     * \details
+     * The caller can prepare the next message during the DMA. Then, the UART line is kept busy.
+     */
+    virtual void StartMessage(char message[], unsigned int size);
+    /**
+     * \brief Wait for the end of the DMA started by StartMessage().
+     */
+    virtual void WaitMessage();
     virtual char getCharacter();
     /**
      * \brief Start post mortem process
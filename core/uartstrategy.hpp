@@ -62,6 +62,35 @@ class UartStrategy : public murasaki::PeripheralStrategy {
                                           const uint8_t * data,
                                           unsigned int size,
                                           unsigned int timeout_ms = murasaki::kwmsIndefinitely) = 0;
+    /**
+     * \brief Start the buffer transmission over the UART. asynchronous
+     * \param data Pointer to the buffer to be sent. Must be kept until the TransmitWait() returns.
+     * \param size Number of the data to be sent.
+     * \return Status of the start.
+     * \details
+     * Start the transmission and return without waiting for the end of it. The TransmitWait() must be called
+     * after this member function by the same task. The task can prepare the next data during the transmission.
+     *
+     * By default, this member function calls the synchronous Transmit(). The derived class can override it
+     * by the DMA.
+     */
+    virtual murasaki::UartStatus TransmitStart(
+                                               const uint8_t * data,
+                                               unsigned int size)
+                                               {
+        return Transmit(data, size);
+    }
+    ;
+    /**
+     * \brief Wait for the end of the transmission started by TransmitStart().
+     * \param timeout_ms Time out by mili Second.
+     * \return Status of the IO processing
+     */
+    virtual murasaki::UartStatus TransmitWait(unsigned int timeout_ms = murasaki::kwmsIndefinitely)
+                                              {
+        return murasaki::kursOK;
+    }
+    ;
     /**
      * \brief buffer receive over the UART. synchronous
      * \param data Pointer to the buffer to save the received data.
@@ -0,0 +1,91 @@
+/*
+ * waitset.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include "waitset.hpp"
+#include "murasaki_assert.hpp"
+
+namespace murasaki {
+
+WaitSet::WaitSet()
+        :
+          sync_(new Synchronizer()),
+          pending_(0)
+{
+    MURASAKI_ASSERT(nullptr != sync_)
+}
+
+WaitSet::~WaitSet()
+{
+    delete sync_;
+}
+
+void WaitSet::Signal(uint32_t bits)
+                     {
+    {
+        CriticalSectionGuard<InterruptCriticalSection> guard(&section_);
+        pending_ |= bits;
+    }
+    // The waiting task checks the pending_ by itself. So, the release without wait is harmless.
+    sync_->Release();
+}
+
+void WaitSet::Clear(uint32_t bits)
+                    {
+    CriticalSectionGuard<InterruptCriticalSection> guard(&section_);
+    pending_ &= ~bits;
+}
+
+uint32_t WaitSet::WaitAny(uint32_t bits, unsigned int timeout_ms)
+                          {
+    return Wait(bits, false, timeout_ms);
+}
+
+uint32_t WaitSet::WaitAll(uint32_t bits, unsigned int timeout_ms)
+                          {
+    return Wait(bits, true, timeout_ms);
+}
+
+uint32_t WaitSet::Wait(uint32_t bits, bool all, unsigned int timeout_ms)
+                       {
+    MURASAKI_ASSERT(!murasaki::IsInsideInterrupt());
+    MURASAKI_ASSERT(0 != bits)
+
+    const TickType_t start = ::xTaskGetTickCount();
+    const TickType_t timeout_ticks = timeout_ms / portTICK_PERIOD_MS;
+
+    while (true) {
+        uint32_t fired;
+
+        // Take the bits if the condition is satisfied.
+        {
+            CriticalSectionGuard<InterruptCriticalSection> guard(&section_);
+            fired = pending_ & bits;
+            if ((all && fired != bits) || (0 == fired))
+                fired = 0;
+            else
+                pending_ &= ~fired;
+        }
+
+        if (0 != fired)
+            return fired;
+
+        // Not yet. Wait for the next signal in the remaining time.
+        if (murasaki::kwmsIndefinitely == timeout_ms)
+            sync_->Wait();
+        else {
+            TickType_t elapsed = ::xTaskGetTickCount() - start;
+
+            if (elapsed >= timeout_ticks)
+                return 0;
+            sync_->Wait((timeout_ticks - elapsed) * portTICK_PERIOD_MS);
+        }
+    }
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,127 @@
+/**
+ * \file waitset.hpp
+ *
+ * \date 2026/10/18
+ * \author Seiichi "Suikan" Horie
+ * \brief Waiting for several synchronizers and peripherals at once.
+ */
+
+#ifndef WAITSET_HPP_
+#define WAITSET_HPP_
+
+#include <stdint.h>
+#include <murasaki_defs.hpp>
+#include "synchronizer.hpp"
+#include "criticalsection.hpp"
+
+namespace murasaki {
+
+/**
+ * \brief Let a task wait for any or all of the several sources.
+ * \details
+ * Each source is identified by the bits given by the programmer. A source signals its bits by
+ * Signal(). The task waits by WaitAny() or WaitAll(), and knows which sources fired by the returned bits.
+ * So, one task can service several peripherals with one wake up, instead of one task for each.
+ *
+ * The murasaki::Synchronizer and murasaki::NotificationSynchronizer can be attached to a WaitSet by their
+ * AttachWaitSet(). Then, their Release() signals the WaitSet. Some peripherals provide the AttachWaitSet() to
+ * attach their internal synchronizers.
+ *
+ * @code
+ *     murasaki::WaitSet *wait_set = new murasaki::WaitSet();
+ *
+ *     uart->AttachWaitSet(wait_set, 0, kUartRx);
+ *     exti->AttachWaitSet(wait_set, kButton);
+ *     adc->AttachWaitSet(wait_set, kAdc);
+ *
+ *     uart->ReceiveStart(rx_buffer, sizeof(rx_buffer));
+ *     adc->ConvertStart(ADC_CHANNEL_1);
+ *
+ *     while (true) {
+ *         uint32_t fired = wait_set->WaitAny(kUartRx | kButton | kAdc);
+ *
+ *         if (fired & kUartRx) {
+ *             uart->ReceiveWait(0);  // Returns immediately.
+ *             ...
+ *             uart->ReceiveStart(rx_buffer, sizeof(rx_buffer));
+ *         }
+ *         if (fired & kButton) {
+ *             exti->Wait(0);         // Returns immediately.
+ *             ...
+ *         }
+ *         ...
+ *     }
+ * @endcode
+ *
+ * The bits are kept until they are taken by WaitAny() or WaitAll(). So, the signal before the wait is not lost.
+ * A source signaled twice before the wait is reported once.
+ *
+ * The waiting side is a task. Only one task can wait for an object at a time. The signaling side can be both the
+ * task and ISR.
+ *
+ * \ingroup MURASAKI_SYNC_GROUP
+ */
+class WaitSet
+{
+ public:
+    /**
+     * \brief Constructor.
+     */
+    WaitSet();
+    /**
+     * \brief Destructor.
+     */
+    virtual ~WaitSet();
+    /**
+     * \brief Signal the sources.
+     * \param bits Bits of the sources signaled.
+     * \details
+     * Set the bits and release the waiting task. The task checks its condition again.
+     * This member function can be called from both task and the interrupt context.
+     */
+    void Signal(uint32_t bits);
+    /**
+     * \brief Wait for any of the sources.
+     * \param bits Bits of the sources to wait for. Must not be 0.
+     * \param timeout_ms Timeout by millisecond. The default value let the task wait forever.
+     * \return The bits signaled in the given bits. 0 if timeout happen.
+     * \details
+     * The returned bits are cleared. The other bits are kept.
+     *
+     * This member function have to be called from the task context.
+     */
+    uint32_t WaitAny(uint32_t bits, unsigned int timeout_ms = kwmsIndefinitely);
+    /**
+     * \brief Wait for all of the sources.
+     * \param bits Bits of the sources to wait for. Must not be 0.
+     * \param timeout_ms Timeout by millisecond. The default value let the task wait forever.
+     * \return The given bits if all of them are signaled. 0 if timeout happen.
+     * \details
+     * The given bits are cleared only when all of them are signaled. At the timeout, the bits are kept.
+     *
+     * This member function have to be called from the task context.
+     */
+    uint32_t WaitAll(uint32_t bits, unsigned int timeout_ms = kwmsIndefinitely);
+    /**
+     * \brief Clear the signaled bits.
+     * \param bits Bits to clear.
+     * \details
+     * Useful to discard the old signals before starting the peripherals.
+     * This member function can be called from both task and the interrupt context.
+     */
+    void Clear(uint32_t bits);
+
+ private:
+    uint32_t Wait(uint32_t bits, bool all, unsigned int timeout_ms);
+
+    // Release the waiting task.
+    Synchronizer *const sync_;
+    // Protect the pending_ from the task and ISR.
+    InterruptCriticalSection section_;
+    // Signaled bits.
+    uint32_t pending_;
+};
+
+} /* namespace murasaki */
+
+#endif /* WAITSET_HPP_ */
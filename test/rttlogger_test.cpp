@@ -0,0 +1,300 @@
+/*
+ * rttlogger_test.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ *
+ * Host test of the murasaki::RttLogger. A simulated probe drains the up buffer from the other thread.
+ *
+ * Build and run on the host, from the top of the repository :
+ *
+ *     g++ -std=gnu++14 -pthread -Itest/stubs -Icore test/rttlogger_test.cpp -o rttlogger_test && ./rttlogger_test
+ *
+ * The D-cache is emulated. The probe accesses the "memory", a copy of the control block and the rings.
+ * The CPU side reaches the memory only through the cache maintenance functions. So, a missing clean or
+ * invalidate shows up as lost or stale data. The cache line granularity is not emulated.
+ */
+
+#include <assert.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+// Replace the target dependent headers of the rttlogger.cpp by the declarations below.
+#define LOGGERSTRATEGY_HPP_
+#define MURASAKI_CONFIG_HPP_
+#define MURASAKI_DEFS_HPP_
+#define DEBUGGERFIFO_HPP_
+#define MURASAKI_ASSERT_HPP_
+
+#define PLATFORM_CONFIG_RTT_UP_BUFFER_SIZE 256
+#define PLATFORM_CONFIG_RTT_DOWN_BUFFER_SIZE 16
+#define PLATFORM_CONFIG_RTT_SECTION
+#define MURASAKI_ASSERT(COND) assert(COND);
+
+namespace murasaki {
+enum RttMode {
+    krmSkip = 0,
+    krmTrim = 1,
+    krmBlock = 2
+};
+
+class LoggerStrategy
+{
+ public:
+    virtual ~LoggerStrategy()
+    {
+    }
+    virtual void putMessage(char message[], unsigned int size) = 0;
+    virtual char getCharacter() = 0;
+    virtual void DoPostMortem(void *debugger_fifo)
+                              {
+    }
+};
+
+class DebuggerFifo
+{
+ public:
+    void SetPostMortem()
+    {
+    }
+    unsigned int Peek(uint8_t const **data, unsigned int offset = 0)
+                      {
+        return 0;
+    }
+    void Consume(unsigned int size)
+                 {
+    }
+    void ReWind()
+    {
+    }
+};
+
+static inline bool IsInsideInterrupt()
+{
+    return false;
+}
+
+void CleanDataCacheByAddress(void *address, size_t size);
+void CleanAndInvalidateDataCacheByAddress(void *address, size_t size);
+} /* namespace murasaki */
+
+#include "rttlogger.cpp"
+
+void vTaskDelay(TickType_t ticks)
+                {
+    ::sched_yield();
+}
+
+/* ------------------------- Emulated memory ------------------------- */
+
+// Memory seen by the probe. The CPU sees its cache, that is, the original variables.
+static std::mutex memory_lock;
+static RttControlBlock memory_cb;
+static char memory_up[PLATFORM_CONFIG_RTT_UP_BUFFER_SIZE];
+static char memory_down[PLATFORM_CONFIG_RTT_DOWN_BUFFER_SIZE];
+
+// Translate the address of the CPU to the memory.
+static char* ToMemory(const volatile void *address, size_t size)
+                      {
+    const char *const p = const_cast<const char*>(reinterpret_cast<const volatile char*>(address));
+    const struct {
+        const void *cpu;
+        void *memory;
+        size_t size;
+    } regions[] = {
+            { &_SEGGER_RTT, &memory_cb, sizeof(memory_cb) },
+            { rtt_up_buffer, memory_up, sizeof(memory_up) },
+            { rtt_down_buffer, memory_down, sizeof(memory_down) } };
+
+    for (auto &region : regions) {
+        const char *const start = reinterpret_cast<const char*>(region.cpu);
+        if (start <= p && p + size <= start + region.size)
+            return reinterpret_cast<char*>(region.memory) + (p - start);
+    }
+    assert(false);  // Maintenance out of the RTT area.
+    return nullptr;
+}
+
+void murasaki::CleanDataCacheByAddress(void *address, size_t size)
+                                       {
+    std::lock_guard<std::mutex> lock(memory_lock);
+    ::memcpy(ToMemory(address, size), address, size);
+}
+
+void murasaki::CleanAndInvalidateDataCacheByAddress(void *address, size_t size)
+                                                    {
+    std::lock_guard<std::mutex> lock(memory_lock);
+    ::memcpy(address, ToMemory(address, size), size);
+}
+
+/* ------------------------- Simulated probe ------------------------- */
+
+static std::atomic<bool> writer_done;
+
+// Search the id, then drain the up buffer until the writer finishes.
+// If slow is true, read a little at a time to let the ring be full.
+static std::string Drain(bool slow)
+                         {
+    std::string received;
+
+    while (true) {
+        std::lock_guard<std::mutex> lock(memory_lock);
+        if (0 == ::memcmp(memory_cb.id, "SEGGER RTT", 11))
+            break;
+    }
+
+    while (true) {
+        const bool done = writer_done.load();
+        bool empty;
+        {
+            std::lock_guard<std::mutex> lock(memory_lock);
+            RttBuffer &up = memory_cb.up[0];
+            const char *const buffer = ToMemory(up.buffer, up.size);
+            unsigned int read_offset = up.read_offset;
+            unsigned int count = 0;
+
+            assert(sizeof(memory_up) == up.size);
+            while (read_offset != up.write_offset && !(slow && count == 16)) {
+                received += buffer[read_offset];
+                read_offset = (read_offset + 1) % up.size;
+                count++;
+            }
+            up.read_offset = read_offset;
+            empty = (read_offset == up.write_offset);
+        }
+        if (done && empty)
+            break;
+        if (slow)
+            ::usleep(20);
+    }
+    return received;
+}
+
+// Set the mode by the host, with a bit outside of the mode.
+static void SetModeByHost(murasaki::RttMode mode)
+                          {
+    std::lock_guard<std::mutex> lock(memory_lock);
+    memory_cb.up[0].flags = 0x100 | mode;
+}
+
+static std::string MakeLine(int i)
+                            {
+    char line[64];
+    int length = ::snprintf(line, sizeof(line), "<message %05d abcdefghijklmnopqrstuvwxyz>\n", i);
+    return std::string(line, length);
+}
+
+// Each line must be complete and in order.
+static bool IsCompleteLines(const std::string &received, unsigned int *num_of_lines)
+                            {
+    const std::string sample = MakeLine(0);
+    size_t position = 0;
+    int last = -1;
+
+    *num_of_lines = 0;
+    while (position < received.size()) {
+        std::string line = received.substr(position, sample.size());
+        int index;
+        if (line.size() != sample.size() || 1 != ::sscanf(line.c_str(), "<message %d", &index)
+                || line != MakeLine(index) || index <= last)
+            return false;
+        last = index;
+        position += sample.size();
+        (*num_of_lines)++;
+    }
+    return true;
+}
+
+static int failures = 0;
+
+static void Check(bool condition, const char *name, const char *detail)
+                  {
+    ::printf("%s: %s %s\n", condition ? "OK" : "NG", name, detail);
+    if (!condition)
+        failures++;
+}
+
+int main()
+{
+    murasaki::RttLogger logger(murasaki::krmSkip);
+    const murasaki::RttMode modes[] = { murasaki::krmBlock, murasaki::krmSkip, murasaki::krmTrim };
+    char detail[64];
+
+    for (murasaki::RttMode mode : modes) {
+        std::string sent;
+        std::string received;
+
+        SetModeByHost(mode);
+        writer_done = false;
+        std::thread probe([&received] {
+            received = Drain(true);
+        });
+
+        for (int i = 0; i < 3000; i++) {
+            std::string line = MakeLine(i);
+            logger.putMessage(&line[0], line.size());
+            sent += line;
+        }
+        writer_done = true;
+        probe.join();
+
+        unsigned int num_of_lines;
+        ::snprintf(detail, sizeof(detail), "(%u of %u bytes)",
+                   static_cast<unsigned int>(received.size()),
+                   static_cast<unsigned int>(sent.size()));
+        if (mode == murasaki::krmBlock)
+            Check(received == sent, "block mode keeps all data.", detail);
+        else if (mode == murasaki::krmSkip)
+            Check(IsCompleteLines(received, &num_of_lines) && 0 < num_of_lines, "skip mode keeps whole lines.", detail);
+        else
+            Check(0 < received.size() && received.size() <= sent.size(), "trim mode stores as possible.", detail);
+    }
+
+    // The message longer than the ring is trimmed, not dropped.
+    {
+        std::string sent(PLATFORM_CONFIG_RTT_UP_BUFFER_SIZE + 44, 'x');
+        std::string received;
+
+        SetModeByHost(murasaki::krmSkip);
+        logger.putMessage(&sent[0], sent.size());
+        writer_done = true;
+        received = Drain(false);
+        ::snprintf(detail, sizeof(detail), "(%u of %u bytes)",
+                   static_cast<unsigned int>(received.size()),
+                   static_cast<unsigned int>(sent.size()));
+        Check(received.size() == PLATFORM_CONFIG_RTT_UP_BUFFER_SIZE - 1 && 0 == sent.compare(0, received.size(), received),
+              "skip mode trims the message longer than the ring.", detail);
+    }
+
+    // SetMode() keeps the other bits of the host.
+    logger.SetMode(murasaki::krmBlock);
+    {
+        std::lock_guard<std::mutex> lock(memory_lock);
+        Check(memory_cb.up[0].flags == (0x100 | murasaki::krmBlock), "SetMode() reaches the memory.", "");
+    }
+
+    // Key input from the host.
+    std::thread host([] {
+        std::lock_guard<std::mutex> lock(memory_lock);
+        RttBuffer &down = memory_cb.down[0];
+        ToMemory(down.buffer, down.size)[down.write_offset] = 'k';
+        down.write_offset = (down.write_offset + 1) % down.size;
+    });
+    char key = logger.getCharacter();
+    host.join();
+    {
+        std::lock_guard<std::mutex> lock(memory_lock);
+        Check(key == 'k' && memory_cb.down[0].read_offset == 1, "getCharacter() reads the key from the host.", "");
+    }
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,18 @@
+/*
+ * FreeRTOS.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ *
+ * Minimum FreeRTOS stub for the host tests.
+ */
+
+#ifndef FREERTOS_H_STUB_
+#define FREERTOS_H_STUB_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+
+#endif /* FREERTOS_H_STUB_ */
@@ -0,0 +1,18 @@
+/*
+ * task.h
+ *
+ *  Created on: 2026/10/18
+ *      Author: Seiichi "Suikan" Horie
+ *
+ * Minimum FreeRTOS stub for the host tests.
+ */
+
+#ifndef TASK_H_STUB_
+#define TASK_H_STUB_
+
+#include "FreeRTOS.h"
+
+// Defined by each test.
+void vTaskDelay(TickType_t ticks);
+
+#endif /* TASK_H_STUB_ */
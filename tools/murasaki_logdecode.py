@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""Decoder of the murasaki deferred binary log.
+
+Read the byte stream from the debug UART, and rebuild the text of the
+MURASAKI_DEFERRED_LOG frames by the format strings in the ELF file.
+The text by Debugger::Printf() is passed through. The murasaki::Telemetry
+frames are skipped. Use murasaki_telemetry.py to read them. The
+murasaki::AudioCapture frames are skipped too.
+
+Frame format ( little endian ) :
+    0x00           start of frame. The text never contains 0x00.
+    N              number of the payload words. 1 byte.
+    format ID      address of the format string in ".murasaki_fmt".
+    timestamp      cycle counter.
+    arguments      N - 2 words.
+
+Usage :
+    python3 murasaki_logdecode.py app.elf [capture.bin]
+    If the capture file is omitted, read from the standard input.
+"""
+
+import re
+import struct
+import sys
+
+FORMAT_SECTION = ".murasaki_fmt"
+# ID of the murasaki::Telemetry frames. "MLTD" and "MLTS".
+TELEMETRY_IDS = (0x44544C4D, 0x53544C4D)
+# ID of the murasaki::AudioCapture frames. "MLCH" and "MLCB".
+CAPTURE_IDS = (0x48434C4D, 0x42434C4D)
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# printf conversion specification.
+SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXeEfFgGcsp%])")
+
+
+class Elf:
+    """Minimal ELF reader. Only the section table is used."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.image = f.read()
+        if self.image[:4] != b"\x7fELF":
+            raise ValueError("Not an ELF file : " + path)
+        is64 = self.image[4] == 2
+        if self.image[5] != 1:
+            raise ValueError("Big endian ELF is not supported")
+
+        if is64:
+            shoff, = struct.unpack_from("<Q", self.image, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.image, 0x3A)
+            entry = "<IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from("<I", self.image, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.image, 0x2E)
+            entry = "<IIIIIIIIII"
+
+        headers = [struct.unpack_from(entry, self.image, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx]
+        # (name, flags, address, offset, size) of each section.
+        self.sections = []
+        for h in headers:
+            name_offset, sh_type, flags, addr, offset, size = h[0], h[1], h[2], h[3], h[4], h[5]
+            end = self.image.index(b"\0", names[4] + name_offset)
+            name = self.image[names[4] + name_offset:end].decode("ascii", "replace")
+            if sh_type != SHT_NOBITS:
+                self.sections.append((name, flags, addr, offset, size))
+
+    def format_range(self):
+        """Address range of the format section."""
+        for name, flags, addr, offset, size in self.sections:
+            if name == FORMAT_SECTION:
+                return addr, addr + size
+        raise ValueError("Section " + FORMAT_SECTION + " is not found")
+
+    def string(self, address):
+        """Constant string at the address. None if it is not in the ELF."""
+        for name, flags, addr, offset, size in self.sections:
+            if flags & SHF_ALLOC and addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.image.find(b"\0", start, offset + size)
+                if end < 0:
+                    return None
+                return self.image[start:end].decode("utf-8", "replace")
+        return None
+
+
+def format_message(elf, fmt, words):
+    """Apply the printf style format to the argument words."""
+    words = list(words)
+
+    def take():
+        return words.pop(0) if words else 0
+
+    def take64():
+        low = take()
+        return low | (take() << 32)
+
+    def signed(value, bits):
+        return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+    def replace(m):
+        flags, width, precision, length, conv = m.groups()
+        if conv == "%":
+            return "%"
+        if width == "*":
+            width = str(signed(take(), 32))
+        if precision == "*":
+            precision = str(signed(take(), 32))
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+        wide = length in ("ll", "j")
+
+        if conv in "di":
+            return (spec + "d") % (signed(take64(), 64) if wide else signed(take(), 32))
+        if conv in "ouxX":
+            return (spec + conv.replace("u", "d")) % (take64() if wide else take())
+        if conv in "eEfFgG":
+            value, = struct.unpack("<d", struct.pack("<Q", take64()))
+            return (spec + conv) % value
+        if conv == "c":
+            return (spec + "c") % chr(take() & 0xFF)
+        if conv == "p":
+            return (spec + "s") % ("0x%x" % take())
+        # conv == "s"
+        address = take()
+        text = elf.string(address)
+        if text is None:
+            text = "<str@0x%08x>" % address
+        return (spec + "s") % text
+
+    return SPEC.sub(replace, fmt)
+
+
+def decode(elf, data, out):
+    """Decode the byte stream. Write the text to out."""
+    low, high = elf.format_range()
+    text = bytearray()
+    i = 0
+    while i < len(data):
+        if data[i] != 0:
+            text.append(data[i])
+            i += 1
+            continue
+
+        # Start of frame. Check the length and ID to re-synchronize from the broken frame.
+        if i + 2 > len(data):
+            break
+        count = data[i + 1]
+        size = 2 + count * 4
+        if count < 2 or i + size > len(data):
+            i += 1
+            continue
+        payload = struct.unpack_from("<%dI" % count, data, i + 2)
+        if payload[0] in TELEMETRY_IDS or payload[0] in CAPTURE_IDS:
+            i += size
+            continue
+        if not low <= payload[0] < high:
+            i += 1
+            continue
+
+        out.write(text.decode("utf-8", "replace"))
+        text = bytearray()
+        fmt = elf.string(payload[0])
+        out.write("%10u, " % payload[1] + format_message(elf, fmt, payload[2:]))
+        i += size
+
+    out.write(text.decode("utf-8", "replace"))
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write(__doc__)
+        return 1
+    elf = Elf(argv[1])
+    if len(argv) > 2:
+        with open(argv[2], "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+    decode(elf, data, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Decoder of the murasaki::Telemetry frames.
+
+Read the byte stream from the debug UART, and pick up the telemetry frames
+among the text and the deferred log frames. The samples are written as CSV.
+
+Frame format ( little endian ) :
+    0x00           start of frame. The text never contains 0x00.
+    N              number of the payload words. 1 byte.
+    ID             "MLTD" for the descriptor, "MLTS" for the data.
+    timestamp      lower 32bit of murasaki::GetTimebaseTicks().
+
+Descriptor payload :
+    index | type << 8 | number of variables << 16
+    sampling interval [uS]
+    timebase frequency [Hz]
+    name           null terminated, padded to the word.
+
+Data payload :
+    mask           bit mask of the sampled variables.
+    values         packed by the size of their type, in the order of index.
+
+Output CSV columns :
+    time [S], name, value
+
+Usage :
+    python3 murasaki_telemetry.py [capture.bin] > telemetry.csv
+    python3 murasaki_telemetry.py --text capture.bin > telemetry.csv
+    If the capture file is omitted, read from the standard input.
+    With --text, the console text is written to the standard error.
+"""
+
+import struct
+import sys
+
+ID_DESCRIPTOR = 0x44544C4D
+ID_DATA = 0x53544C4D
+
+# ( struct format, size ) of murasaki::TelemetryType.
+TYPES = [("<b", 1), ("<B", 1), ("<h", 2), ("<H", 2), ("<i", 4), ("<I", 4), ("<f", 4)]
+
+
+class Decoder:
+    """Keep the descriptors and convert the data frames to samples."""
+
+    def __init__(self):
+        self.channels = {}      # index -> ( name, type )
+        self.frequency = None
+        self.last = None        # last 32bit timestamp
+        self.upper = 0          # wrap around count of the timestamp
+
+    def time(self, stamp):
+        """Extend the 32bit timestamp and convert to second."""
+        if self.last is not None and stamp < self.last:
+            self.upper += 1
+        self.last = stamp
+        return ((self.upper << 32) | stamp) / self.frequency
+
+    def descriptor(self, payload):
+        index = payload[0] & 0xFF
+        kind = (payload[0] >> 8) & 0xFF
+        self.frequency = payload[2]
+        name = struct.pack("<%dI" % (len(payload) - 3), *payload[3:]).split(b"\0")[0]
+        self.channels[index] = (name.decode("utf-8", "replace"), kind)
+
+    def data(self, stamp, payload):
+        """Return the list of ( time, name, value ). Empty until the descriptors come."""
+        mask = payload[0]
+        values = struct.pack("<%dI" % (len(payload) - 1), *payload[1:])
+        # All sampled variables must be known to unpack.
+        indexes = [i for i in range(32) if mask & (1 << i)]
+        if self.frequency is None or any(i not in self.channels for i in indexes):
+            return []
+        t = self.time(stamp)
+        samples = []
+        offset = 0
+        for i in indexes:
+            name, kind = self.channels[i]
+            fmt, size = TYPES[kind]
+            value, = struct.unpack_from(fmt, values, offset)
+            offset += size
+            samples.append((t, name, value))
+        return samples
+
+
+def frames(data, text_out=None):
+    """Yield ( ID, timestamp, payload ) of the telemetry frames. Other bytes go to the text_out."""
+    i = 0
+    text = bytearray()
+    while i < len(data):
+        if data[i] != 0:
+            text.append(data[i])
+            i += 1
+            continue
+        if i + 2 > len(data):
+            break
+        count = data[i + 1]
+        size = 2 + count * 4
+        if count < 2 or i + size > len(data):
+            i += 1
+            continue
+        payload = struct.unpack_from("<%dI" % count, data, i + 2)
+        i += size
+        if payload[0] in (ID_DESCRIPTOR, ID_DATA):
+            yield payload[0], payload[1], payload[2:]
+        # The deferred log frames are skipped. Use murasaki_logdecode.py to read them.
+    if text_out is not None:
+        text_out.write(text.decode("utf-8", "replace"))
+
+
+def decode(data, out, text_out=None):
+    decoder = Decoder()
+    out.write("time, name, value\n")
+    for kind, stamp, payload in frames(data, text_out):
+        if kind == ID_DESCRIPTOR:
+            decoder.descriptor(payload)
+        else:
+            for t, name, value in decoder.data(stamp, payload):
+                out.write("%.6f, %s, %s\n" % (t, name, repr(value) if isinstance(value, float) else value))
+
+
+def main(argv):
+    args = argv[1:]
+    if args and args[0] in ("-h", "--help"):
+        sys.stderr.write(__doc__)
+        return 1
+    text_out = None
+    if args and args[0] == "--text":
+        text_out = sys.stderr
+        args = args[1:]
+    if args:
+        with open(args[0], "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+    decode(data, sys.stdout, text_out)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
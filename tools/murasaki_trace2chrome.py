@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Converter of the murasaki trace recorder output to the Chrome trace JSON.
+
+Read the text decoded by murasaki_logdecode.py, and pick up the "[trace]" lines
+output by murasaki::TraceDump(). The result can be opened by chrome://tracing
+or the Perfetto UI ( https://ui.perfetto.dev ).
+
+Timeline :
+    ISR              entry and exit of the HAL callbacks.
+    one per task     running duration of the task. The argument is the priority.
+    priority         counter of the priority of each task. The priority
+                     inheritance shows up as a step.
+    wait             async slices from Synchronizer::Wait() to its return.
+    release          instant events by Synchronizer::Release().
+
+Usage :
+    python3 murasaki_logdecode.py app.elf capture.bin | python3 murasaki_trace2chrome.py > trace.json
+    python3 murasaki_trace2chrome.py decoded.txt > trace.json
+"""
+
+import json
+import re
+import sys
+
+TRACE = re.compile(r"\[trace\] (.*)$")
+
+PID = 1
+ISR_TID = 0
+
+
+def parse(lines):
+    """Return the frequency, task names and records ( time, kind, object, argument )."""
+    frequency = None
+    names = {}
+    records = []
+    for line in lines:
+        m = TRACE.search(line.rstrip("\r\n"))
+        if not m:
+            continue
+        fields = [f.strip() for f in m.group(1).split(",")]
+        if fields[0] == "start":
+            # The new dump starts. Forget the previous one.
+            frequency = int(fields[1])
+            names = {}
+            records = []
+        elif fields[0] == "task":
+            names[int(fields[1], 16)] = fields[2]
+        elif fields[0] == "end":
+            continue
+        elif len(fields) == 5 and frequency:
+            ticks = (int(fields[0]) << 32) | int(fields[1])
+            records.append((ticks * 1e6 / frequency, fields[2], int(fields[3], 16), fields[4]))
+    if frequency is None:
+        raise ValueError("No \"[trace] start\" line is found")
+    # Nested ISR may store the records slightly out of order.
+    records.sort(key=lambda r: r[0])
+    return names, records
+
+
+def convert(names, records):
+    """Build the list of the Chrome trace events."""
+    events = []
+    tids = {}
+
+    def tid(task):
+        if task not in tids:
+            tids[task] = len(tids) + 1
+            name = names.get(task, "task 0x%08x" % task)
+            events.append({"ph": "M", "name": "thread_name", "pid": PID, "tid": tids[task], "args": {"name": name}})
+            events.append({"ph": "M", "name": "thread_sort_index", "pid": PID, "tid": tids[task], "args": {"sort_index": tids[task]}})
+        return tids[task]
+
+    def task_name(task):
+        return names.get(task, "task 0x%08x" % task)
+
+    events.append({"ph": "M", "name": "process_name", "pid": PID, "args": {"name": "murasaki"}})
+    events.append({"ph": "M", "name": "thread_name", "pid": PID, "tid": ISR_TID, "args": {"name": "ISR"}})
+
+    running = None      # ( task, start time, priority )
+    isr = []            # stack of ( name, handle, start time )
+    for time, kind, obj, arg in records:
+        if kind == "switch-in":
+            running = (obj, time, int(arg))
+            events.append({"ph": "C", "name": "priority " + task_name(obj), "pid": PID, "ts": time,
+                           "args": {"priority": int(arg)}})
+        elif kind == "switch-out":
+            if running and running[0] == obj:
+                events.append({"ph": "X", "name": task_name(obj), "cat": "task", "pid": PID, "tid": tid(obj),
+                               "ts": running[1], "dur": time - running[1], "args": {"priority": running[2]}})
+            running = None
+        elif kind == "priority":
+            events.append({"ph": "C", "name": "priority " + task_name(obj), "pid": PID, "ts": time,
+                           "args": {"priority": int(arg)}})
+            events.append({"ph": "i", "s": "t", "name": "priority -> " + arg, "cat": "priority", "pid": PID,
+                           "tid": tid(obj), "ts": time})
+        elif kind == "isr-enter":
+            isr.append((arg, obj, time))
+        elif kind == "isr-exit":
+            # Search the matching entry. The entry may be lost at the beginning of the ring.
+            for i in range(len(isr) - 1, -1, -1):
+                if isr[i][0] == arg and isr[i][1] == obj:
+                    name, handle, start = isr.pop(i)
+                    events.append({"ph": "X", "name": name, "cat": "isr", "pid": PID, "tid": ISR_TID,
+                                   "ts": start, "dur": time - start, "args": {"handle": "0x%08x" % handle}})
+                    break
+        elif kind in ("wait-begin", "wait-end"):
+            task = running[0] if running else 0
+            event = {"ph": "b" if kind == "wait-begin" else "e", "name": "wait 0x%08x" % obj, "cat": "wait",
+                     "id": "0x%08x-0x%08x" % (obj, task), "pid": PID, "tid": tid(task), "ts": time}
+            if kind == "wait-begin":
+                event["args"] = {"timeout_ms": int(arg)}
+            else:
+                event["args"] = {"released": int(arg) != 0}
+            events.append(event)
+        elif kind == "release":
+            if isr:
+                where = ISR_TID
+            else:
+                where = tid(running[0]) if running else ISR_TID
+            events.append({"ph": "i", "s": "t", "name": "release 0x%08x" % obj, "cat": "release", "pid": PID,
+                           "tid": where, "ts": time})
+    return events
+
+
+def main(argv):
+    if len(argv) > 1 and argv[1] in ("-h", "--help"):
+        sys.stderr.write(__doc__)
+        return 1
+    if len(argv) > 1:
+        with open(argv[1], "r", errors="replace") as f:
+            lines = f.readlines()
+    else:
+        lines = sys.stdin.readlines()
+    names, records = parse(lines)
+    json.dump({"traceEvents": convert(names, records), "displayTimeUnit": "ns"}, sys.stdout, indent=1)
+    sys.stdout.write("\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))